@@ -47,6 +47,7 @@
 #include <array>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 #include "genit/iterator_facade.h"
 #include "genit/iterator_range.h"
@@ -82,6 +83,9 @@ struct ValueArrayProxyTraits<UnderlyingIter, N, /*ContainsLValue == */ true> {
   static Storage ReferenceToStorage(Reference element) { return &element; }
 };
 
+// Tag to construct a ValueArrayProxy whose elements are in reverse order.
+struct ReversedTag {};
+
 template <typename UnderlyingIter, int N>
 class ValueArrayProxy {
  public:
@@ -95,6 +99,13 @@ class ValueArrayProxy {
   ValueArrayProxy(int offset, const std::array<UnderlyingIter, N>& iterators)
       : ValueArrayProxy{offset, iterators, IndexConstant<N - 1>()} {}
 
+  // Constructs a proxy whose i-th element is the (N - 1 - i)-th element of
+  // the proxy constructed from the same iterators.
+  ValueArrayProxy(ReversedTag, int offset,
+                  const std::array<UnderlyingIter, N>& iterators)
+      : ValueArrayProxy{ReversedTag(), offset, iterators,
+                        std::make_integer_sequence<int, N>()} {}
+
   Reference operator[](int i) const {
     return Traits::StorageToReference(data_[(i + offset_) % N]);
   }
@@ -134,6 +145,15 @@ class ValueArrayProxy {
       : ValueArrayProxy{offset, iterators, IndexConstant<I - 1>(), id, idx...} {
   }
 
+  // Stores the elements in reverse order. The i-th element is then
+  // data_[(i + N - offset) % N] = *iterators[(N - 1 - i + offset) % N].
+  template <int... Is>
+  ValueArrayProxy(ReversedTag, int offset,
+                  const std::array<UnderlyingIter, N>& iterators,
+                  std::integer_sequence<int, Is...>)
+      : data_{Traits::ReferenceToStorage(*iterators[N - 1 - Is])...},
+        offset_((N - offset) % N) {}
+
   std::array<Storage, N> data_;
   int offset_;
 };
@@ -143,6 +163,8 @@ class ValueArrayProxy {
 // Forward-declaration.
 template <typename UnderlyingIter, int N>
 class AdjacentCircularIterator;
+template <typename UnderlyingIter, int N>
+class ReverseAdjacentIterator;
 
 // This class template can be used to transform an iterator into a set of N
 // consecutive iterators packaged as one which enables the traversal of a
@@ -242,10 +264,13 @@ class AdjacentIterator
 
   friend class IteratorFacadePrivateAccess<AdjacentIterator>;
   friend class AdjacentCircularIterator<UnderlyingIter, N>;
+  template <typename OtherIter, int M>
+  friend class ReverseAdjacentIterator;
 
   using ProxyType =
       adjacent_iterator_internal::ValueArrayProxy<UnderlyingIter, N>;
 
+  const UnderlyingIter& FrontIterator() const { return iterators_[offset_]; }
   const UnderlyingIter& BackIterator() const {
     return iterators_[(offset_ + N - 1) % N];
   }
@@ -277,11 +302,63 @@ class AdjacentIterator
     }
   }
 
+  // Moves a window over the reversed underlying iterators, see
+  // MakeReverseIterator.
+  friend ReverseAdjacentIterator<UnderlyingIter, N> MakeNativeReverseIterator(
+      const AdjacentIterator& it, const AdjacentIterator& first) {
+    using RevIter = std::reverse_iterator<UnderlyingIter>;
+    return ReverseAdjacentIterator<UnderlyingIter, N>(
+        AdjacentIterator<RevIter, N>(RevIter(it.BackIterator()),
+                                     RevIter(first.FrontIterator())));
+  }
+
   // Stores the set of adjacent iterators.
   std::array<UnderlyingIter, N> iterators_;
   int offset_;
 };
 
+// Iterates backwards over the windows of N consecutive elements of a range.
+// The windows are the same as for AdjacentIterator, in reverse order.
+//
+// Unlike std::reverse_iterator<AdjacentIterator>, which copies and shifts the
+// whole window of iterators on each dereference, this moves a window over
+// std::reverse_iterator<UnderlyingIter> and reverses the order of the
+// elements of each window.
+template <typename UnderlyingIter, int N>
+class ReverseAdjacentIterator
+    : public IteratorFacade<
+          ReverseAdjacentIterator<UnderlyingIter, N>,
+          adjacent_iterator_internal::ValueArrayProxy<
+              std::reverse_iterator<UnderlyingIter>, N>,
+          typename std::iterator_traits<UnderlyingIter>::iterator_category> {
+ public:
+  using BaseIter = AdjacentIterator<std::reverse_iterator<UnderlyingIter>, N>;
+
+  explicit ReverseAdjacentIterator(BaseIter it) : it_(std::move(it)) {}
+
+ private:
+  friend class IteratorFacadePrivateAccess<ReverseAdjacentIterator>;
+
+  using ProxyType = adjacent_iterator_internal::ValueArrayProxy<
+      std::reverse_iterator<UnderlyingIter>, N>;
+
+  ProxyType Dereference() const {
+    return ProxyType(adjacent_iterator_internal::ReversedTag(), it_.offset_,
+                     it_.iterators_);
+  }
+  void Increment() { ++it_; }
+  void Decrement() { --it_; }
+  bool IsEqual(const ReverseAdjacentIterator& rhs) const {
+    return it_ == rhs.it_;
+  }
+  int DistanceTo(const ReverseAdjacentIterator& rhs) const {
+    return rhs.it_ - it_;
+  }
+  void Advance(int n) { it_ += n; }
+
+  BaseIter it_;
+};
+
 // AdjacentElementsRangeT wraps a range and transforms the iterators into
 // adjacent iterators of N-arity.
 template <typename BaseRange, int N>
@@ -293,6 +370,10 @@ class AdjacentElementsRangeT
   static_assert(N > 0,
                 "Number of adjacent elements must be greater than zero!");
   using AdjIter = AdjacentIterator<RangeIteratorType<BaseRange>, N>;
+  static constexpr std::size_t kExtent =
+      kStaticExtent<BaseRange> == kDynamicExtent ? kDynamicExtent
+      : kStaticExtent<BaseRange> >= N ? kStaticExtent<BaseRange> - N + 1
+                                      : 0;
   using AliasRangeFacade<AdjacentElementsRangeT<BaseRange, N>, BaseRange,
                          AdjIter>::AliasRangeFacade;
 
@@ -190,6 +190,29 @@ TEST(AdjacentIteratorTest, FibonacciOutputIterator) {
   EXPECT_EQ(arr[6], 8);
 }
 
+TEST(AdjacentIteratorTest, ReverseRange) {
+  const std::vector<int> values = {0, 1, 2, 3, 4};
+  std::vector<std::vector<int>> windows;
+  for (const auto triplet : ReverseRange(AdjacentElementsRange<3>(values))) {
+    windows.push_back({triplet[0], triplet[1], triplet[2]});
+    EXPECT_EQ(triplet.front(), triplet[0]);
+    EXPECT_EQ(triplet.back(), triplet[2]);
+  }
+  EXPECT_EQ(windows, (std::vector<std::vector<int>>{
+                         {2, 3, 4}, {1, 2, 3}, {0, 1, 2}}));
+
+  const auto reversed = ReverseRange(AdjacentElementsRange<2>(values));
+  EXPECT_EQ(reversed.end() - reversed.begin(), 4);
+  EXPECT_EQ(reversed.begin()[2][0], 1);
+  EXPECT_EQ(reversed.begin()[2][1], 2);
+  auto last = reversed.end();
+  --last;
+  EXPECT_EQ((*last)[0], 0);
+
+  EXPECT_TRUE(ReverseRange(AdjacentElementsRange<3>(IndexRange(0, 2))).empty());
+  EXPECT_TRUE(ReverseRange(AdjacentElementsRange<3>(IndexRange(0, 0))).empty());
+}
+
 // This is mostly to test that adjacent iterators can be created (and compile
 // successfully) for iterators that return values of non-assignable types.
 TEST(AdjacentIteratorTest, TripleIteratorNonAssignableType) {
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides ForEach and Reduce algorithms over ranges, which
+// are fully unrolled when the number of elements of the range is known at
+// compile time and small (see kStaticExtent in iterator_range.h):
+//
+//   std::array<double, 7> velocities = ...;
+//   std::array<double, 7> torques = ...;
+//   const double power = Reduce(
+//       TransformRange(ZipRange(velocities, torques),
+//                      [](const auto& vt) {
+//                        return std::get<0>(vt) * std::get<1>(vt);
+//                      }),
+//       0.0);
+//
+// The adapters (ZipRange, TransformRange, AdjacentElementsRange, ...) keep
+// the extent of std::array, C arrays and std::span<T, N>, so the loop above
+// is emitted as 7 multiply-adds without any end-of-range comparison. Ranges
+// of unknown or large extents use a regular loop.
+
+#ifndef GENIT_ALGORITHMS_H_
+#define GENIT_ALGORITHMS_H_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+// Largest static extent for which ForEach and Reduce are unrolled.
+inline constexpr std::size_t kMaxUnrolledExtent = 16;
+
+namespace algorithms_detail {
+
+template <typename Range>
+inline constexpr bool kIsUnrolled =
+    kStaticExtent<Range> != kDynamicExtent &&
+    kStaticExtent<Range> <= kMaxUnrolledExtent;
+
+template <typename Iter, typename Fn, std::size_t... Is>
+void UnrolledForEach(Iter it, Fn& fn, std::index_sequence<Is...>) {
+  // The comma operator sequences the calls in order.
+  ((static_cast<void>(Is), fn(*it), ++it), ...);
+  // Unused for an empty range.
+  static_cast<void>(it);
+}
+
+template <typename Iter, typename T, typename BinaryOp, std::size_t... Is>
+T UnrolledReduce(Iter it, T init, BinaryOp& op, std::index_sequence<Is...>) {
+  ((static_cast<void>(Is), init = op(std::move(init), *it), ++it), ...);
+  // Unused for an empty range.
+  static_cast<void>(it);
+  return init;
+}
+
+}  // namespace algorithms_detail
+
+// Calls fn on each element of the range, in order, and returns fn (like
+// std::for_each).
+template <typename Range, typename Fn>
+Fn ForEach(Range&& range, Fn fn) {
+  using std::begin;
+  if constexpr (algorithms_detail::kIsUnrolled<Range>) {
+    algorithms_detail::UnrolledForEach(
+        begin(range), fn, std::make_index_sequence<kStaticExtent<Range>>());
+  } else {
+    using std::end;
+    for (auto it = begin(range), last = end(range); it != last; ++it) {
+      fn(*it);
+    }
+  }
+  return fn;
+}
+
+// Returns op(...op(op(init, x0), x1)..., xn-1) for the elements x0, ..., xn-1
+// of the range (like std::accumulate). The elements are combined in order, so
+// that, e.g., floating-point sums are the same with or without unrolling.
+template <typename Range, typename T, typename BinaryOp = std::plus<>>
+T Reduce(Range&& range, T init, BinaryOp op = {}) {
+  using std::begin;
+  if constexpr (algorithms_detail::kIsUnrolled<Range>) {
+    return algorithms_detail::UnrolledReduce(
+        begin(range), std::move(init), op,
+        std::make_index_sequence<kStaticExtent<Range>>());
+  } else {
+    using std::end;
+    for (auto it = begin(range), last = end(range); it != last; ++it) {
+      init = op(std::move(init), *it);
+    }
+    return init;
+  }
+}
+
+}  // namespace genit
+
+#endif  // GENIT_ALGORITHMS_H_
@@ -0,0 +1,171 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares kinematics-style kernels over small fixed-size arrays (7 joints,
+// 3-vectors), written with ForEach / Reduce over genit adapters, when the
+// extent of the arrays is known at compile time (unrolled) and when it is
+// hidden behind a MakeIteratorRange(begin, end) (regular loops). Each
+// iteration processes a batch of 1024 robot states.
+
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/adjacent_iterator.h"
+#include "genit/algorithms.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+namespace {
+
+constexpr int kBatchSize = 1024;
+constexpr int kNumJoints = 7;
+
+using Joints = std::array<double, kNumJoints>;
+using Vec3 = std::array<double, 3>;
+// Positions of the base, of each joint, and of the end effector.
+using Chain = std::array<Vec3, kNumJoints + 1>;
+
+// Returns the array itself, or a range over its elements with a dynamic
+// extent.
+template <bool kStatic, typename Array>
+auto View(Array& a) {
+  if constexpr (kStatic) {
+    return MoveOrAliasRange(a);
+  } else {
+    return MakeIteratorRange(a.begin(), a.end());
+  }
+}
+
+std::vector<Joints> MakeJoints(double scale) {
+  std::vector<Joints> joints(kBatchSize);
+  for (int i = 0; i < kBatchSize; ++i) {
+    for (int j = 0; j < kNumJoints; ++j) {
+      joints[i][j] = scale * std::sin(i * 0.1 + j);
+    }
+  }
+  return joints;
+}
+
+// Mechanical power: the dot product of joint velocities and torques.
+template <bool kStatic>
+void BM_JointPower(benchmark::State& state) {
+  const auto velocities = MakeJoints(1.0);
+  const auto torques = MakeJoints(20.0);
+  for (auto _ : state) {
+    double total = 0;
+    for (int i = 0; i < kBatchSize; ++i) {
+      total += Reduce(TransformRange(ZipRange(View<kStatic>(velocities[i]),
+                                              View<kStatic>(torques[i])),
+                                     [](const auto& vt) {
+                                       return std::get<0>(vt) *
+                                              std::get<1>(vt);
+                                     }),
+                      0.0);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+// Clamps joint positions to their limits.
+template <bool kStatic>
+void BM_ClampJoints(benchmark::State& state) {
+  auto positions = MakeJoints(2.0);
+  Joints lower;
+  Joints upper;
+  lower.fill(-1.5);
+  upper.fill(1.5);
+  for (auto _ : state) {
+    for (int i = 0; i < kBatchSize; ++i) {
+      ForEach(ZipRange(View<kStatic>(positions[i]), View<kStatic>(lower),
+                       View<kStatic>(upper)),
+              [](auto qlh) {
+                auto& [q, l, h] = qlh;
+                q = q < l ? l : (q > h ? h : q);
+              });
+    }
+    benchmark::DoNotOptimize(positions.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+// Total length of a kinematic chain: the sum of the distances between
+// adjacent joint positions.
+template <bool kStatic>
+void BM_ChainLength(benchmark::State& state) {
+  std::vector<Chain> chains(kBatchSize);
+  for (int i = 0; i < kBatchSize; ++i) {
+    for (int j = 0; j <= kNumJoints; ++j) {
+      chains[i][j] = {std::cos(i + j), std::sin(i + j), 0.1 * j};
+    }
+  }
+  for (auto _ : state) {
+    double total = 0;
+    for (int i = 0; i < kBatchSize; ++i) {
+      total += Reduce(
+          TransformRange(
+              AdjacentElementsRange<2>(View<kStatic>(chains[i])),
+              [](const auto& segment) {
+                const double squared_length = Reduce(
+                    TransformRange(ZipRange(View<kStatic>(segment[0]),
+                                            View<kStatic>(segment[1])),
+                                   [](const auto& ab) {
+                                     const double d =
+                                         std::get<1>(ab) - std::get<0>(ab);
+                                     return d * d;
+                                   }),
+                    0.0);
+                return std::sqrt(squared_length);
+              }),
+          0.0);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+// Hand-written fixed-size loops, for reference.
+void BM_JointPowerIndexLoop(benchmark::State& state) {
+  const auto velocities = MakeJoints(1.0);
+  const auto torques = MakeJoints(20.0);
+  for (auto _ : state) {
+    double total = 0;
+    for (int i = 0; i < kBatchSize; ++i) {
+      double power = 0;
+      for (int j = 0; j < kNumJoints; ++j) {
+        power += velocities[i][j] * torques[i][j];
+      }
+      total += power;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+BENCHMARK_TEMPLATE(BM_JointPower, true);
+BENCHMARK_TEMPLATE(BM_JointPower, false);
+BENCHMARK(BM_JointPowerIndexLoop);
+BENCHMARK_TEMPLATE(BM_ClampJoints, true);
+BENCHMARK_TEMPLATE(BM_ClampJoints, false);
+BENCHMARK_TEMPLATE(BM_ChainLength, true);
+BENCHMARK_TEMPLATE(BM_ChainLength, false);
+
+}  // namespace
+}  // namespace genit
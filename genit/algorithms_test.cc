@@ -0,0 +1,166 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/algorithms.h"
+
+#include <array>
+#include <functional>
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "genit/adjacent_iterator.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+#include "genit/zip_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+double Square(double x) { return x * x; }
+
+TEST(StaticExtentTest, Containers) {
+  static_assert(kStaticExtent<std::array<double, 7>> == 7);
+  static_assert(kStaticExtent<const std::array<double, 7>&> == 7);
+  static_assert(kStaticExtent<int[3]> == 3);
+  static_assert(kStaticExtent<const int (&)[3]> == 3);
+  static_assert(kStaticExtent<std::vector<double>> == kDynamicExtent);
+  static_assert(kStaticExtent<IteratorRange<double*>> == kDynamicExtent);
+  static_assert(kStaticExtent<StaticExtentRange<double*, 4>> == 4);
+}
+
+TEST(StaticExtentTest, PropagatesThroughAdapters) {
+  std::array<double, 7> q = {};
+  const std::array<double, 6> w = {};
+  double c_array[3] = {};
+  std::vector<double> v(7);
+
+  static_assert(kStaticExtent<decltype(TransformRange(q, Square))> == 7);
+  static_assert(kStaticExtent<decltype(TransformRange(c_array, Square))> ==
+                3);
+  static_assert(kStaticExtent<decltype(ZipRange(q, w))> == 6);
+  static_assert(kStaticExtent<decltype(ZipRange(q, v))> == kDynamicExtent);
+  static_assert(kStaticExtent<decltype(AdjacentElementsRange<2>(q))> == 6);
+  static_assert(kStaticExtent<decltype(AdjacentElementsRange<8>(q))> == 0);
+  static_assert(kStaticExtent<decltype(ReverseRange(w))> == 6);
+  static_assert(kStaticExtent<decltype(TransformRange(v, Square))> ==
+                kDynamicExtent);
+  // Temporaries are moved into the adapters, and keep their extent as well.
+  static_assert(kStaticExtent<decltype(TransformRange(
+                    std::array<double, 3>{}, Square))> == 3);
+}
+
+TEST(StaticExtentTest, AliasedArrayIsARange) {
+  std::array<int, 3> a = {1, 2, 3};
+  auto alias = MoveOrAliasRange(a);
+  static_assert(kStaticExtent<decltype(alias)> == 3);
+  EXPECT_EQ(alias.size(), 3);
+  *alias.begin() = 4;
+  EXPECT_THAT(a, ElementsAre(4, 2, 3));
+}
+
+TEST(ForEachTest, StaticExtent) {
+  std::array<double, 4> a = {1, 2, 3, 4};
+  std::vector<double> visited;
+  ForEach(a, [&](double x) { visited.push_back(x); });
+  EXPECT_THAT(visited, ElementsAre(1, 2, 3, 4));
+
+  ForEach(a, [](double& x) { x *= 2; });
+  EXPECT_THAT(a, ElementsAre(2, 4, 6, 8));
+}
+
+TEST(ForEachTest, ZippedArrays) {
+  std::array<double, 3> q = {-1.0, 0.5, 2.0};
+  const std::array<double, 3> lo = {-0.5, -0.5, -0.5};
+  const std::array<double, 3> hi = {0.5, 0.5, 0.5};
+  ForEach(ZipRange(q, lo, hi), [](auto qlh) {
+    auto& [x, l, h] = qlh;
+    x = x < l ? l : x > h ? h : x;
+  });
+  EXPECT_THAT(q, ElementsAre(-0.5, 0.5, 0.5));
+}
+
+TEST(ForEachTest, DynamicExtent) {
+  const std::list<int> l = {1, 2, 3};
+  int sum = 0;
+  ForEach(l, [&](int x) { sum += x; });
+  EXPECT_EQ(sum, 6);
+
+  const std::vector<int> empty;
+  const auto counter = ForEach(empty, [n = 0](int) mutable { ++n; });
+  (void)counter;
+  std::array<int, 0> no_elements;
+  ForEach(no_elements, [](int) { FAIL(); });
+}
+
+TEST(ForEachTest, ReturnsFunction) {
+  struct Counter {
+    void operator()(int) { ++count; }
+    int count = 0;
+  };
+  const int c_array[5] = {};
+  EXPECT_EQ(ForEach(c_array, Counter()).count, 5);
+  EXPECT_EQ(ForEach(std::vector<int>(3), Counter()).count, 3);
+}
+
+TEST(ReduceTest, StaticExtent) {
+  const std::array<int, 5> a = {1, 2, 3, 4, 5};
+  EXPECT_EQ(Reduce(a, 0), 15);
+  EXPECT_EQ(Reduce(a, 1, std::multiplies<>()), 120);
+  EXPECT_EQ(Reduce(std::array<int, 0>{}, 7), 7);
+}
+
+TEST(ReduceTest, InOrder) {
+  const std::array<std::string, 3> a = {"a", "b", "c"};
+  EXPECT_EQ(Reduce(a, std::string("x")), "xabc");
+  const std::vector<std::string> v(a.begin(), a.end());
+  EXPECT_EQ(Reduce(v, std::string("x")), "xabc");
+}
+
+TEST(ReduceTest, DotProduct) {
+  const std::array<double, 7> v = {1, 2, 3, 4, 5, 6, 7};
+  const std::array<double, 7> t = {1, 0, 1, 0, 1, 0, 1};
+  const auto products =
+      TransformRange(ZipRange(v, t), [](const auto& vt) {
+        return std::get<0>(vt) * std::get<1>(vt);
+      });
+  static_assert(kStaticExtent<decltype(products)> == 7);
+  EXPECT_EQ(Reduce(products, 0.0), 16.0);
+}
+
+TEST(ReduceTest, AdjacentElements) {
+  const std::array<double, 5> x = {0, 1, 3, 6, 10};
+  const double total = Reduce(
+      TransformRange(AdjacentElementsRange<2>(x),
+                     [](const auto& pair) { return pair[1] - pair[0]; }),
+      0.0);
+  EXPECT_EQ(total, 10.0);
+}
+
+TEST(ReduceTest, LargeStaticExtentIsNotUnrolled) {
+  std::array<int, 100> a;
+  for (int i = 0; i < 100; ++i) {
+    a[i] = i;
+  }
+  static_assert(!algorithms_detail::kIsUnrolled<decltype(a)>);
+  EXPECT_EQ(Reduce(a, 0), 4950);
+}
+
+}  // namespace
+}  // namespace genit
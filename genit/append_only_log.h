@@ -0,0 +1,210 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENIT_APPEND_ONLY_LOG_H_
+#define GENIT_APPEND_ONLY_LOG_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "genit/chunked_vector.h"
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+
+namespace append_only_log_detail {
+
+// Returns the index of the most significant set bit of n (n > 0).
+inline int MostSignificantBit(std::size_t n) {
+  assert(n != 0);
+  return std::numeric_limits<unsigned long long>::digits - 1 -  // NOLINT
+         __builtin_clzll(n);
+}
+
+}  // namespace append_only_log_detail
+
+// An AppendOnlyLog is a single-writer, multi-reader, append-only sequence
+// container. One thread appends elements (emplace_back / push_back), while
+// any number of other threads read consistent prefixes of the log through
+// Snapshot(), without locks and without ever blocking the writer.
+//
+// Elements are stored in chunks that are never relocated. Chunk k holds
+// FirstChunkSize * 2^k elements, such that a fixed-size directory of chunk
+// pointers covers the entire index space and is never reallocated either.
+// The writer constructs an element and then publishes the new size with a
+// release store; readers acquire the size, and may then access all elements
+// below it.
+//
+// Example:
+//
+//   AppendOnlyLog<Sample> log;
+//   // Logger thread:
+//   log.push_back(sample);
+//   // Analytics threads:
+//   for (const Sample& s : log.Snapshot()) { ... }
+//
+// Caveats:
+//  - Only one thread may append at a time.
+//  - Published elements are immutable (readers get const references).
+//  - The log must outlive all snapshots and iterators obtained from it.
+template <typename T, std::size_t FirstChunkSize = 256>
+class AppendOnlyLog {
+  static_assert(chunked_vector_detail::IsPowerOfTwo(FirstChunkSize),
+                "FirstChunkSize must be a power of two.");
+
+ public:
+  // Random-access iterator into an AppendOnlyLog.
+  class Iterator : public IteratorFacade<Iterator, const T&,
+                                         std::random_access_iterator_tag> {
+   public:
+    Iterator() = default;
+    Iterator(const AppendOnlyLog* log, std::size_t index)
+        : log_(log), index_(index) {}
+
+   private:
+    friend class IteratorFacadePrivateAccess<Iterator>;
+
+    // Implementation of the IteratorFacade requirements:
+    const T& Dereference() const { return *log_->ElementPtr(index_); }
+    void Increment() { ++index_; }
+    void Decrement() { --index_; }
+    bool IsEqual(const Iterator& rhs) const { return index_ == rhs.index_; }
+    int DistanceTo(const Iterator& rhs) const {
+      return static_cast<int>(rhs.index_) - static_cast<int>(index_);
+    }
+    void Advance(int n) { index_ += n; }
+
+    const AppendOnlyLog* log_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_reference = const T&;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+  using SnapshotRange = IteratorRange<Iterator>;
+
+  AppendOnlyLog() = default;
+
+  // Not copyable or movable: readers refer to the log by address.
+  AppendOnlyLog(const AppendOnlyLog&) = delete;
+  AppendOnlyLog& operator=(const AppendOnlyLog&) = delete;
+
+  ~AppendOnlyLog() {
+    const std::size_t n = size_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < n; ++i) {
+      ElementPtr(i)->~T();
+    }
+  }
+
+  // Appends a new element constructed in-place from args, and publishes it
+  // to readers. Must only be called by the (single) writer thread.
+  template <typename... Args>
+  const T& emplace_back(Args&&... args) {
+    const std::size_t n = size_.load(std::memory_order_relaxed);
+    const int chunk = ChunkIndex(n);
+    if (chunks_[chunk] == nullptr) {
+      // Published to readers by the release store of the size below.
+      chunks_[chunk].reset(new Slot[ChunkCapacity(chunk)]);
+    }
+    const T* ptr = ::new (static_cast<void*>(SlotPtr(n)))
+        T(std::forward<Args>(args)...);
+    size_.store(n + 1, std::memory_order_release);
+    return *ptr;
+  }
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  // Returns the number of published elements.
+  std::size_t size() const { return size_.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+  // Accesses a published element, i.e., i < size() as seen by this thread.
+  const T& operator[](std::size_t i) const { return *ElementPtr(i); }
+
+  // Returns a random-access range over all the elements published at the time
+  // of the call. The range stays valid (and unchanged) while the writer keeps
+  // appending.
+  SnapshotRange Snapshot() const {
+    return SnapshotRange(Iterator(this, 0), Iterator(this, size()));
+  }
+
+  // Returns the elements published at the time of the call as a range of
+  // contiguous segments (one PtrRange<const T> per chunk), such that bulk
+  // algorithms can run one loop per chunk over raw pointers.
+  auto SnapshotSegments() const {
+    const std::size_t n = size();
+    const int num_segments = n == 0 ? 0 : ChunkIndex(n - 1) + 1;
+    return TransformRange(IndexRange(0, num_segments), [this, n](int chunk) {
+      const T* first = ElementPtr(ChunkStart(chunk));
+      const std::size_t end = std::min(ChunkStart(chunk + 1), n);
+      return PtrRange<const T>(first, first + (end - ChunkStart(chunk)));
+    });
+  }
+
+  // end() takes a snapshot of size() when it is called, so begin() and end()
+  // called at different times iterate over the prefix as of the call to end().
+  // Prefer Snapshot(), which takes a single snapshot for both.
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, size()); }
+
+ private:
+  static constexpr int kShift = chunked_vector_detail::Log2(FirstChunkSize);
+  static constexpr int kMaxChunks =
+      std::numeric_limits<std::size_t>::digits - kShift;
+
+  // Uninitialized storage for one element.
+  struct alignas(T) Slot {
+    unsigned char bytes[sizeof(T)];
+  };
+
+  static constexpr std::size_t ChunkCapacity(int chunk) {
+    return FirstChunkSize << chunk;
+  }
+  // Chunk k starts at index FirstChunkSize * (2^k - 1).
+  static int ChunkIndex(std::size_t i) {
+    return append_only_log_detail::MostSignificantBit((i >> kShift) + 1);
+  }
+  static std::size_t ChunkStart(int chunk) {
+    return ((std::size_t{1} << chunk) - 1) << kShift;
+  }
+
+  Slot* SlotPtr(std::size_t i) const {
+    const int chunk = ChunkIndex(i);
+    return &chunks_[chunk][i - ChunkStart(chunk)];
+  }
+  const T* ElementPtr(std::size_t i) const {
+    return std::launder(reinterpret_cast<const T*>(SlotPtr(i)));
+  }
+
+  std::array<std::unique_ptr<Slot[]>, kMaxChunks> chunks_;
+  std::atomic<std::size_t> size_{0};
+};
+
+}  // namespace genit
+
+#endif  // GENIT_APPEND_ONLY_LOG_H_
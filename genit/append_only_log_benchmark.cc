@@ -0,0 +1,120 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the scan throughput of readers while a writer keeps appending,
+// comparing AppendOnlyLog snapshots against a mutex-protected std::vector.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/append_only_log.h"
+
+namespace genit {
+namespace {
+
+constexpr int kInitialSize = 1 << 20;
+constexpr int kMaxSize = 1 << 23;
+
+// Runs a writer thread for the lifetime of this object.
+class BackgroundWriter {
+ public:
+  template <typename AppendFunc>
+  explicit BackgroundWriter(AppendFunc append)
+      : thread_([this, append]() mutable {
+          for (int64_t i = kInitialSize;
+               i < kMaxSize && !stop_.load(std::memory_order_relaxed); ++i) {
+            append(i);
+          }
+        }) {}
+  ~BackgroundWriter() {
+    stop_ = true;
+    thread_.join();
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+void BM_AppendOnlyLogSnapshotScan(benchmark::State& state) {
+  AppendOnlyLog<int64_t> log;
+  for (int64_t i = 0; i < kInitialSize; ++i) {
+    log.push_back(i);
+  }
+  BackgroundWriter writer([&log](int64_t i) { log.push_back(i); });
+  int64_t items = 0;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    const auto snapshot = log.Snapshot();
+    for (int64_t x : snapshot) {
+      sum += x;
+    }
+    benchmark::DoNotOptimize(sum);
+    items += snapshot.size();
+  }
+  state.SetItemsProcessed(items);
+}
+BENCHMARK(BM_AppendOnlyLogSnapshotScan)->UseRealTime();
+
+void BM_AppendOnlyLogSegmentScan(benchmark::State& state) {
+  AppendOnlyLog<int64_t> log;
+  for (int64_t i = 0; i < kInitialSize; ++i) {
+    log.push_back(i);
+  }
+  BackgroundWriter writer([&log](int64_t i) { log.push_back(i); });
+  int64_t items = 0;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto segment : log.SnapshotSegments()) {
+      for (int64_t x : segment) {
+        sum += x;
+      }
+      items += segment.size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(items);
+}
+BENCHMARK(BM_AppendOnlyLogSegmentScan)->UseRealTime();
+
+void BM_MutexVectorScan(benchmark::State& state) {
+  std::mutex mutex;
+  std::vector<int64_t> log;
+  for (int64_t i = 0; i < kInitialSize; ++i) {
+    log.push_back(i);
+  }
+  BackgroundWriter writer([&log, &mutex](int64_t i) {
+    std::lock_guard<std::mutex> lock(mutex);
+    log.push_back(i);
+  });
+  int64_t items = 0;
+  for (auto _ : state) {
+    int64_t sum = 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int64_t x : log) {
+      sum += x;
+    }
+    benchmark::DoNotOptimize(sum);
+    items += log.size();
+  }
+  state.SetItemsProcessed(items);
+}
+BENCHMARK(BM_MutexVectorScan)->UseRealTime();
+
+}  // namespace
+}  // namespace genit
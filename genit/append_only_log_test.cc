@@ -0,0 +1,161 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/append_only_log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(AppendOnlyLogTest, AppendAndSnapshot) {
+  AppendOnlyLog<int, 2> log;
+  EXPECT_TRUE(log.empty());
+  EXPECT_TRUE(log.Snapshot().empty());
+  for (int i = 0; i < 5; ++i) {
+    log.push_back(i);
+  }
+  const auto snapshot = log.Snapshot();
+  for (int i = 5; i < 100; ++i) {
+    log.push_back(i);
+  }
+  EXPECT_THAT(snapshot, ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_EQ(log.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(log[i], i);
+  }
+}
+
+TEST(AppendOnlyLogTest, StableAddresses) {
+  AppendOnlyLog<int, 4> log;
+  std::vector<const int*> addresses;
+  for (int i = 0; i < 1000; ++i) {
+    addresses.push_back(&log.emplace_back(i));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(&log[i], addresses[i]);
+  }
+}
+
+TEST(AppendOnlyLogTest, SnapshotIsRandomAccess) {
+  AppendOnlyLog<int, 4> log;
+  for (int i = 0; i < 50; ++i) {
+    log.push_back(i * 2);
+  }
+  const auto snapshot = log.Snapshot();
+  using It = decltype(snapshot.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_TRUE((std::is_same_v<decltype(*snapshot.begin()), const int&>));
+  EXPECT_EQ(snapshot.size(), 50);
+  EXPECT_EQ(snapshot[37], 74);
+  EXPECT_EQ(*(snapshot.end() - 1), 98);
+  EXPECT_EQ(
+      std::lower_bound(snapshot.begin(), snapshot.end(), 40) - snapshot.begin(),
+      20);
+  EXPECT_THAT(TransformRange(IteratorRange(snapshot.begin(),
+                                           snapshot.begin() + 3),
+                             [](int i) { return i + 1; }),
+              ElementsAre(1, 3, 5));
+}
+
+TEST(AppendOnlyLogTest, SnapshotSegments) {
+  AppendOnlyLog<int, 2> log;
+  EXPECT_TRUE(log.SnapshotSegments().empty());
+  for (int i = 0; i < 9; ++i) {
+    log.push_back(i);
+  }
+  std::vector<std::vector<int>> segments;
+  for (auto segment : log.SnapshotSegments()) {
+    segments.emplace_back(segment.begin(), segment.end());
+  }
+  EXPECT_THAT(segments,
+              ElementsAre(ElementsAre(0, 1), ElementsAre(2, 3, 4, 5),
+                          ElementsAre(6, 7, 8)));
+}
+
+TEST(AppendOnlyLogTest, NonTrivialElements) {
+  AppendOnlyLog<std::string, 1> log;
+  log.emplace_back("a");
+  log.emplace_back(2, 'b');
+  log.push_back("c");
+  EXPECT_THAT(log.Snapshot(), ElementsAre("a", "bb", "c"));
+}
+
+// Stress test with one writer and several concurrent readers. This test is
+// most useful when run under ThreadSanitizer:
+//   bazel test --config=tsan //genit:append_only_log_test
+TEST(AppendOnlyLogTest, ConcurrentReadersSeeConsistentPrefixes) {
+  constexpr int kNumElements = 200000;
+  constexpr int kNumReaders = 4;
+  struct Sample {
+    int index;
+    int check;
+  };
+  AppendOnlyLog<Sample, 16> log;
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < kNumReaders; ++r) {
+    readers.emplace_back([&log, &failed] {
+      std::size_t last_size = 0;
+      while (last_size < kNumElements) {
+        const auto snapshot = log.Snapshot();
+        if (static_cast<std::size_t>(snapshot.size()) < last_size) {
+          failed = true;
+        }
+        int expected = 0;
+        for (const Sample& s : snapshot) {
+          if (s.index != expected || s.check != ~expected) {
+            failed = true;
+          }
+          ++expected;
+        }
+        expected = 0;
+        for (auto segment : log.SnapshotSegments()) {
+          for (const Sample& s : segment) {
+            if (s.index != expected || s.check != ~expected) {
+              failed = true;
+            }
+            ++expected;
+          }
+        }
+        last_size = snapshot.size();
+      }
+    });
+  }
+  for (int i = 0; i < kNumElements; ++i) {
+    log.push_back(Sample{i, ~i});
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_FALSE(failed);
+  EXPECT_EQ(log.size(), kNumElements);
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,324 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides lazy element-wise arithmetic expressions over
+// contiguous arrays of numbers. An expression such as
+//
+//   const auto expr = NumericView(a) * s + NumericView(b) - NumericView(c);
+//
+// does not compute anything: element i of the result is computed on the fly
+// as a[i] * s + b[i] - c[i] when it is needed, without temporary arrays or
+// tuples of references (compare with TransformRange(ZipRange(a, b, c), ...)).
+// The result is usually written with
+//
+//   expr.AssignTo(out);  // out[i] = a[i] * s + b[i] - c[i] for all i.
+//
+// which is a single loop over indices that compilers vectorize. Expressions
+// are also random-access ranges of values, and have an operator[].
+//
+// Scalars (arithmetic values) are broadcast to all elements. The size of an
+// expression is the smallest size of its array operands. The element type
+// follows the usual arithmetic conversions, e.g., float * double is double.
+//
+// Expressions store their operands by value, and the views only store a
+// pointer to the elements, so expressions are cheap to copy and can be built
+// from temporaries, but the arrays must outlive the expression.
+
+#ifndef GENIT_ARITHMETIC_EXPRESSION_H_
+#define GENIT_ARITHMETIC_EXPRESSION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_facade.h"
+
+namespace genit {
+
+// Forward-decl.
+template <typename Expr>
+class ArithmeticExpressionIterator;
+
+// Base class of arithmetic expressions. Derived must provide
+//   std::size_t size() const;
+//   auto operator[](std::size_t i) const;  // for i < size(), by value
+template <typename Derived>
+class ArithmeticExpressionBase {
+ public:
+  bool empty() const { return Self().size() == 0; }
+
+  // Writes the size() elements of the expression to out, in a single loop.
+  // out may be one of the arrays of the expression (e.g., for a = a * 2).
+  template <typename T>
+  void AssignTo(T* out) const {
+    const std::size_t size = Self().size();
+    for (std::size_t i = 0; i < size; ++i) {
+      out[i] = Self()[i];
+    }
+  }
+
+  // Writes the elements of the expression to the first size() elements of a
+  // contiguous range, e.g., a std::vector or a std::array.
+  template <typename OutRange,
+            std::enable_if_t<!std::is_pointer_v<OutRange>, int> = 0>
+  void AssignTo(OutRange& out) const {
+    assert(std::size(out) >= Self().size());
+    AssignTo(std::data(out));
+  }
+
+  // Returns the elements of the expression.
+  auto Materialize() const {
+    std::vector<std::decay_t<decltype(Self()[0])>> values(Self().size());
+    AssignTo(values.data());
+    return values;
+  }
+
+  ArithmeticExpressionIterator<Derived> begin() const {
+    return ArithmeticExpressionIterator<Derived>(&Self(), 0);
+  }
+  ArithmeticExpressionIterator<Derived> end() const {
+    return ArithmeticExpressionIterator<Derived>(&Self(), Self().size());
+  }
+
+ private:
+  const Derived& Self() const { return static_cast<const Derived&>(*this); }
+};
+
+template <typename T>
+inline constexpr bool kIsArithmeticExpression =
+    std::is_base_of_v<ArithmeticExpressionBase<T>, T>;
+
+// A view of a contiguous array of numbers, the leaf of arithmetic
+// expressions.
+template <typename T>
+class NumericArrayView : public ArithmeticExpressionBase<NumericArrayView<T>> {
+ public:
+  NumericArrayView(const T* values, std::size_t size)
+      : values_(values), size_(size) {}
+
+  std::size_t size() const { return size_; }
+  T operator[](std::size_t i) const { return values_[i]; }
+
+ private:
+  const T* values_;
+  std::size_t size_;
+};
+
+// A scalar repeated as many times as needed by the other operands.
+template <typename T>
+class BroadcastScalar : public ArithmeticExpressionBase<BroadcastScalar<T>> {
+ public:
+  explicit BroadcastScalar(T value) : value_(value) {}
+
+  std::size_t size() const { return std::numeric_limits<std::size_t>::max(); }
+  T operator[](std::size_t) const { return value_; }
+
+ private:
+  T value_;
+};
+
+// Creates a view of the first size values.
+template <typename T>
+NumericArrayView<T> NumericView(const T* values, std::size_t size) {
+  return NumericArrayView<T>(values, size);
+}
+
+// Creates a view of all values of a contiguous range, e.g., a std::vector.
+template <typename Range>
+auto NumericView(const Range& values) {
+  return NumericView(std::data(values), std::size(values));
+}
+
+namespace arithmetic_expression_detail {
+
+struct AddOp {
+  template <typename A, typename B>
+  auto operator()(A a, B b) const { return a + b; }
+};
+struct SubtractOp {
+  template <typename A, typename B>
+  auto operator()(A a, B b) const { return a - b; }
+};
+struct MultiplyOp {
+  template <typename A, typename B>
+  auto operator()(A a, B b) const { return a * b; }
+};
+struct DivideOp {
+  template <typename A, typename B>
+  auto operator()(A a, B b) const { return a / b; }
+};
+struct NegateOp {
+  template <typename A>
+  auto operator()(A a) const { return -a; }
+};
+struct MinOp {
+  template <typename A, typename B>
+  auto operator()(A a, B b) const { return b < a ? b : a; }
+};
+struct MaxOp {
+  template <typename A, typename B>
+  auto operator()(A a, B b) const { return a < b ? b : a; }
+};
+
+// Expressions are kept as they are, and scalars are broadcast.
+template <typename T>
+auto AsExpression(T value) {
+  if constexpr (kIsArithmeticExpression<T>) {
+    return value;
+  } else {
+    return BroadcastScalar<T>(value);
+  }
+}
+
+template <typename T>
+inline constexpr bool kIsOperand =
+    kIsArithmeticExpression<T> || std::is_arithmetic_v<T>;
+
+// Operators apply to two operands if at least one of them is an expression.
+template <typename A, typename B>
+inline constexpr bool kAreOperands =
+    kIsOperand<A> && kIsOperand<B> &&
+    (kIsArithmeticExpression<A> || kIsArithmeticExpression<B>);
+
+}  // namespace arithmetic_expression_detail
+
+// A lazy element-wise operation on one or more expressions.
+template <typename Op, typename... Exprs>
+class ArithmeticExpression
+    : public ArithmeticExpressionBase<ArithmeticExpression<Op, Exprs...>> {
+ public:
+  explicit ArithmeticExpression(Exprs... exprs)
+      : size_(std::min({exprs.size()...})), exprs_(std::move(exprs)...) {}
+
+  std::size_t size() const { return size_; }
+  auto operator[](std::size_t i) const {
+    return std::apply([i](const Exprs&... exprs) { return Op()(exprs[i]...); },
+                      exprs_);
+  }
+
+ private:
+  std::size_t size_;
+  std::tuple<Exprs...> exprs_;
+};
+
+namespace arithmetic_expression_detail {
+
+template <typename Op, typename A, typename B>
+auto MakeBinary(A a, B b) {
+  auto expr_a = AsExpression(std::move(a));
+  auto expr_b = AsExpression(std::move(b));
+  return ArithmeticExpression<Op, decltype(expr_a), decltype(expr_b)>(
+      std::move(expr_a), std::move(expr_b));
+}
+
+}  // namespace arithmetic_expression_detail
+
+// Operators for arithmetic expressions, where either operand may be a scalar.
+template <typename A, typename B,
+          std::enable_if_t<arithmetic_expression_detail::kAreOperands<A, B>,
+                           int> = 0>
+auto operator+(A a, B b) {
+  return arithmetic_expression_detail::MakeBinary<
+      arithmetic_expression_detail::AddOp>(std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<arithmetic_expression_detail::kAreOperands<A, B>,
+                           int> = 0>
+auto operator-(A a, B b) {
+  return arithmetic_expression_detail::MakeBinary<
+      arithmetic_expression_detail::SubtractOp>(std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<arithmetic_expression_detail::kAreOperands<A, B>,
+                           int> = 0>
+auto operator*(A a, B b) {
+  return arithmetic_expression_detail::MakeBinary<
+      arithmetic_expression_detail::MultiplyOp>(std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<arithmetic_expression_detail::kAreOperands<A, B>,
+                           int> = 0>
+auto operator/(A a, B b) {
+  return arithmetic_expression_detail::MakeBinary<
+      arithmetic_expression_detail::DivideOp>(std::move(a), std::move(b));
+}
+
+template <typename A, std::enable_if_t<kIsArithmeticExpression<A>, int> = 0>
+auto operator-(A a) {
+  return ArithmeticExpression<arithmetic_expression_detail::NegateOp, A>(
+      std::move(a));
+}
+
+// Element-wise minimum and maximum, e.g., to clamp values:
+//   ElementwiseMin(ElementwiseMax(NumericView(x), lo), hi).AssignTo(x);
+template <typename A, typename B,
+          std::enable_if_t<arithmetic_expression_detail::kAreOperands<A, B>,
+                           int> = 0>
+auto ElementwiseMin(A a, B b) {
+  return arithmetic_expression_detail::MakeBinary<
+      arithmetic_expression_detail::MinOp>(std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<arithmetic_expression_detail::kAreOperands<A, B>,
+                           int> = 0>
+auto ElementwiseMax(A a, B b) {
+  return arithmetic_expression_detail::MakeBinary<
+      arithmetic_expression_detail::MaxOp>(std::move(a), std::move(b));
+}
+
+// Iterates over the elements of an arithmetic expression.
+template <typename Expr>
+class ArithmeticExpressionIterator
+    : public IteratorFacade<
+          ArithmeticExpressionIterator<Expr>,
+          decltype(std::declval<const Expr&>()[std::size_t{0}]),
+          std::random_access_iterator_tag> {
+ public:
+  ArithmeticExpressionIterator() = default;
+  ArithmeticExpressionIterator(const Expr* expr, std::size_t index)
+      : expr_(expr), index_(index) {}
+
+ private:
+  friend class IteratorFacadePrivateAccess<ArithmeticExpressionIterator>;
+
+  auto Dereference() const { return (*expr_)[index_]; }
+  void Increment() { ++index_; }
+  void Decrement() { --index_; }
+  void Advance(int n) { index_ += n; }
+  int DistanceTo(const ArithmeticExpressionIterator& rhs) const {
+    return static_cast<int>(rhs.index_) - static_cast<int>(index_);
+  }
+  bool IsEqual(const ArithmeticExpressionIterator& rhs) const {
+    return index_ == rhs.index_;
+  }
+
+  const Expr* expr_ = nullptr;
+  std::size_t index_ = 0;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_ARITHMETIC_EXPRESSION_H_
@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares computing out[i] = a[i] * s + b[i] - c[i] with a lazy arithmetic
+// expression, a hand-written loop, and TransformRange(ZipRange(a, b, c), ...)
+// copied to the output.
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/arithmetic_expression.h"
+#include "genit/transform_iterator.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+namespace {
+
+std::vector<float> MakeValues(int n, int seed) {
+  std::vector<float> values(n);
+  for (int i = 0; i < n; ++i) {
+    values[i] = (i * seed) % 101 * 0.25f;
+  }
+  return values;
+}
+
+void BM_HandWrittenLoop(benchmark::State& state) {
+  const auto a = MakeValues(state.range(0), 3);
+  const auto b = MakeValues(state.range(0), 5);
+  const auto c = MakeValues(state.range(0), 7);
+  std::vector<float> out(a.size());
+  float s = 1.5f;
+  benchmark::DoNotOptimize(s);
+  for (auto _ : state) {
+    const int n = out.size();
+    for (int i = 0; i < n; ++i) {
+      out[i] = a[i] * s + b[i] - c[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+void BM_ArithmeticExpression(benchmark::State& state) {
+  const auto a = MakeValues(state.range(0), 3);
+  const auto b = MakeValues(state.range(0), 5);
+  const auto c = MakeValues(state.range(0), 7);
+  std::vector<float> out(a.size());
+  float s = 1.5f;
+  benchmark::DoNotOptimize(s);
+  for (auto _ : state) {
+    (NumericView(a) * s + NumericView(b) - NumericView(c)).AssignTo(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+void BM_ZipTransform(benchmark::State& state) {
+  const auto a = MakeValues(state.range(0), 3);
+  const auto b = MakeValues(state.range(0), 5);
+  const auto c = MakeValues(state.range(0), 7);
+  std::vector<float> out(a.size());
+  float s = 1.5f;
+  benchmark::DoNotOptimize(s);
+  for (auto _ : state) {
+    const auto values =
+        TransformRange(ZipRange(a, b, c), [s](const auto& abc) {
+          const auto& [ai, bi, ci] = abc;
+          return ai * s + bi - ci;
+        });
+    std::copy(values.begin(), values.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * a.size());
+}
+
+// Longer expression: a polynomial evaluated with Horner's method.
+void BM_PolynomialLoop(benchmark::State& state) {
+  const auto x = MakeValues(state.range(0), 3);
+  std::vector<float> out(x.size());
+  for (auto _ : state) {
+    const int n = out.size();
+    for (int i = 0; i < n; ++i) {
+      out[i] = ((0.5f * x[i] + 2.0f) * x[i] - 1.0f) * x[i] + 3.0f;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+void BM_PolynomialExpression(benchmark::State& state) {
+  const auto x = MakeValues(state.range(0), 3);
+  std::vector<float> out(x.size());
+  for (auto _ : state) {
+    const auto xs = NumericView(x);
+    (((0.5f * xs + 2.0f) * xs - 1.0f) * xs + 3.0f).AssignTo(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * x.size());
+}
+
+BENCHMARK(BM_HandWrittenLoop)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ArithmeticExpression)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ZipTransform)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PolynomialLoop)->Arg(1 << 14);
+BENCHMARK(BM_PolynomialExpression)->Arg(1 << 14);
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,129 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/arithmetic_expression.h"
+
+#include <array>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::DoubleEq;
+using ::testing::ElementsAre;
+
+TEST(ArithmeticExpressionTest, ScaleAndAdd) {
+  const std::vector<double> a = {1, 2, 3};
+  const std::vector<double> b = {10, 20, 30};
+  const std::vector<double> c = {1, 1, 1};
+  std::vector<double> out(3);
+  (NumericView(a) * 2.0 + NumericView(b) - NumericView(c)).AssignTo(out);
+  EXPECT_THAT(out, ElementsAre(11, 23, 35));
+}
+
+TEST(ArithmeticExpressionTest, Operators) {
+  const std::vector<int> a = {6, 8, 10};
+  const std::vector<int> b = {3, 2, 5};
+  EXPECT_THAT((NumericView(a) + NumericView(b)).Materialize(),
+              ElementsAre(9, 10, 15));
+  EXPECT_THAT((NumericView(a) - NumericView(b)).Materialize(),
+              ElementsAre(3, 6, 5));
+  EXPECT_THAT((NumericView(a) * NumericView(b)).Materialize(),
+              ElementsAre(18, 16, 50));
+  EXPECT_THAT((NumericView(a) / NumericView(b)).Materialize(),
+              ElementsAre(2, 4, 2));
+  EXPECT_THAT((-NumericView(a)).Materialize(), ElementsAre(-6, -8, -10));
+  EXPECT_THAT(ElementwiseMin(NumericView(a), NumericView(b) * 3).Materialize(),
+              ElementsAre(6, 6, 10));
+  EXPECT_THAT(ElementwiseMax(NumericView(a), 7).Materialize(),
+              ElementsAre(7, 8, 10));
+}
+
+TEST(ArithmeticExpressionTest, ScalarsOnEitherSide) {
+  const std::array<double, 3> a = {1, 2, 4};
+  EXPECT_THAT((1.0 / NumericView(a)).Materialize(),
+              ElementsAre(1.0, 0.5, 0.25));
+  EXPECT_THAT((NumericView(a) / 2).Materialize(), ElementsAre(0.5, 1, 2));
+  EXPECT_THAT((10 - NumericView(a)).Materialize(), ElementsAre(9, 8, 6));
+}
+
+TEST(ArithmeticExpressionTest, PromotesTypes) {
+  const std::vector<float> f = {0.5f, 1.5f};
+  const std::vector<int> i = {1, 2};
+  const auto expr = NumericView(f) * NumericView(i) + 1.0;
+  static_assert(std::is_same_v<decltype(expr[0]), double>);
+  EXPECT_THAT(expr.Materialize(), ElementsAre(1.5, 4.0));
+}
+
+TEST(ArithmeticExpressionTest, SizeIsTheSmallest) {
+  const std::vector<int> a = {1, 2, 3, 4};
+  const std::vector<int> b = {1, 2};
+  const auto expr = NumericView(a) + NumericView(b) * 2;
+  EXPECT_EQ(expr.size(), 2);
+  EXPECT_THAT(expr.Materialize(), ElementsAre(3, 6));
+  EXPECT_TRUE((NumericView(a) + NumericView(a.data(), 0)).empty());
+}
+
+TEST(ArithmeticExpressionTest, AssignToPointer) {
+  const std::vector<double> a = {1, 2, 3};
+  double out[4] = {0, 0, 0, 7};
+  (NumericView(a) * NumericView(a)).AssignTo(out);
+  EXPECT_THAT(out, ElementsAre(1, 4, 9, 7));
+}
+
+TEST(ArithmeticExpressionTest, AssignToOperand) {
+  std::vector<double> a = {1, 2, 3};
+  (NumericView(a) * 3.0 + 1.0).AssignTo(a);
+  EXPECT_THAT(a, ElementsAre(4, 7, 10));
+}
+
+TEST(ArithmeticExpressionTest, ClampsValues) {
+  std::vector<double> x = {-3, -0.5, 0.25, 2};
+  ElementwiseMin(ElementwiseMax(NumericView(x), -1.0), 1.0).AssignTo(x);
+  EXPECT_THAT(x, ElementsAre(-1, -0.5, 0.25, 1));
+}
+
+TEST(ArithmeticExpressionTest, IsARandomAccessRange) {
+  const std::vector<double> a = {1, 2, 3};
+  const auto expr = NumericView(a) * 0.5;
+  using It = decltype(expr.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_EQ(expr.end() - expr.begin(), 3);
+  EXPECT_THAT(expr[2], DoubleEq(1.5));
+  std::vector<double> values;
+  for (double value : expr) {
+    values.push_back(value);
+  }
+  EXPECT_THAT(values, ElementsAre(0.5, 1, 1.5));
+  EXPECT_EQ(*(expr.begin() + 1), 1.0);
+}
+
+TEST(ArithmeticExpressionTest, OutlivesTemporaryViews) {
+  const std::vector<double> a = {1, 2};
+  const auto make_expr = [&a] {
+    // The views are copied into the expression.
+    auto view = NumericView(a);
+    return view + view;
+  };
+  EXPECT_THAT(make_expr().Materialize(), ElementsAre(2, 4));
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides bulk kernels over arrays of uint64_t words, with
+// one implementation per instruction set level chosen at runtime (see
+// cpu_dispatch.h):
+//
+//   const std::size_t count = CountSetBitsInWords(words.data(), words.size());
+//
+// Without -mpopcnt, __builtin_popcountll is a library call on x86-64, so even
+// the SSE4.2 kernel (the same loop compiled with POPCNT) is several times
+// faster than the scalar one. The AVX2 and AVX-512 kernels count the bits of
+// each nibble with a byte shuffle (Mula et al., "Faster Population Counts
+// Using AVX2 Instructions").
+
+#ifndef GENIT_BIT_KERNELS_H_
+#define GENIT_BIT_KERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "genit/cpu_dispatch.h"
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace genit {
+
+namespace bit_kernels_detail {
+
+using CountSetBitsFn = std::size_t (*)(const uint64_t*, std::size_t);
+
+// Inlined in the kernels of each level, and compiled for that level.
+__attribute__((always_inline)) inline std::size_t CountSetBitsLoop(
+    const uint64_t* words, std::size_t num_words) {
+  // Independent accumulators to overlap the popcounts.
+  std::size_t counts[4] = {0, 0, 0, 0};
+  // GCC wrongly warns about i + 4 <= num_words (-Waggressive-loop-
+  // optimizations) when num_words is a constant, hence num_unrolled.
+  const std::size_t num_unrolled = num_words - num_words % 4;
+  std::size_t i = 0;
+  for (; i < num_unrolled; i += 4) {
+    for (int j = 0; j < 4; ++j) {
+      counts[j] += __builtin_popcountll(words[i + j]);
+    }
+  }
+  std::size_t count = counts[0] + counts[1] + counts[2] + counts[3];
+  for (; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+inline std::size_t CountSetBitsScalar(const uint64_t* words,
+                                      std::size_t num_words) {
+  return CountSetBitsLoop(words, num_words);
+}
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+
+__attribute__((target("sse4.2,popcnt"))) inline std::size_t
+CountSetBitsSse42(const uint64_t* words, std::size_t num_words) {
+  return CountSetBitsLoop(words, num_words);
+}
+
+__attribute__((target("avx2,popcnt"))) inline std::size_t CountSetBitsAvx2(
+    const uint64_t* words, std::size_t num_words) {
+  const __m256i lookup = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,  //
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i total = _mm256_setzero_si256();
+  const std::size_t num_unrolled = num_words - num_words % 4;
+  std::size_t i = 0;
+  for (; i < num_unrolled; i += 4) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(words + i));
+    const __m256i low = _mm256_and_si256(v, low_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                          _mm256_shuffle_epi8(lookup, high));
+    // Sums the 8 byte counts of each word.
+    total = _mm256_add_epi64(total,
+                             _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+  }
+  std::size_t count = _mm256_extract_epi64(total, 0) +
+                      _mm256_extract_epi64(total, 1) +
+                      _mm256_extract_epi64(total, 2) +
+                      _mm256_extract_epi64(total, 3);
+  for (; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+__attribute__((target("avx512f,avx512bw,avx2,popcnt"))) inline std::size_t
+CountSetBitsAvx512(const uint64_t* words, std::size_t num_words) {
+  // The same 16-byte table as above in each lane (bytes 0-7, then 8-15).
+  const __m512i lookup = _mm512_set_epi64(
+      0x0403030203020201, 0x0302020102010100, 0x0403030203020201,
+      0x0302020102010100, 0x0403030203020201, 0x0302020102010100,
+      0x0403030203020201, 0x0302020102010100);
+  const __m512i low_mask = _mm512_set1_epi8(0x0f);
+  __m512i total = _mm512_setzero_si512();
+  const std::size_t num_unrolled = num_words - num_words % 8;
+  std::size_t i = 0;
+  for (; i < num_unrolled; i += 8) {
+    const __m512i v = _mm512_loadu_si512(words + i);
+    const __m512i low = _mm512_and_si512(v, low_mask);
+    const __m512i high = _mm512_and_si512(_mm512_srli_epi16(v, 4), low_mask);
+    const __m512i bytes = _mm512_add_epi8(_mm512_shuffle_epi8(lookup, low),
+                                          _mm512_shuffle_epi8(lookup, high));
+    total = _mm512_add_epi64(total,
+                             _mm512_sad_epu8(bytes, _mm512_setzero_si512()));
+  }
+  uint64_t lanes[8];
+  _mm512_storeu_si512(lanes, total);
+  std::size_t count = 0;
+  for (uint64_t lane : lanes) {
+    count += lane;
+  }
+  for (; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+inline const CpuDispatchedFunction<CountSetBitsFn> kCountSetBits(
+    CountSetBitsScalar, CountSetBitsSse42, CountSetBitsAvx2,
+    CountSetBitsAvx512);
+
+#else  // GENIT_HAVE_X86_DISPATCH
+
+inline const CpuDispatchedFunction<CountSetBitsFn> kCountSetBits(
+    CountSetBitsScalar);
+
+#endif  // GENIT_HAVE_X86_DISPATCH
+
+}  // namespace bit_kernels_detail
+
+// Returns the number of set bits in words[0, num_words).
+inline std::size_t CountSetBitsInWords(const uint64_t* words,
+                                       std::size_t num_words) {
+  return bit_kernels_detail::kCountSetBits(words, num_words);
+}
+
+}  // namespace genit
+
+#endif  // GENIT_BIT_KERNELS_H_
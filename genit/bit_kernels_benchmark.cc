@@ -0,0 +1,53 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures CountSetBitsInWords at each instruction set level supported by the
+// machine (the first argument, see CpuLevel), for a number of words (the
+// second argument). Levels above the detected one run the detected level.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/bit_kernels.h"
+#include "genit/cpu_dispatch.h"
+
+namespace genit {
+namespace {
+
+void BM_CountSetBits(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  std::mt19937_64 rng(1);
+  std::vector<uint64_t> words(state.range(1));
+  for (uint64_t& word : words) {
+    word = rng();
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CountSetBitsInWords(words.data(), words.size()));
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetBytesProcessed(state.iterations() * words.size() *
+                          sizeof(uint64_t));
+}
+
+BENCHMARK(BM_CountSetBits)->ArgsProduct({{0, 1, 2, 3}, {16, 1024, 1 << 16}});
+
+}  // namespace
+}  // namespace genit
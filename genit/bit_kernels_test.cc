@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/bit_kernels.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "genit/cpu_dispatch.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+std::size_t NaiveCount(const std::vector<uint64_t>& words, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      count += (words[i] >> b) & 1;
+    }
+  }
+  return count;
+}
+
+TEST(BitKernelsTest, CountSetBitsAtEachLevel) {
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> words(100);
+  for (uint64_t& word : words) {
+    word = rng();
+  }
+  words[3] = ~uint64_t{0};
+  words[4] = 0;
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    // All sizes around the vector widths, for the tails.
+    for (std::size_t n = 0; n <= 20; ++n) {
+      EXPECT_EQ(CountSetBitsInWords(words.data(), n), NaiveCount(words, n))
+          << CpuLevelName(level) << " " << n;
+    }
+    EXPECT_EQ(CountSetBitsInWords(words.data() + 1, 99),
+              NaiveCount(words, 100) - NaiveCount(words, 1))
+        << CpuLevelName(level);
+  }
+}
+
+TEST(BitKernelsTest, AllOnes) {
+  const std::vector<uint64_t> words(1000, ~uint64_t{0});
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    EXPECT_EQ(CountSetBitsInWords(words.data(), words.size()), 64000)
+        << CpuLevelName(level);
+  }
+}
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+TEST(BitKernelsTest, DispatchesToLevelKernel) {
+  using bit_kernels_detail::kCountSetBits;
+  {
+    ScopedCpuLevelOverride override(CpuLevel::kScalar);
+    EXPECT_EQ(kCountSetBits.Get(), &bit_kernels_detail::CountSetBitsScalar);
+  }
+  if (DetectedCpuLevel() >= CpuLevel::kAvx2) {
+    ScopedCpuLevelOverride override(CpuLevel::kAvx2);
+    EXPECT_EQ(kCountSetBits.Get(), &bit_kernels_detail::CountSetBitsAvx2);
+  }
+}
+#endif  // GENIT_HAVE_X86_DISPATCH
+
+}  // namespace
+}  // namespace genit
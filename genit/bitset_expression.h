@@ -0,0 +1,477 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides lazy bitwise expressions over arrays of uint64_t
+// words (bit i is bit i % 64 of word i / 64). An expression such as
+//
+//   const auto expr = (BitwiseView(mask_a) & ~BitwiseView(mask_b)) |
+//                     BitwiseView(mask_c);
+//
+// does not compute anything: each word of the result is computed on the fly
+// when it is needed, without a temporary array. The set bits of the result can
+// be iterated directly, like AllSetBitIndices for a single word:
+//
+//   for (std::size_t i : expr.SetBitIndices()) { ... }
+//
+// or counted (CountSetBits()), or stored (Materialize() / MaterializeInto()).
+// The bulk operations evaluate the expression by blocks of words into a buffer
+// on the stack, with one kernel per instruction set level (see cpu_dispatch.h):
+// the word computations are inlined and vectorized for the level, and each
+// block is counted with the popcount kernel of the level (see bit_kernels.h).
+//
+// The size (in bits) of an expression is the smallest size of its operands,
+// and the bits past the size are ignored (in particular, those set by
+// BitwiseNot in the last word).
+//
+// Expressions store their operands by value, and the views only store a
+// pointer to the words, so expressions are cheap to copy and can be built from
+// temporaries, but the words must outlive the expression.
+
+#ifndef GENIT_BITSET_EXPRESSION_H_
+#define GENIT_BITSET_EXPRESSION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/bit_kernels.h"
+#include "genit/cpu_dispatch.h"
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+// Forward-decl.
+template <typename Expr>
+class SetBitIndexRange;
+
+namespace bitset_expression_detail {
+
+// The bulk kernels evaluate the words of an expression by blocks into a buffer
+// on the stack, with the word computations inlined in the kernel of each level
+// (and vectorized for that level), and then count or copy the buffer.
+inline constexpr std::size_t kBlockWords = 64;
+// Small enough for the copies of the buffer (memcpy) to be inlined.
+inline constexpr std::size_t kMaterializeBlockWords = 32;
+
+template <typename Expr>
+using CountExprSetBitsFn = std::size_t (*)(const Expr&, std::size_t);
+template <typename Expr>
+using MaterializeExprFn = void (*)(const Expr&, std::size_t, uint64_t*);
+
+// Writes the words [first, first + n) of expr to out.
+template <typename Expr>
+__attribute__((always_inline)) inline void EvaluateWords(
+    const Expr& expr, std::size_t first, std::size_t n,
+    uint64_t* __restrict out) {
+  for (std::size_t j = 0; j < n; ++j) {
+    out[j] = expr.Word(first + j);
+  }
+}
+
+// Inlined in the kernels of each level, with the count kernel of that level.
+template <typename Expr>
+__attribute__((always_inline)) inline std::size_t CountExprSetBitsLoop(
+    const Expr& expr, std::size_t num_words,
+    bit_kernels_detail::CountSetBitsFn count_words) {
+  uint64_t block[kBlockWords];
+  std::size_t count = 0;
+  std::size_t i = 0;
+  for (; i + kBlockWords <= num_words; i += kBlockWords) {
+    EvaluateWords(expr, i, kBlockWords, block);
+    count += count_words(block, kBlockWords);
+  }
+  if (i < num_words) {
+    EvaluateWords(expr, i, num_words - i, block);
+    count += count_words(block, num_words - i);
+  }
+  return count;
+}
+
+// Inlined in the kernels of each level. Evaluates through the buffer, such
+// that out may alias the words of the expression.
+template <typename Expr>
+__attribute__((always_inline)) inline void MaterializeExprLoop(
+    const Expr& expr, std::size_t num_words, uint64_t* out) {
+  uint64_t block[kMaterializeBlockWords];
+  std::size_t i = 0;
+  for (; i + kMaterializeBlockWords <= num_words;
+       i += kMaterializeBlockWords) {
+    EvaluateWords(expr, i, kMaterializeBlockWords, block);
+    std::memcpy(out + i, block, sizeof(block));
+  }
+  if (i < num_words) {
+    EvaluateWords(expr, i, num_words - i, block);
+    std::memcpy(out + i, block, (num_words - i) * sizeof(uint64_t));
+  }
+}
+
+template <typename Expr>
+std::size_t CountExprSetBitsScalar(const Expr& expr, std::size_t num_words) {
+  return CountExprSetBitsLoop(expr, num_words,
+                              bit_kernels_detail::CountSetBitsScalar);
+}
+
+template <typename Expr>
+void MaterializeExprScalar(const Expr& expr, std::size_t num_words,
+                           uint64_t* out) {
+  MaterializeExprLoop(expr, num_words, out);
+}
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+
+template <typename Expr>
+__attribute__((target("sse4.2,popcnt"))) std::size_t CountExprSetBitsSse42(
+    const Expr& expr, std::size_t num_words) {
+  return CountExprSetBitsLoop(expr, num_words,
+                              bit_kernels_detail::CountSetBitsSse42);
+}
+
+template <typename Expr>
+__attribute__((target("avx2,popcnt"))) std::size_t CountExprSetBitsAvx2(
+    const Expr& expr, std::size_t num_words) {
+  return CountExprSetBitsLoop(expr, num_words,
+                              bit_kernels_detail::CountSetBitsAvx2);
+}
+
+template <typename Expr>
+__attribute__((target("avx512f,avx512bw,avx2,popcnt"))) std::size_t
+CountExprSetBitsAvx512(const Expr& expr, std::size_t num_words) {
+  return CountExprSetBitsLoop(expr, num_words,
+                              bit_kernels_detail::CountSetBitsAvx512);
+}
+
+template <typename Expr>
+__attribute__((target("avx2"))) void MaterializeExprAvx2(
+    const Expr& expr, std::size_t num_words, uint64_t* out) {
+  MaterializeExprLoop(expr, num_words, out);
+}
+
+template <typename Expr>
+__attribute__((target("avx512f,avx512bw,avx2"))) void MaterializeExprAvx512(
+    const Expr& expr, std::size_t num_words, uint64_t* out) {
+  MaterializeExprLoop(expr, num_words, out);
+}
+
+template <typename Expr>
+inline const CpuDispatchedFunction<CountExprSetBitsFn<Expr>>
+    kCountExprSetBits(CountExprSetBitsScalar<Expr>,
+                      CountExprSetBitsSse42<Expr>, CountExprSetBitsAvx2<Expr>,
+                      CountExprSetBitsAvx512<Expr>);
+
+// SSE4.2 adds nothing to the (SSE2) word computations of the scalar kernel.
+template <typename Expr>
+inline const CpuDispatchedFunction<MaterializeExprFn<Expr>> kMaterializeExpr(
+    MaterializeExprScalar<Expr>, nullptr, MaterializeExprAvx2<Expr>,
+    MaterializeExprAvx512<Expr>);
+
+#else  // GENIT_HAVE_X86_DISPATCH
+
+template <typename Expr>
+inline const CpuDispatchedFunction<CountExprSetBitsFn<Expr>>
+    kCountExprSetBits(CountExprSetBitsScalar<Expr>);
+
+template <typename Expr>
+inline const CpuDispatchedFunction<MaterializeExprFn<Expr>> kMaterializeExpr(
+    MaterializeExprScalar<Expr>);
+
+#endif  // GENIT_HAVE_X86_DISPATCH
+
+}  // namespace bitset_expression_detail
+
+// Base class of bitwise expressions. Derived must provide
+//   std::size_t num_bits() const;
+//   uint64_t Word(std::size_t i) const;  // for i < NumWords()
+template <typename Derived>
+class BitwiseExpressionBase {
+ public:
+  // Returns the number of words covering the bits of the expression.
+  std::size_t NumWords() const { return (Self().num_bits() + 63) / 64; }
+
+  // Returns the number of set bits, with the best kernel for the CPU (see
+  // cpu_dispatch.h).
+  std::size_t CountSetBits() const {
+    const std::size_t num_full_words = Self().num_bits() / 64;
+    std::size_t count = bitset_expression_detail::kCountExprSetBits<Derived>(
+        Self(), num_full_words);
+    if (num_full_words < NumWords()) {
+      count += __builtin_popcountll(LastWord());
+    }
+    return count;
+  }
+
+  // Writes the NumWords() words of the expression to out, with the best
+  // kernel for the CPU. The bits past num_bits() are cleared. out may be one
+  // of the operands.
+  void MaterializeInto(uint64_t* out) const {
+    const std::size_t num_full_words = Self().num_bits() / 64;
+    bitset_expression_detail::kMaterializeExpr<Derived>(Self(), num_full_words,
+                                                        out);
+    if (num_full_words < NumWords()) {
+      out[num_full_words] = LastWord();
+    }
+  }
+
+  // Returns the NumWords() words of the expression.
+  std::vector<uint64_t> Materialize() const {
+    std::vector<uint64_t> words(NumWords());
+    MaterializeInto(words.data());
+    return words;
+  }
+
+  // Returns a forward range over the indices of the set bits, in increasing
+  // order.
+  SetBitIndexRange<Derived> SetBitIndices() const {
+    return SetBitIndexRange<Derived>(Self());
+  }
+
+  // Returns the i-th word, without the bits past num_bits().
+  uint64_t MaskedWord(std::size_t i) const {
+    return i + 1 == NumWords() ? LastWord() : Self().Word(i);
+  }
+
+ private:
+  const Derived& Self() const { return static_cast<const Derived&>(*this); }
+
+  uint64_t LastWord() const {
+    const std::size_t i = NumWords() - 1;
+    const int num_tail_bits = Self().num_bits() % 64;
+    const uint64_t word = Self().Word(i);
+    return num_tail_bits == 0 ? word
+                              : word & ((uint64_t{1} << num_tail_bits) - 1);
+  }
+};
+
+template <typename T>
+inline constexpr bool kIsBitwiseExpression =
+    std::is_base_of_v<BitwiseExpressionBase<T>, T>;
+
+// A view of an array of words, the leaf of bitwise expressions.
+class BitwiseWordView : public BitwiseExpressionBase<BitwiseWordView> {
+ public:
+  BitwiseWordView(const uint64_t* words, std::size_t num_bits)
+      : words_(words), num_bits_(num_bits) {}
+
+  std::size_t num_bits() const { return num_bits_; }
+  uint64_t Word(std::size_t i) const { return words_[i]; }
+
+  // Counts the full words in place (without the buffer of the expression
+  // kernels) with the best kernel for the CPU (see bit_kernels.h).
+  std::size_t CountSetBits() const {
+    const std::size_t num_full_words = num_bits_ / 64;
+    std::size_t count = CountSetBitsInWords(words_, num_full_words);
+    if (num_full_words < NumWords()) {
+      count += __builtin_popcountll(MaskedWord(num_full_words));
+    }
+    return count;
+  }
+
+ private:
+  const uint64_t* words_;
+  std::size_t num_bits_;
+};
+
+// Creates a view of the first num_bits bits of words.
+inline BitwiseWordView BitwiseView(const uint64_t* words,
+                                   std::size_t num_bits) {
+  return BitwiseWordView(words, num_bits);
+}
+
+// Creates a view of all bits of a contiguous range of words, e.g., a
+// std::vector<uint64_t>.
+template <typename WordRange>
+BitwiseWordView BitwiseView(const WordRange& words) {
+  return BitwiseWordView(std::data(words), std::size(words) * 64);
+}
+
+namespace bitset_expression_detail {
+
+struct AndOp {
+  uint64_t operator()(uint64_t a, uint64_t b) const { return a & b; }
+};
+struct OrOp {
+  uint64_t operator()(uint64_t a, uint64_t b) const { return a | b; }
+};
+struct XorOp {
+  uint64_t operator()(uint64_t a, uint64_t b) const { return a ^ b; }
+};
+struct AndNotOp {
+  uint64_t operator()(uint64_t a, uint64_t b) const { return a & ~b; }
+};
+struct NotOp {
+  uint64_t operator()(uint64_t a) const { return ~a; }
+};
+
+}  // namespace bitset_expression_detail
+
+// A lazy bitwise operation on one or more expressions.
+template <typename Op, typename... Exprs>
+class BitwiseExpression
+    : public BitwiseExpressionBase<BitwiseExpression<Op, Exprs...>> {
+ public:
+  explicit BitwiseExpression(Exprs... exprs)
+      : num_bits_(std::min({exprs.num_bits()...})),
+        exprs_(std::move(exprs)...) {}
+
+  std::size_t num_bits() const { return num_bits_; }
+  uint64_t Word(std::size_t i) const {
+    return std::apply(
+        [i](const Exprs&... exprs) { return Op()(exprs.Word(i)...); },
+        exprs_);
+  }
+
+ private:
+  std::size_t num_bits_;
+  std::tuple<Exprs...> exprs_;
+};
+
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto BitwiseAnd(A a, B b) {
+  return BitwiseExpression<bitset_expression_detail::AndOp, A, B>(
+      std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto BitwiseOr(A a, B b) {
+  return BitwiseExpression<bitset_expression_detail::OrOp, A, B>(
+      std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto BitwiseXor(A a, B b) {
+  return BitwiseExpression<bitset_expression_detail::XorOp, A, B>(
+      std::move(a), std::move(b));
+}
+
+// Returns a & ~b, with a single operation per word.
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto BitwiseAndNot(A a, B b) {
+  return BitwiseExpression<bitset_expression_detail::AndNotOp, A, B>(
+      std::move(a), std::move(b));
+}
+
+template <typename A, std::enable_if_t<kIsBitwiseExpression<A>, int> = 0>
+auto BitwiseNot(A a) {
+  return BitwiseExpression<bitset_expression_detail::NotOp, A>(std::move(a));
+}
+
+// Operators for bitwise expressions.
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto operator&(A a, B b) {
+  return BitwiseAnd(std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto operator|(A a, B b) {
+  return BitwiseOr(std::move(a), std::move(b));
+}
+
+template <typename A, typename B,
+          std::enable_if_t<kIsBitwiseExpression<A> && kIsBitwiseExpression<B>,
+                           int> = 0>
+auto operator^(A a, B b) {
+  return BitwiseXor(std::move(a), std::move(b));
+}
+
+template <typename A, std::enable_if_t<kIsBitwiseExpression<A>, int> = 0>
+auto operator~(A a) {
+  return BitwiseNot(std::move(a));
+}
+
+// Iterates over the indices of the set bits of a bitwise expression.
+template <typename Expr>
+class SetBitIndexIterator
+    : public IteratorFacade<SetBitIndexIterator<Expr>, std::size_t,
+                            std::forward_iterator_tag> {
+ public:
+  SetBitIndexIterator() = default;
+  // Points to the first set bit in or after the word_index-th word.
+  SetBitIndexIterator(const Expr* expr, std::size_t word_index)
+      : expr_(expr) {
+    SkipToNonZeroWord(word_index);
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<SetBitIndexIterator>;
+
+  void SkipToNonZeroWord(std::size_t word_index) {
+    const std::size_t num_words = expr_->NumWords();
+    word_index_ = word_index;
+    word_ = 0;
+    while (word_index_ < num_words &&
+           (word_ = expr_->MaskedWord(word_index_)) == 0) {
+      ++word_index_;
+    }
+  }
+
+  std::size_t Dereference() const {
+    return word_index_ * 64 + __builtin_ctzll(word_);
+  }
+  void Increment() {
+    word_ &= word_ - 1;
+    if (word_ == 0) {
+      SkipToNonZeroWord(word_index_ + 1);
+    }
+  }
+  bool IsEqual(const SetBitIndexIterator& rhs) const {
+    return word_index_ == rhs.word_index_ && word_ == rhs.word_;
+  }
+
+  const Expr* expr_ = nullptr;
+  std::size_t word_index_ = 0;
+  // The bits of the current word that have not been visited yet.
+  uint64_t word_ = 0;
+};
+
+// A range over the indices of the set bits of a bitwise expression, which it
+// stores.
+template <typename Expr>
+class SetBitIndexRange {
+ public:
+  using iterator = SetBitIndexIterator<Expr>;
+  using value_type = std::size_t;
+
+  explicit SetBitIndexRange(Expr expr) : expr_(std::move(expr)) {}
+
+  iterator begin() const { return iterator(&expr_, 0); }
+  iterator end() const { return iterator(&expr_, expr_.NumWords()); }
+  bool empty() const { return begin() == end(); }
+
+ private:
+  Expr expr_;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_BITSET_EXPRESSION_H_
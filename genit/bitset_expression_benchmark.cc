@@ -0,0 +1,146 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares iterating and counting the set bits of (a & ~b) | c with a lazy
+// bitwise expression against computing the result into a temporary array
+// first, for 2^16 to 2^26 bits. The lazy count and MaterializeInto run at each
+// instruction set level supported by the machine (the first argument, see
+// CpuLevel).
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/bitset_expression.h"
+#include "genit/cpu_dispatch.h"
+
+namespace genit {
+namespace {
+
+// About 1/16 of the bits are set in each operand.
+std::vector<uint64_t> MakeWords(std::size_t num_bits, int seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> words(num_bits / 64);
+  for (uint64_t& word : words) {
+    word = rng() & rng() & rng() & rng();
+  }
+  return words;
+}
+
+struct Operands {
+  explicit Operands(std::size_t num_bits)
+      : a(MakeWords(num_bits, 1)),
+        b(MakeWords(num_bits, 2)),
+        c(MakeWords(num_bits, 3)) {}
+
+  std::vector<uint64_t> a;
+  std::vector<uint64_t> b;
+  std::vector<uint64_t> c;
+};
+
+void BM_IterateLazy(benchmark::State& state) {
+  const Operands ops(state.range(0));
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (std::size_t i : ((BitwiseView(ops.a) & ~BitwiseView(ops.b)) |
+                          BitwiseView(ops.c))
+                             .SetBitIndices()) {
+      sum += i;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * ops.a.size() * 3 * 8);
+}
+
+void BM_IterateMaterialized(benchmark::State& state) {
+  const Operands ops(state.range(0));
+  std::vector<uint64_t> tmp(ops.a.size());
+  for (auto _ : state) {
+    for (std::size_t w = 0; w < tmp.size(); ++w) {
+      tmp[w] = (ops.a[w] & ~ops.b[w]) | ops.c[w];
+    }
+    std::size_t sum = 0;
+    for (std::size_t w = 0; w < tmp.size(); ++w) {
+      for (uint64_t word = tmp[w]; word != 0; word &= word - 1) {
+        sum += w * 64 + __builtin_ctzll(word);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * ops.a.size() * 3 * 8);
+}
+
+void BM_CountLazy(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  const Operands ops(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ((BitwiseView(ops.a) & ~BitwiseView(ops.b)) | BitwiseView(ops.c))
+            .CountSetBits());
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetBytesProcessed(state.iterations() * ops.a.size() * 3 * 8);
+}
+
+void BM_CountMaterialized(benchmark::State& state) {
+  const Operands ops(state.range(0));
+  std::vector<uint64_t> tmp(ops.a.size());
+  for (auto _ : state) {
+    for (std::size_t w = 0; w < tmp.size(); ++w) {
+      tmp[w] = (ops.a[w] & ~ops.b[w]) | ops.c[w];
+    }
+    std::size_t count = 0;
+    for (uint64_t word : tmp) {
+      count += __builtin_popcountll(word);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * ops.a.size() * 3 * 8);
+}
+
+void BM_MaterializeInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  const Operands ops(state.range(1));
+  std::vector<uint64_t> out(ops.a.size());
+  for (auto _ : state) {
+    ((BitwiseView(ops.a) & ~BitwiseView(ops.b)) | BitwiseView(ops.c))
+        .MaterializeInto(out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetBytesProcessed(state.iterations() * ops.a.size() * 3 * 8);
+}
+
+BENCHMARK(BM_IterateLazy)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_IterateMaterialized)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_CountLazy)
+    ->ArgsProduct({{0, 1, 2, 3}, {1 << 16, 1 << 20, 1 << 26}});
+BENCHMARK(BM_CountMaterialized)->Range(1 << 16, 1 << 26);
+BENCHMARK(BM_MaterializeInto)
+    ->ArgsProduct({{0, 1, 2, 3}, {1 << 16, 1 << 20, 1 << 26}});
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,199 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/bitset_expression.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "genit/cpu_dispatch.h"
+#include "genit/filter_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<uint64_t> RandomWords(std::size_t num_words, int seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> words(num_words);
+  for (uint64_t& word : words) {
+    word = rng() & rng();
+  }
+  return words;
+}
+
+std::vector<std::size_t> SetBitsByScan(const std::vector<uint64_t>& words,
+                                       std::size_t num_bits) {
+  std::vector<std::size_t> bits;
+  for (std::size_t i = 0; i < num_bits; ++i) {
+    if ((words[i / 64] >> (i % 64)) & 1) {
+      bits.push_back(i);
+    }
+  }
+  return bits;
+}
+
+TEST(BitsetExpressionTest, Operators) {
+  const std::vector<uint64_t> a = {0b1100, uint64_t{1} << 63};
+  const std::vector<uint64_t> b = {0b1010, 0};
+  EXPECT_THAT((BitwiseView(a) & BitwiseView(b)).Materialize(),
+              ElementsAre(0b1000, 0));
+  EXPECT_THAT((BitwiseView(a) | BitwiseView(b)).Materialize(),
+              ElementsAre(0b1110, uint64_t{1} << 63));
+  EXPECT_THAT((BitwiseView(a) ^ BitwiseView(b)).Materialize(),
+              ElementsAre(0b0110, uint64_t{1} << 63));
+  EXPECT_THAT(BitwiseAndNot(BitwiseView(a), BitwiseView(b)).Materialize(),
+              ElementsAre(0b0100, uint64_t{1} << 63));
+  EXPECT_THAT((~BitwiseView(a)).Materialize(),
+              ElementsAre(~uint64_t{0b1100}, ~(uint64_t{1} << 63)));
+}
+
+TEST(BitsetExpressionTest, SetBitIndices) {
+  const std::vector<uint64_t> a = {0b1100, uint64_t{1} << 63, 0, 1};
+  const std::vector<uint64_t> b = {0b1010, 0, 0, 0};
+  const std::vector<uint64_t> c = {0b0001, 0, 0, 0};
+  const auto expr = (BitwiseView(a) & ~BitwiseView(b)) | BitwiseView(c);
+  EXPECT_THAT(expr.SetBitIndices(), ElementsAre(0, 2, 127, 192));
+  EXPECT_EQ(expr.CountSetBits(), 4);
+}
+
+TEST(BitsetExpressionTest, Empty) {
+  const std::vector<uint64_t> a = {0, 0, 0};
+  EXPECT_TRUE(BitwiseView(a).SetBitIndices().empty());
+  EXPECT_EQ(BitwiseView(a).CountSetBits(), 0);
+  EXPECT_TRUE(BitwiseView(a.data(), 0).SetBitIndices().empty());
+  EXPECT_THAT(BitwiseView(a.data(), 0).Materialize(), IsEmpty());
+}
+
+TEST(BitsetExpressionTest, IgnoresBitsPastSize) {
+  const std::vector<uint64_t> a = {0, 0};
+  const std::vector<uint64_t> b = {0, 0, 0};
+  // The size is the smallest size of the operands.
+  const auto expr = ~BitwiseView(a.data(), 70) | BitwiseView(b);
+  EXPECT_EQ(expr.num_bits(), 70);
+  EXPECT_EQ(expr.NumWords(), 2);
+  EXPECT_EQ(expr.CountSetBits(), 70);
+  EXPECT_THAT(expr.Materialize(),
+              ElementsAre(~uint64_t{0}, (uint64_t{1} << 6) - 1));
+  const auto bits = expr.SetBitIndices();
+  EXPECT_EQ(std::vector<std::size_t>(bits.begin(), bits.end()),
+            SetBitsByScan({~uint64_t{0}, ~uint64_t{0}}, 70));
+}
+
+TEST(BitsetExpressionTest, MatchesMaterializedResult) {
+  const std::vector<uint64_t> a = RandomWords(301, 1);
+  const std::vector<uint64_t> b = RandomWords(301, 2);
+  const std::vector<uint64_t> c = RandomWords(301, 3);
+  std::vector<uint64_t> expected(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    expected[i] = (a[i] ^ ~b[i]) | (c[i] & ~a[i]);
+  }
+  const std::size_t num_bits = a.size() * 64 - 5;
+  expected.back() &= (uint64_t{1} << 59) - 1;
+  const auto a_view = BitwiseView(a.data(), num_bits);
+  const auto expr = (a_view ^ ~BitwiseView(b)) |
+                    BitwiseAndNot(BitwiseView(c), a_view);
+  EXPECT_EQ(expr.Materialize(), expected);
+  const std::vector<std::size_t> expected_bits =
+      SetBitsByScan(expected, num_bits);
+  EXPECT_EQ(expr.CountSetBits(), expected_bits.size());
+  const auto bits = expr.SetBitIndices();
+  EXPECT_EQ(std::vector<std::size_t>(bits.begin(), bits.end()),
+            expected_bits);
+}
+
+TEST(BitsetExpressionTest, CountAndMaterializeAtEachLevel) {
+  const std::vector<uint64_t> a = RandomWords(200, 1);
+  const std::vector<uint64_t> b = RandomWords(200, 2);
+  const std::vector<uint64_t> c = RandomWords(200, 3);
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    // Partial and full blocks, with and without a partial last word.
+    for (std::size_t num_bits : {0, 1, 64, 100, 31 * 64 + 7, 64 * 64,
+                                 65 * 64 + 1, 129 * 64, 200 * 64 - 3}) {
+      const auto expr = (BitwiseView(a.data(), num_bits) & ~BitwiseView(b)) |
+                        BitwiseView(c);
+      std::vector<uint64_t> expected(expr.NumWords());
+      for (std::size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = (a[i] & ~b[i]) | c[i];
+      }
+      if (num_bits % 64 != 0) {
+        expected.back() &= (uint64_t{1} << (num_bits % 64)) - 1;
+      }
+      EXPECT_EQ(expr.Materialize(), expected)
+          << CpuLevelName(level) << ", " << num_bits;
+      EXPECT_EQ(expr.CountSetBits(), SetBitsByScan(expected, num_bits).size())
+          << CpuLevelName(level) << ", " << num_bits;
+    }
+  }
+}
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+TEST(BitsetExpressionTest, DispatchesToLevelKernels) {
+  using Expr = decltype(BitwiseView(nullptr, 0) & ~BitwiseView(nullptr, 0));
+  using bitset_expression_detail::kCountExprSetBits;
+  using bitset_expression_detail::kMaterializeExpr;
+  {
+    ScopedCpuLevelOverride override(CpuLevel::kScalar);
+    EXPECT_EQ(kCountExprSetBits<Expr>.Get(),
+              &bitset_expression_detail::CountExprSetBitsScalar<Expr>);
+    EXPECT_EQ(kMaterializeExpr<Expr>.Get(),
+              &bitset_expression_detail::MaterializeExprScalar<Expr>);
+  }
+  if (DetectedCpuLevel() >= CpuLevel::kAvx2) {
+    ScopedCpuLevelOverride override(CpuLevel::kAvx2);
+    EXPECT_EQ(kCountExprSetBits<Expr>.Get(),
+              &bitset_expression_detail::CountExprSetBitsAvx2<Expr>);
+    EXPECT_EQ(kMaterializeExpr<Expr>.Get(),
+              &bitset_expression_detail::MaterializeExprAvx2<Expr>);
+  }
+}
+#endif  // GENIT_HAVE_X86_DISPATCH
+
+TEST(BitsetExpressionTest, MaterializeIntoOperand) {
+  std::vector<uint64_t> a = RandomWords(150, 1);
+  const std::vector<uint64_t> b = RandomWords(150, 2);
+  std::vector<uint64_t> expected(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    expected[i] = a[i] ^ b[i];
+  }
+  (BitwiseView(a) ^ BitwiseView(b)).MaterializeInto(a.data());
+  EXPECT_EQ(a, expected);
+}
+
+TEST(BitsetExpressionTest, OutlivesTemporaryExpressions) {
+  const std::vector<uint64_t> a = {0b0110};
+  const std::vector<uint64_t> b = {0b0011};
+  std::vector<std::size_t> bits;
+  for (std::size_t i : (BitwiseView(a) & BitwiseView(b)).SetBitIndices()) {
+    bits.push_back(i);
+  }
+  EXPECT_THAT(bits, ElementsAre(1));
+}
+
+TEST(BitsetExpressionTest, ComposesWithRangeAdapters) {
+  const std::vector<uint64_t> a = {0xff};
+  const auto even = FilterRange(BitwiseView(a).SetBitIndices(),
+                                [](std::size_t i) { return i % 2 == 0; });
+  EXPECT_THAT(even, ElementsAre(0, 2, 4, 6));
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,295 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENIT_CHUNKED_VECTOR_H_
+#define GENIT_CHUNKED_VECTOR_H_
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+
+namespace chunked_vector_detail {
+
+constexpr bool IsPowerOfTwo(std::size_t n) {
+  return n != 0 && (n & (n - 1)) == 0;
+}
+
+constexpr int Log2(std::size_t n) { return n <= 1 ? 0 : 1 + Log2(n / 2); }
+
+}  // namespace chunked_vector_detail
+
+// A ChunkedVector is an append-only sequence container that stores its
+// elements in fixed-size chunks of ChunkSize elements. Chunks are never
+// relocated, so growing the container never moves existing elements:
+//  - Pointers and references to elements remain valid until the element is
+//    removed (pop_back, clear) or the container is destroyed.
+//  - Iterators store a pointer to the container and an index, so they remain
+//    valid across push_back. They refer to the container object itself, so
+//    they do not follow the elements when the container is moved.
+//  - push_back is O(1) amortized and never copies existing elements.
+//
+// Iterators are random access. When ChunkSize is a power of two, the mapping
+// from an index to a chunk and an offset is a shift and a mask.
+//
+// For bulk algorithms, Segments() exposes each chunk as a contiguous
+// PtrRange, such that a loop can be run once per chunk over raw pointers:
+//
+//   ChunkedVector<float, 1024> samples;
+//   ...
+//   float sum = 0.0f;
+//   for (auto segment : samples.Segments()) {
+//     sum = std::accumulate(segment.begin(), segment.end(), sum);
+//   }
+//
+// Note that ranges created from an lvalue ChunkedVector (e.g.,
+// TransformRange(samples, f)) alias the begin and end iterators at the time of
+// their creation, and will therefore not see elements appended afterwards.
+// They remain valid, however, because iterators are not invalidated by
+// push_back.
+template <typename T, std::size_t ChunkSize = 256>
+class ChunkedVector {
+  static_assert(ChunkSize > 0, "ChunkSize must be greater than zero.");
+
+ public:
+  template <bool IsConst>
+  class Iterator;
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = int;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  static constexpr std::size_t kChunkSize = ChunkSize;
+
+  // Random-access iterator into a ChunkedVector.
+  template <bool IsConst>
+  class Iterator
+      : public IteratorFacade<Iterator<IsConst>,
+                              std::conditional_t<IsConst, const T&, T&>,
+                              std::random_access_iterator_tag> {
+   public:
+    Iterator() = default;
+    Iterator(const ChunkedVector* parent, std::size_t index)
+        : parent_(parent), index_(index) {}
+
+    // Conversion from iterator to const_iterator.
+    template <bool OtherIsConst,
+              std::enable_if_t<IsConst && !OtherIsConst, int> = 0>
+    Iterator(const Iterator<OtherIsConst>& other)  // NOLINT
+        : parent_(other.parent_), index_(other.index_) {}
+
+    // Returns the index of the element pointed to by this iterator.
+    std::size_t index() const { return index_; }
+
+   private:
+    friend class IteratorFacadePrivateAccess<Iterator>;
+    friend class Iterator<!IsConst>;
+
+    using RefType = std::conditional_t<IsConst, const T&, T&>;
+
+    // Implementation of the IteratorFacade requirements:
+    RefType Dereference() const { return *parent_->ElementPtr(index_); }
+    void Increment() { ++index_; }
+    void Decrement() { --index_; }
+    bool IsEqual(const Iterator& rhs) const { return index_ == rhs.index_; }
+    int DistanceTo(const Iterator& rhs) const {
+      return static_cast<int>(rhs.index_) - static_cast<int>(index_);
+    }
+    void Advance(int n) { index_ += n; }
+
+    const ChunkedVector* parent_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  ChunkedVector() = default;
+
+  ChunkedVector(const ChunkedVector& other) {
+    for (const T& value : other) {
+      push_back(value);
+    }
+  }
+
+  // Moving transfers the chunks, so element addresses are preserved.
+  ChunkedVector(ChunkedVector&& other) noexcept
+      : chunks_(std::move(other.chunks_)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  ChunkedVector& operator=(const ChunkedVector& other) {
+    if (this != &other) {
+      ChunkedVector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  ChunkedVector& operator=(ChunkedVector&& other) noexcept {
+    if (this != &other) {
+      clear();
+      chunks_ = std::move(other.chunks_);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~ChunkedVector() { clear(); }
+
+  void swap(ChunkedVector& other) noexcept {
+    chunks_.swap(other.chunks_);
+    std::swap(size_, other.size_);
+  }
+
+  // Appends a new element constructed in-place from args.
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ == capacity()) {
+      chunks_.emplace_back(new Slot[ChunkSize]);
+    }
+    T* ptr = ::new (static_cast<void*>(SlotPtr(size_)))
+        T(std::forward<Args>(args)...);
+    ++size_;
+    return *ptr;
+  }
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  // Removes the last element. The chunk is kept for reuse.
+  void pop_back() {
+    assert(!empty());
+    --size_;
+    ElementPtr(size_)->~T();
+  }
+
+  // Removes all elements. The chunks are kept for reuse.
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (std::size_t i = 0; i < size_; ++i) {
+        ElementPtr(i)->~T();
+      }
+    }
+    size_ = 0;
+  }
+
+  // Releases the chunks that do not hold any elements.
+  void shrink_to_fit() { chunks_.resize(NumSegments()); }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::size_t capacity() const { return chunks_.size() * ChunkSize; }
+
+  T& operator[](std::size_t i) {
+    assert(i < size_);
+    return *ElementPtr(i);
+  }
+  const T& operator[](std::size_t i) const {
+    assert(i < size_);
+    return *ElementPtr(i);
+  }
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[size_ - 1]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size_); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Returns the number of (non-empty) contiguous segments.
+  std::size_t NumSegments() const {
+    return (size_ + ChunkSize - 1) / ChunkSize;
+  }
+
+  // Returns the elements of the i-th chunk as a contiguous range.
+  PtrRange<T> Segment(std::size_t i) {
+    assert(i < NumSegments());
+    T* first = ElementPtr(i * ChunkSize);
+    return PtrRange<T>(first, first + SegmentSize(i));
+  }
+  PtrRange<const T> Segment(std::size_t i) const {
+    assert(i < NumSegments());
+    const T* first = ElementPtr(i * ChunkSize);
+    return PtrRange<const T>(first, first + SegmentSize(i));
+  }
+
+  // Returns a random-access range of all segments (see Segment()).
+  auto Segments() {
+    return TransformRange(IndexRange(0, static_cast<int>(NumSegments())),
+                          [this](int i) { return Segment(i); });
+  }
+  auto Segments() const {
+    return TransformRange(IndexRange(0, static_cast<int>(NumSegments())),
+                          [this](int i) { return Segment(i); });
+  }
+
+ private:
+  static constexpr bool kIsPowerOfTwo =
+      chunked_vector_detail::IsPowerOfTwo(ChunkSize);
+  static constexpr int kShift = chunked_vector_detail::Log2(ChunkSize);
+
+  // Uninitialized storage for one element.
+  struct alignas(T) Slot {
+    unsigned char bytes[sizeof(T)];
+  };
+
+  static std::size_t ChunkIndex(std::size_t i) {
+    if constexpr (kIsPowerOfTwo) {
+      return i >> kShift;
+    } else {
+      return i / ChunkSize;
+    }
+  }
+  static std::size_t OffsetInChunk(std::size_t i) {
+    if constexpr (kIsPowerOfTwo) {
+      return i & (ChunkSize - 1);
+    } else {
+      return i % ChunkSize;
+    }
+  }
+
+  std::size_t SegmentSize(std::size_t i) const {
+    return (i + 1 == NumSegments()) ? size_ - i * ChunkSize : ChunkSize;
+  }
+
+  Slot* SlotPtr(std::size_t i) const {
+    return &chunks_[ChunkIndex(i)][OffsetInChunk(i)];
+  }
+  T* ElementPtr(std::size_t i) const {
+    return std::launder(reinterpret_cast<T*>(SlotPtr(i)));
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> chunks_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_CHUNKED_VECTOR_H_
@@ -0,0 +1,179 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/chunked_vector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "genit/filter_iterator.h"
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(ChunkedVectorTest, PushBackAndIndex) {
+  ChunkedVector<int, 4> v;
+  EXPECT_TRUE(v.empty());
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_EQ(v.size(), 10);
+  EXPECT_EQ(v.capacity(), 12);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(v[i], i);
+  }
+  EXPECT_EQ(v.front(), 0);
+  EXPECT_EQ(v.back(), 9);
+}
+
+TEST(ChunkedVectorTest, StableAddresses) {
+  ChunkedVector<int, 8> v;
+  std::vector<const int*> addresses;
+  for (int i = 0; i < 100; ++i) {
+    v.push_back(i);
+    addresses.push_back(&v.back());
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(&v[i], addresses[i]);
+  }
+
+  // Moving the container keeps the elements in place.
+  ChunkedVector<int, 8> moved(std::move(v));
+  EXPECT_TRUE(v.empty());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(&moved[i], addresses[i]);
+  }
+}
+
+TEST(ChunkedVectorTest, IteratorsSurvivePushBack) {
+  ChunkedVector<int, 4> v;
+  v.push_back(1);
+  v.push_back(2);
+  auto it = v.begin();
+  auto squares = TransformRange(v, [](int i) { return i * i; });
+  for (int i = 3; i < 100; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(it[50], 51);
+  // The aliased range keeps the extent it had at creation.
+  EXPECT_THAT(squares, ElementsAre(1, 4));
+}
+
+TEST(ChunkedVectorTest, RandomAccessIterator) {
+  ChunkedVector<int, 4> v;
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+  using It = decltype(v.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_TRUE((std::is_same_v<decltype(*v.begin()), int&>));
+  const auto& cv = v;
+  EXPECT_TRUE((std::is_same_v<decltype(*cv.begin()), const int&>));
+
+  auto it = v.begin();
+  EXPECT_EQ(v.end() - it, 10);
+  it += 5;
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(it[3], 8);
+  it -= 2;
+  EXPECT_EQ(*it, 3);
+  EXPECT_TRUE(v.begin() < it);
+  EXPECT_EQ(*(--it), 2);
+  EXPECT_EQ(std::lower_bound(v.begin(), v.end(), 7) - v.begin(), 7);
+
+  // Mixed const / non-const comparisons.
+  ChunkedVector<int, 4>::const_iterator cit = v.begin();
+  EXPECT_TRUE(cit == v.begin());
+  EXPECT_EQ(v.end() - cit, 10);
+}
+
+TEST(ChunkedVectorTest, NonPowerOfTwoChunks) {
+  ChunkedVector<int, 3> v;
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_THAT(v, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+  EXPECT_EQ(v.NumSegments(), 4);
+  EXPECT_THAT(v.Segment(1), ElementsAre(3, 4, 5));
+  EXPECT_THAT(v.Segment(3), ElementsAre(9));
+}
+
+TEST(ChunkedVectorTest, Segments) {
+  ChunkedVector<int, 4> v;
+  EXPECT_TRUE(v.Segments().empty());
+  for (int i = 0; i < 10; ++i) {
+    v.push_back(i);
+  }
+  std::vector<int> sizes;
+  int sum = 0;
+  for (auto segment : v.Segments()) {
+    sizes.push_back(segment.size());
+    sum = std::accumulate(segment.begin(), segment.end(), sum);
+  }
+  EXPECT_THAT(sizes, ElementsAre(4, 4, 2));
+  EXPECT_EQ(sum, 45);
+
+  for (auto segment : v.Segments()) {
+    for (int& x : segment) {
+      x *= 2;
+    }
+  }
+  EXPECT_EQ(v[9], 18);
+}
+
+TEST(ChunkedVectorTest, ComposesWithAdapters) {
+  ChunkedVector<int, 2> v;
+  for (int i = 0; i < 7; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_THAT(FilterRange(v, [](int i) { return i % 2 == 0; }),
+              ElementsAre(0, 2, 4, 6));
+  EXPECT_THAT(ReverseRange(v), ElementsAre(6, 5, 4, 3, 2, 1, 0));
+}
+
+TEST(ChunkedVectorTest, NonTrivialElements) {
+  ChunkedVector<std::string, 2> v;
+  v.emplace_back("a");
+  v.emplace_back(3, 'b');
+  v.push_back("c");
+  EXPECT_THAT(v, ElementsAre("a", "bbb", "c"));
+
+  ChunkedVector<std::string, 2> copy(v);
+  v.pop_back();
+  EXPECT_THAT(v, ElementsAre("a", "bbb"));
+  EXPECT_THAT(copy, ElementsAre("a", "bbb", "c"));
+
+  copy = v;
+  EXPECT_THAT(copy, ElementsAre("a", "bbb"));
+
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.capacity(), 4);
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 0);
+}
+
+}  // namespace
+}  // namespace genit
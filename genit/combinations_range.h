@@ -0,0 +1,338 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides ranges over the K-element subsets of a range, in
+// lexicographic order of their positions (i0 < i1 < ... < iK-1):
+//
+//   std::vector<Link> links = ...;
+//   for (auto [a, b] : PairsRange(links)) {
+//     // Each unordered pair of distinct links, once.
+//   }
+//   for (auto [a, b, c] : CombinationsRange<3>(links)) { ... }
+//
+// The elements are tuples of references to the elements of the range. Only
+// the valid combinations are visited, instead of filtering the K-fold product
+// of the range (NestRanges + FilterRange).
+//
+// For random-access ranges, the range is random-access as well: a combination
+// is decoded from its index in O(K^2) arithmetic operations, independently of
+// the size of the range, so that the combinations can be split evenly, e.g.,
+// across threads (the number of combinations must fit in an int, like the
+// difference_type of all genit iterators):
+//
+//   const auto pairs = PairsRange(links);
+//   const int n = pairs.size();
+//   for (auto [a, b] : MakeIteratorRange(pairs.begin() + n * t / num_threads,
+//                                        pairs.begin() +
+//                                            n * (t + 1) / num_threads)) {
+//     ...
+//   }
+
+#ifndef GENIT_COMBINATIONS_RANGE_H_
+#define GENIT_COMBINATIONS_RANGE_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+
+namespace combinations_range_detail {
+
+struct BeginTag {};
+struct EndTag {};
+
+template <typename BaseIter>
+using CombinationsIterCategory = std::conditional_t<
+    std::is_convertible_v<
+        typename std::iterator_traits<BaseIter>::iterator_category,
+        std::random_access_iterator_tag>,
+    std::random_access_iterator_tag,
+    zip_iterator_detail::LeastPermissive<
+        std::forward_iterator_tag,
+        zip_iterator_detail::ReduceToStdIterCategory<
+            typename std::iterator_traits<BaseIter>::iterator_category>>>;
+
+// std::tuple<T, T, ...> with K elements.
+template <typename T, typename Seq>
+struct RepeatedTupleImpl;
+template <typename T, std::size_t... Is>
+struct RepeatedTupleImpl<T, std::index_sequence<Is...>> {
+  template <std::size_t>
+  using Repeat = T;
+  using type = std::tuple<Repeat<Is>...>;
+};
+template <typename T, int K>
+using RepeatedTuple =
+    typename RepeatedTupleImpl<T, std::make_index_sequence<K>>::type;
+
+// Returns the binomial coefficient C(n, k), or 0 if n < k.
+inline uint64_t Binomial(int64_t n, int k) {
+  if (n < k) {
+    return 0;
+  }
+  uint64_t result = 1;
+  for (int i = 1; i <= k; ++i) {
+    result = result * (n - k + i) / i;
+  }
+  return result;
+}
+
+// Returns the largest b <= max_b such that C(b, k) <= x. Requires
+// C(k - 1, k) = 0 <= x, i.e., the result is at least k - 1.
+inline int64_t LargestWithBinomialAtMost(uint64_t x, int k, int64_t max_b) {
+  if (k == 1) {
+    return std::min<int64_t>(x, max_b);
+  }
+  // Start from an estimate and correct the (small) rounding error: for k = 2,
+  // C(b, 2) = b (b - 1) / 2 is inverted exactly, and in general
+  // C(b, k) ~ (b - (k - 1) / 2)^k / k!.
+  int64_t b;
+  if (k == 2) {
+    b = static_cast<int64_t>((1 + std::sqrt(1 + 8.0 * x)) / 2);
+  } else {
+    double factorial = 1;
+    for (int i = 2; i <= k; ++i) {
+      factorial *= i;
+    }
+    b = static_cast<int64_t>(std::pow(x * factorial, 1.0 / k) +
+                             (k - 1) / 2.0);
+  }
+  b = std::max<int64_t>(k - 1, std::min(b, max_b));
+  while (b > k - 1 && Binomial(b, k) > x) {
+    --b;
+  }
+  while (b < max_b && Binomial(b + 1, k) <= x) {
+    ++b;
+  }
+  return b;
+}
+
+// Writes the positions of the rank-th (in lexicographic order) K-subset of
+// {0, ..., n - 1} to positions. Requires rank < C(n, K).
+//
+// The lexicographic order of subsets is the reverse colexicographic order of
+// their mirror images {n - 1 - i}. In colexicographic order, the largest
+// position b of the subset of rank x is the largest b with C(b, K) <= x, and
+// the other positions are decoded the same way from x - C(b, K).
+template <int K>
+void UnrankCombination(uint64_t rank, int64_t n,
+                       std::array<int64_t, K>& positions) {
+  uint64_t x = Binomial(n, K) - 1 - rank;
+  int64_t max_b = n - 1;
+  for (int k = K; k > 0; --k) {
+    const int64_t b = LargestWithBinomialAtMost(x, k, max_b);
+    x -= Binomial(b, k);
+    positions[K - k] = n - 1 - b;
+    max_b = b - 1;
+  }
+}
+
+}  // namespace combinations_range_detail
+
+// Iterates over the K-element subsets of a range. See CombinationsRange
+// below.
+template <typename BaseIter, int K>
+class CombinationsIterator
+    : public IteratorFacade<
+          CombinationsIterator<BaseIter, K>,
+          combinations_range_detail::RepeatedTuple<
+              typename std::iterator_traits<BaseIter>::reference, K>,
+          combinations_range_detail::CombinationsIterCategory<BaseIter>> {
+ public:
+  static_assert(K > 0, "Number of elements must be greater than zero!");
+  static_assert(std::is_convertible_v<typename std::iterator_traits<
+                                          BaseIter>::iterator_category,
+                                      std::forward_iterator_tag>,
+                "CombinationsIterator requires a forward iterator.");
+
+  using Reference = combinations_range_detail::RepeatedTuple<
+      typename std::iterator_traits<BaseIter>::reference, K>;
+
+  CombinationsIterator() = default;
+  CombinationsIterator(combinations_range_detail::BeginTag, BaseIter first,
+                       BaseIter last)
+      : first_(first), last_(last) {
+    its_[0] = first;
+    for (int i = 1; i < K; ++i) {
+      if (its_[i - 1] == last_) {
+        SetToEnd();
+        return;
+      }
+      its_[i] = std::next(its_[i - 1]);
+    }
+    if (its_[K - 1] == last_) {
+      SetToEnd();
+    }
+  }
+  CombinationsIterator(combinations_range_detail::EndTag, BaseIter first,
+                       BaseIter last)
+      : first_(first), last_(last) {
+    SetToEnd();
+  }
+
+  // Returns the index of the current combination in the range. For
+  // non-random-access ranges, only valid for iterators incremented from
+  // begin().
+  int index() const { return index_; }
+
+ private:
+  friend class IteratorFacadePrivateAccess<CombinationsIterator>;
+
+  static constexpr bool kIsRandomAccess = std::is_same_v<
+      combinations_range_detail::CombinationsIterCategory<BaseIter>,
+      std::random_access_iterator_tag>;
+
+  void SetToEnd() {
+    its_.fill(last_);
+    if constexpr (kIsRandomAccess) {
+      index_ = combinations_range_detail::Binomial(last_ - first_, K);
+    }
+  }
+
+  template <std::size_t... Is>
+  Reference Dereference(std::index_sequence<Is...>) const {
+    return Reference(*its_[Is]...);
+  }
+  Reference Dereference() const {
+    return Dereference(std::make_index_sequence<K>());
+  }
+
+  void Increment() {
+    ++index_;
+    // Advance the last position that can move, and put the following ones
+    // right after it.
+    for (int i = K - 1; i >= 0; --i) {
+      if constexpr (kIsRandomAccess) {
+        if (last_ - its_[i] > K - i) {
+          ++its_[i];
+          for (int j = i + 1; j < K; ++j) {
+            its_[j] = its_[j - 1] + 1;
+          }
+          return;
+        }
+      } else {
+        BaseIter it = std::next(its_[i]);
+        int j = i;
+        for (; j < K && it != last_; ++j, ++it) {
+          its_[j] = it;
+        }
+        if (j == K) {
+          return;
+        }
+      }
+    }
+    SetToEnd();
+  }
+
+  bool IsEqual(const CombinationsIterator& rhs) const {
+    if constexpr (kIsRandomAccess) {
+      return index_ == rhs.index_;
+    } else {
+      // The last positions differ first.
+      for (int i = K - 1; i >= 0; --i) {
+        if (its_[i] != rhs.its_[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  // Random-access only.
+  void Decrement() { Advance(-1); }
+  int DistanceTo(const CombinationsIterator& rhs) const {
+    return rhs.index_ - index_;
+  }
+  void Advance(int n) {
+    index_ += n;
+    const int64_t size = last_ - first_;
+    if (static_cast<uint64_t>(index_) ==
+        combinations_range_detail::Binomial(size, K)) {
+      SetToEnd();
+      return;
+    }
+    std::array<int64_t, K> positions;
+    combinations_range_detail::UnrankCombination<K>(index_, size, positions);
+    for (int i = 0; i < K; ++i) {
+      its_[i] = first_ + positions[i];
+    }
+  }
+
+  std::array<BaseIter, K> its_ = {};
+  BaseIter first_ = {};
+  BaseIter last_ = {};
+  // Index of the current combination.
+  int index_ = 0;
+};
+
+// CombinationsRangeT wraps a range and iterates over its K-element subsets.
+template <typename BaseRange, int K>
+class CombinationsRangeT
+    : public AliasRangeFacade<
+          CombinationsRangeT<BaseRange, K>, BaseRange,
+          CombinationsIterator<RangeIteratorType<BaseRange>, K>> {
+ public:
+  using CombIter = CombinationsIterator<RangeIteratorType<BaseRange>, K>;
+  using AliasRangeFacade<CombinationsRangeT<BaseRange, K>, BaseRange,
+                         CombIter>::AliasRangeFacade;
+
+ private:
+  friend class AliasRangeFacadePrivateAccess<CombinationsRangeT<BaseRange, K>>;
+
+  auto Begin(const BaseRange& base_range) const {
+    using std::begin;
+    using std::end;
+    return CombIter(combinations_range_detail::BeginTag(), begin(base_range),
+                    end(base_range));
+  }
+  auto End(const BaseRange& base_range) const {
+    using std::begin;
+    using std::end;
+    return CombIter(combinations_range_detail::EndTag(), begin(base_range),
+                    end(base_range));
+  }
+};
+
+// Returns a range over the K-element subsets of a range, as tuples of K
+// references, in lexicographic order of positions. Random-access if the range
+// is random-access, and forward otherwise.
+template <int K, typename Range>
+auto CombinationsRange(Range&& range) {
+  return CombinationsRangeT<
+      decltype(MoveOrAliasRange(std::forward<Range>(range))), K>(
+      MoveOrAliasRange(std::forward<Range>(range)));
+}
+
+// Returns a range over the pairs of elements (x_i, x_j) with i < j of a range,
+// i.e., CombinationsRange<2>(range).
+template <typename Range>
+auto PairsRange(Range&& range) {
+  return CombinationsRange<2>(std::forward<Range>(range));
+}
+
+}  // namespace genit
+
+#endif  // GENIT_COMBINATIONS_RANGE_H_
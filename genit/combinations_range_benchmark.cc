@@ -0,0 +1,144 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares visiting all pairs (i < j) and triples of a vector with
+// PairsRange / CombinationsRange, hand-written nested loops, and filtering
+// NestRanges of indices. Also measures decoding a pair or a triple from its
+// index (as done to shard the combinations across threads).
+
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/combinations_range.h"
+#include "genit/filter_iterator.h"
+#include "genit/iterator_range.h"
+#include "genit/nested_range.h"
+
+namespace genit {
+namespace {
+
+std::vector<float> MakeValues(int n) {
+  std::vector<float> values(n);
+  for (int i = 0; i < n; ++i) {
+    values[i] = (i * 37) % 101;
+  }
+  return values;
+}
+
+// Stand-in for a cheap pairwise test, e.g., a bounding sphere overlap.
+inline int Overlaps(float a, float b) { return a - b < 10 && b - a < 10; }
+
+void BM_PairsRange(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  for (auto _ : state) {
+    int count = 0;
+    for (auto [a, b] : PairsRange(values)) {
+      count += Overlaps(a, b);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size() *
+                          (values.size() - 1) / 2);
+}
+
+void BM_PairsNestedLoops(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const int n = values.size();
+  for (auto _ : state) {
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        count += Overlaps(values[i], values[j]);
+      }
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size() *
+                          (values.size() - 1) / 2);
+}
+
+void BM_PairsFilteredNest(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const int n = values.size();
+  for (auto _ : state) {
+    int count = 0;
+    for (auto [i, j] : FilterRange(NestRanges(IndexRange(0, n),
+                                              IndexRange(0, n)),
+                                   [](const auto& ij) {
+                                     return std::get<0>(ij) < std::get<1>(ij);
+                                   })) {
+      count += Overlaps(values[i], values[j]);
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size() *
+                          (values.size() - 1) / 2);
+}
+
+void BM_TriplesRange(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  for (auto _ : state) {
+    float sum = 0;
+    for (auto [a, b, c] : CombinationsRange<3>(values)) {
+      sum += a * b - c;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  const auto n = values.size();
+  state.SetItemsProcessed(state.iterations() * n * (n - 1) * (n - 2) / 6);
+}
+
+void BM_TriplesNestedLoops(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const int n = values.size();
+  for (auto _ : state) {
+    float sum = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        for (int k = j + 1; k < n; ++k) {
+          sum += values[i] * values[j] - values[k];
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  const auto n_items = values.size();
+  state.SetItemsProcessed(state.iterations() * n_items * (n_items - 1) *
+                          (n_items - 2) / 6);
+}
+
+template <int K>
+void BM_Unrank(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const auto range = CombinationsRange<K>(values);
+  const int size = range.size();
+  int index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(range.begin() + index);
+    index = (index + 7919) % size;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PairsRange)->Range(16, 1024);
+BENCHMARK(BM_PairsNestedLoops)->Range(16, 1024);
+BENCHMARK(BM_PairsFilteredNest)->Range(16, 1024);
+BENCHMARK(BM_TriplesRange)->Range(16, 256);
+BENCHMARK(BM_TriplesNestedLoops)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Unrank, 2)->Arg(1024)->Arg(30000);
+BENCHMARK_TEMPLATE(BM_Unrank, 3)->Arg(256)->Arg(1000);
+
+}  // namespace
+}  // namespace genit
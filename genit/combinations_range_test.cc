@@ -0,0 +1,185 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/combinations_range.h"
+
+#include <array>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(CombinationsRangeTest, Pairs) {
+  const std::vector<int> v = {1, 2, 3, 4};
+  EXPECT_THAT(PairsRange(v),
+              ElementsAre(std::make_tuple(1, 2), std::make_tuple(1, 3),
+                          std::make_tuple(1, 4), std::make_tuple(2, 3),
+                          std::make_tuple(2, 4), std::make_tuple(3, 4)));
+}
+
+TEST(CombinationsRangeTest, Triples) {
+  const std::vector<int> v = {1, 2, 3, 4};
+  EXPECT_THAT(CombinationsRange<3>(v),
+              ElementsAre(std::make_tuple(1, 2, 3), std::make_tuple(1, 2, 4),
+                          std::make_tuple(1, 3, 4), std::make_tuple(2, 3, 4)));
+}
+
+TEST(CombinationsRangeTest, SmallRanges) {
+  const std::vector<int> empty;
+  const std::vector<int> one = {1};
+  EXPECT_THAT(PairsRange(empty), IsEmpty());
+  EXPECT_THAT(PairsRange(one), IsEmpty());
+  EXPECT_THAT(CombinationsRange<3>(std::vector<int>{1, 2}), IsEmpty());
+  EXPECT_THAT(CombinationsRange<1>(one), ElementsAre(std::make_tuple(1)));
+  EXPECT_THAT(CombinationsRange<2>(std::vector<int>{1, 2}),
+              ElementsAre(std::make_tuple(1, 2)));
+}
+
+TEST(CombinationsRangeTest, ReferencesElements) {
+  std::vector<int> v = {1, 2, 3};
+  for (auto [a, b] : PairsRange(v)) {
+    a += 10;
+    b += 1;
+  }
+  // v[0] is the first element twice, v[2] the second element twice.
+  EXPECT_THAT(v, ElementsAre(21, 13, 5));
+}
+
+TEST(CombinationsRangeTest, ForwardRange) {
+  const std::forward_list<int> l = {1, 2, 3, 4, 5};
+  const auto triples = CombinationsRange<3>(l);
+  using It = decltype(triples.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::forward_iterator_tag>));
+  std::vector<std::tuple<int, int, int>> expected;
+  for (int i = 1; i <= 5; ++i) {
+    for (int j = i + 1; j <= 5; ++j) {
+      for (int k = j + 1; k <= 5; ++k) {
+        expected.emplace_back(i, j, k);
+      }
+    }
+  }
+  const std::vector<std::tuple<int, int, int>> actual(triples.begin(),
+                                                      triples.end());
+  EXPECT_EQ(actual, expected);
+  int index = 0;
+  for (auto it = triples.begin(); it != triples.end(); ++it, ++index) {
+    EXPECT_EQ(it.index(), index);
+  }
+}
+
+TEST(CombinationsRangeTest, BidirectionalRangeIsForward) {
+  const std::list<int> l = {1, 2, 3};
+  const auto pairs = PairsRange(l);
+  using It = decltype(pairs.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::forward_iterator_tag>));
+  EXPECT_EQ(pairs.size(), 3);
+}
+
+template <int K>
+void ExpectRandomAccessMatchesIncrement(int n) {
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i) {
+    v[i] = i;
+  }
+  const auto range = CombinationsRange<K>(v);
+  using It = decltype(range.begin());
+  EXPECT_TRUE(
+      (std::is_same_v<typename std::iterator_traits<It>::iterator_category,
+                      std::random_access_iterator_tag>));
+  const std::vector<typename It::value_type> expected(range.begin(),
+                                                      range.end());
+  ASSERT_EQ(range.size(), expected.size());
+  for (int i = 0; i < static_cast<int>(expected.size()); ++i) {
+    ASSERT_EQ(range[i], expected[i]) << n << " " << i;
+    ASSERT_EQ((range.begin() + i).index(), i);
+    ASSERT_EQ(range.end() - (range.begin() + i),
+              static_cast<int>(expected.size()) - i);
+  }
+  if (!expected.empty()) {
+    EXPECT_EQ(*std::prev(range.end()), expected.back());
+  }
+}
+
+TEST(CombinationsRangeTest, RandomAccessMatchesIncrement) {
+  for (int n = 0; n < 25; ++n) {
+    ExpectRandomAccessMatchesIncrement<1>(n);
+    ExpectRandomAccessMatchesIncrement<2>(n);
+    ExpectRandomAccessMatchesIncrement<3>(n);
+    ExpectRandomAccessMatchesIncrement<4>(n);
+  }
+}
+
+TEST(CombinationsRangeTest, UnranksLargeRanges) {
+  std::vector<int> v(20000);
+  for (int i = 0; i < static_cast<int>(v.size()); ++i) {
+    v[i] = i;
+  }
+  const auto pairs = PairsRange(v);
+  ASSERT_EQ(pairs.size(), 20000 * 19999 / 2);
+  EXPECT_EQ(pairs[19998], std::make_tuple(0, 19999));
+  EXPECT_EQ(pairs[19999], std::make_tuple(1, 2));
+  EXPECT_EQ(pairs[pairs.size() - 1], std::make_tuple(19998, 19999));
+  const auto triples = CombinationsRange<3>(
+      MakeIteratorRange(v.begin(), v.begin() + 1000));
+  ASSERT_EQ(triples.size(), 166167000);
+  EXPECT_EQ(triples[0], std::make_tuple(0, 1, 2));
+  EXPECT_EQ(triples[997], std::make_tuple(0, 1, 999));
+  EXPECT_EQ(triples[998], std::make_tuple(0, 2, 3));
+  EXPECT_EQ(triples[166167000 - 1], std::make_tuple(997, 998, 999));
+  EXPECT_EQ(triples[166167000 - 2], std::make_tuple(996, 998, 999));
+}
+
+TEST(CombinationsRangeTest, SplitsEvenly) {
+  const std::vector<int> v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  const auto pairs = PairsRange(v);
+  const int n = pairs.size();
+  constexpr int kNumParts = 4;
+  std::vector<std::tuple<int, int>> all;
+  for (int part = 0; part < kNumParts; ++part) {
+    const auto shard = MakeIteratorRange(
+        pairs.begin() + n * part / kNumParts,
+        pairs.begin() + n * (part + 1) / kNumParts);
+    EXPECT_NEAR(shard.size(), double(n) / kNumParts, 1.0);
+    all.insert(all.end(), shard.begin(), shard.end());
+  }
+  const std::vector<std::tuple<int, int>> expected(pairs.begin(),
+                                                   pairs.end());
+  EXPECT_EQ(all, expected);
+}
+
+TEST(CombinationsRangeTest, UnrankCombination) {
+  std::array<int64_t, 2> positions;
+  combinations_range_detail::UnrankCombination<2>(3, 4, positions);
+  EXPECT_THAT(positions, ElementsAre(1, 2));
+  combinations_range_detail::UnrankCombination<2>(0, 4, positions);
+  EXPECT_THAT(positions, ElementsAre(0, 1));
+  combinations_range_detail::UnrankCombination<2>(5, 4, positions);
+  EXPECT_THAT(positions, ElementsAre(2, 3));
+}
+
+}  // namespace
+}  // namespace genit
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <tuple>
 #include <type_traits>
@@ -28,6 +29,7 @@
 #include "absl/types/variant.h"
 #include "absl/utility/utility.h"
 #include "genit/iterator_facade.h"
+#include "genit/iterator_position.h"
 #include "genit/iterator_range.h"
 #include "genit/zip_iterator.h"
 
@@ -46,6 +48,19 @@ namespace genit {
 //   ...
 // }
 //
+// If all ranges have the same iterator type (e.g., several std::vector<Point>
+// or PtrRange<float> pieces), the iterator stores a single base iterator and a
+// segment index, and looks up the segment bounds in a table. Dereferencing is
+// then a plain dereference of the base iterator, and incrementing has a single
+// (predictable) branch for the segment boundary. Otherwise, the iterator
+// stores a std::variant of the base iterators. Ranges with the same iterator
+// types are also reversed natively (see ReverseRange), without the overhead
+// of std::reverse_iterator.
+//
+// The position of a concatenation iterator (see iterator_position.h) is the
+// index of its segment and its position in the segment, so it is restored
+// without scanning the preceding segments.
+//
 
 namespace concat_range_detail {
 template <bool... Ts>
@@ -80,6 +95,11 @@ using CommonReferenceType = std::conditional_t<
         // Use T.
         CommonValueType<Ranges...>>>;
 
+// The iterator type of the first range.
+template <typename... Ranges>
+using FirstIteratorType =
+    std::tuple_element_t<0, std::tuple<RangeIteratorType<Ranges>...>>;
+
 struct BeginTag {};
 struct EndTag {};
 
@@ -104,38 +124,69 @@ class ConcatRange {
   static_assert(sizeof...(Ranges) > 0,
                 "ConcatRange requires at least one range");
 
+  using IterCategory =
+      zip_iterator_detail::ComputeIterCategory<RangeIteratorType<Ranges>...>;
+  static constexpr bool kIsRandomAccess =
+      std::is_same_v<IterCategory, std::random_access_iterator_tag>;
+  static constexpr bool kHasSameIterators =
+      concat_range_detail::are_same_v<RangeIteratorType<Ranges>...>;
+
  public:
   template <typename... OtherRanges>
   explicit ConcatRange(OtherRanges&&... ranges)
       : ranges_(std::forward<OtherRanges>(ranges)...) {
-    SetAccumulatedSizes(
-        typename std::iterator_traits<ConcatIterator>::iterator_category{},
-        IndexSeq{});
+    SetAccumulatedSizes(IterCategory{}, IndexSeq{});
+    SetSegments(IndexSeq{});
   }
 
-  // Allows iterating over a ConcatRange.
-  class ConcatIterator
+  // The segment table refers to ranges_, so it needs to be rebuilt on copy and
+  // move.
+  ConcatRange(const ConcatRange& other)
+      : ranges_(other.ranges_), accumulated_sizes_(other.accumulated_sizes_) {
+    SetSegments(IndexSeq{});
+  }
+  ConcatRange(ConcatRange&& other)
+      : ranges_(std::move(other.ranges_)),
+        accumulated_sizes_(std::move(other.accumulated_sizes_)) {
+    SetSegments(IndexSeq{});
+  }
+  ConcatRange& operator=(const ConcatRange& other) {
+    ranges_ = other.ranges_;
+    accumulated_sizes_ = other.accumulated_sizes_;
+    SetSegments(IndexSeq{});
+    return *this;
+  }
+  ConcatRange& operator=(ConcatRange&& other) {
+    ranges_ = std::move(other.ranges_);
+    accumulated_sizes_ = std::move(other.accumulated_sizes_);
+    SetSegments(IndexSeq{});
+    return *this;
+  }
+
+  // Allows iterating over a ConcatRange with base iterators of different
+  // types.
+  class VariantConcatIterator
       : public IteratorFacade<
-            ConcatIterator, concat_range_detail::CommonReferenceType<Ranges...>,
-            zip_iterator_detail::ComputeIterCategory<
-                RangeIteratorType<Ranges>...>> {
+            VariantConcatIterator,
+            concat_range_detail::CommonReferenceType<Ranges...>,
+            IterCategory> {
    public:
-    ConcatIterator(concat_range_detail::BeginTag,
-                   const ConcatRange<Ranges...>* range)
+    VariantConcatIterator(concat_range_detail::BeginTag,
+                          const ConcatRange<Ranges...>* range)
         : concat_(range), it_(absl::in_place_index<0>, BeginOf<0>()) {
       // Skip empty ranges and find a valid begin.
       if (concat_range_detail::RangeIsEmpty(std::get<0>(concat_->ranges_))) {
         Increment();
       }
     }
-    ConcatIterator(concat_range_detail::EndTag,
-                   const ConcatRange<Ranges...>* range)
+    VariantConcatIterator(concat_range_detail::EndTag,
+                          const ConcatRange<Ranges...>* range)
         : concat_(range),
           it_(absl::in_place_index<kNumberOfRanges - 1>,
               EndOf<kNumberOfRanges - 1>()) {}
 
    private:
-    friend class IteratorFacadePrivateAccess<ConcatIterator>;
+    friend class IteratorFacadePrivateAccess<VariantConcatIterator>;
 
     static constexpr size_t kNumberOfRanges = sizeof...(Ranges);
     using IndexSeq = absl::make_index_sequence<kNumberOfRanges>;
@@ -159,12 +210,9 @@ class ConcatRange {
     }
     template <size_t... Ids>
     int IndexOfIterator(absl::index_sequence<Ids...> ids) const {
-      static_assert(
-          std::is_same_v<
-              typename std::iterator_traits<ConcatIterator>::iterator_category,
-              std::random_access_iterator_tag>,
-          "This function should only be instantiated for random access "
-          "iterators.");
+      static_assert(kIsRandomAccess,
+                    "This function should only be instantiated for random "
+                    "access iterators.");
       int index = 0;
       const int variant_index = it_.index();
       (void)((Ids == variant_index && (index = IndexOfIterator<Ids>(), true)) ||
@@ -242,6 +290,69 @@ class ConcatRange {
              ...);
     }
 
+    // Appends the segment and the position in the segment.
+    template <size_t Id>
+    bool AppendSegmentPosition(IteratorPosition* position) const {
+      AppendPosition(std::get<Id>(concat_->ranges_), std::get<Id>(it_),
+                     position);
+      return true;
+    }
+    template <size_t... Ids>
+    void AppendSegmentPosition(absl::index_sequence<Ids...>,
+                               IteratorPosition* position) const {
+      const int variant_index = it_.index();
+      position->Append(variant_index);
+      (void)((Ids == variant_index && AppendSegmentPosition<Ids>(position)) ||
+             ...);
+    }
+
+    // Reads the position in the given segment, and skips to the next
+    // non-empty segment at its end, like Increment.
+    template <size_t Id>
+    bool ReadSegmentPosition(IteratorPositionReader* reader) {
+      std::variant_alternative_t<Id, VariantIt> it = EndOf<Id>();
+      if (!ReadPosition(std::get<Id>(concat_->ranges_), reader, &it)) {
+        return false;
+      }
+      it_ = VariantIt(absl::in_place_index<Id>, std::move(it));
+      if constexpr (Id + 1 < kNumberOfRanges) {
+        if (std::get<Id>(it_) == EndOf<Id>()) {
+          Increment();
+        }
+      }
+      return true;
+    }
+    template <size_t... Ids>
+    bool ReadSegmentPosition(absl::index_sequence<Ids...>, int segment,
+                             IteratorPositionReader* reader) {
+      bool ok = false;
+      (void)((Ids == segment &&
+              (ok = ReadSegmentPosition<Ids>(reader), true)) ||
+             ...);
+      return ok;
+    }
+
+    // See iterator_position.h.
+    friend void AppendNativePosition(const VariantConcatIterator& it,
+                                     IteratorPosition* position) {
+      it.AppendSegmentPosition(IndexSeq(), position);
+    }
+    friend bool ReadNativePosition(const VariantConcatIterator& last,
+                                   IteratorPositionReader* reader,
+                                   VariantConcatIterator* it) {
+      int64_t segment;
+      if (!reader->Read(&segment) || segment < 0 ||
+          segment >= static_cast<int64_t>(kNumberOfRanges)) {
+        return false;
+      }
+      VariantConcatIterator restored = last;
+      if (!restored.ReadSegmentPosition(IndexSeq(), segment, reader)) {
+        return false;
+      }
+      *it = std::move(restored);
+      return true;
+    }
+
     using OutputRefType = concat_range_detail::CommonReferenceType<Ranges...>;
     OutputRefType Dereference() const {
       return std::visit([](const auto& it) -> OutputRefType { return *it; },
@@ -250,8 +361,10 @@ class ConcatRange {
 
     void Increment() { Increment(IndexSeq()); }
     void Decrement() { Decrement(IndexSeq()); }
-    bool IsEqual(const ConcatIterator& rhs) const { return it_ == rhs.it_; }
-    int DistanceTo(const ConcatIterator& rhs) const {
+    bool IsEqual(const VariantConcatIterator& rhs) const {
+      return it_ == rhs.it_;
+    }
+    int DistanceTo(const VariantConcatIterator& rhs) const {
       // Assumes that both iterators refer to the same range.
       const int index_lhs = IndexOfIterator(IndexSeq());
       const int index_rhs = rhs.IndexOfIterator(IndexSeq());
@@ -267,7 +380,235 @@ class ConcatRange {
     using VariantIt = std::variant<RangeIteratorType<Ranges>...>;
     VariantIt it_;
   };
-  friend class ConcatIterator;
+  friend class VariantConcatIterator;
+
+  class ReverseSegmentConcatIterator;
+
+  // Allows iterating over a ConcatRange whose ranges all have the same
+  // iterator type. Stores a single base iterator and the index of its segment,
+  // and looks up the bounds of the segments in the parent range.
+  class SegmentConcatIterator
+      : public IteratorFacade<
+            SegmentConcatIterator,
+            typename std::iterator_traits<
+                concat_range_detail::FirstIteratorType<Ranges...>>::reference,
+            IterCategory> {
+   public:
+    SegmentConcatIterator(concat_range_detail::BeginTag,
+                          const ConcatRange<Ranges...>* range)
+        : concat_(range), segment_(0), it_(Begins()[0]) {
+      SkipEmptySegments();
+    }
+    SegmentConcatIterator(concat_range_detail::EndTag,
+                          const ConcatRange<Ranges...>* range)
+        : concat_(range),
+          segment_(kNumberOfRanges - 1),
+          it_(Ends()[kNumberOfRanges - 1]) {}
+
+   private:
+    friend class IteratorFacadePrivateAccess<SegmentConcatIterator>;
+
+    static constexpr int kNumberOfRanges = sizeof...(Ranges);
+
+    const auto& Begins() const { return concat_->segment_begins_; }
+    const auto& Ends() const { return concat_->segment_ends_; }
+
+    // Moves past the end of the current segment to the beginning of the next
+    // non-empty segment, or to the end of the last segment.
+    void SkipEmptySegments() {
+      while (it_ == Ends()[segment_] && segment_ + 1 < kNumberOfRanges) {
+        ++segment_;
+        it_ = Begins()[segment_];
+      }
+    }
+
+    // Calculates the offset of it_ in the concatenated range.
+    int Index() const {
+      return concat_->accumulated_sizes_[segment_] - (Ends()[segment_] - it_);
+    }
+
+    // Sets the iterator to point to a desired index.
+    void SetToIndex(int index) {
+      const auto& sizes = concat_->accumulated_sizes_;
+      const auto it = std::upper_bound(sizes.cbegin(), sizes.cend(), index);
+      segment_ = std::min<int>(kNumberOfRanges - 1, it - sizes.cbegin());
+      it_ = Ends()[segment_] - (sizes[segment_] - index);
+    }
+
+    using OutputRefType = typename std::iterator_traits<
+        concat_range_detail::FirstIteratorType<Ranges...>>::reference;
+    OutputRefType Dereference() const { return *it_; }
+    void Increment() {
+      ++it_;
+      if (it_ == Ends()[segment_]) {
+        SkipEmptySegments();
+      }
+    }
+    void Decrement() {
+      while (it_ == Begins()[segment_]) {
+        --segment_;
+        it_ = Ends()[segment_];
+      }
+      --it_;
+    }
+    bool IsEqual(const SegmentConcatIterator& rhs) const {
+      return segment_ == rhs.segment_ && it_ == rhs.it_;
+    }
+    int DistanceTo(const SegmentConcatIterator& rhs) const {
+      // Assumes that both iterators refer to the same range.
+      return rhs.Index() - Index();
+    }
+    void Advance(int n) {
+      // Stay within the current segment if possible.
+      if (n >= 0 ? n < Ends()[segment_] - it_
+                 : -n <= it_ - Begins()[segment_]) {
+        it_ += n;
+        if (it_ == Ends()[segment_]) {
+          SkipEmptySegments();
+        }
+      } else {
+        SetToIndex(Index() + n);
+      }
+    }
+
+    // The segment and the position in the segment, see iterator_position.h.
+    friend void AppendNativePosition(const SegmentConcatIterator& it,
+                                     IteratorPosition* position) {
+      const int segment = it.segment_;
+      position->Append(segment);
+      AppendPosition(
+          MakeIteratorRange(it.Begins()[segment], it.Ends()[segment]), it.it_,
+          position);
+    }
+    friend bool ReadNativePosition(const SegmentConcatIterator& last,
+                                   IteratorPositionReader* reader,
+                                   SegmentConcatIterator* it) {
+      int64_t segment;
+      if (!reader->Read(&segment) || segment < 0 ||
+          segment >= kNumberOfRanges) {
+        return false;
+      }
+      auto base = last.Ends()[segment];
+      if (!ReadPosition(
+              MakeIteratorRange(last.Begins()[segment], last.Ends()[segment]),
+              reader, &base)) {
+        return false;
+      }
+      *it = last;
+      it->segment_ = static_cast<int>(segment);
+      it->it_ = std::move(base);
+      it->SkipEmptySegments();
+      return true;
+    }
+
+    // Iterates backwards over the segments, see MakeReverseIterator.
+    friend ReverseSegmentConcatIterator MakeNativeReverseIterator(
+        const SegmentConcatIterator& it,
+        const SegmentConcatIterator& /*first*/) {
+      return ReverseSegmentConcatIterator(it.concat_, it.segment_, it.it_);
+    }
+
+    const ConcatRange<Ranges...>* concat_;
+    int segment_;
+    concat_range_detail::FirstIteratorType<Ranges...> it_;
+  };
+  friend class SegmentConcatIterator;
+
+  // Iterates backwards over a ConcatRange whose ranges all have the same
+  // iterator type. Like SegmentConcatIterator, but stores a
+  // std::reverse_iterator of the base iterator, and visits the segments in
+  // reverse order.
+  class ReverseSegmentConcatIterator
+      : public IteratorFacade<
+            ReverseSegmentConcatIterator,
+            typename std::iterator_traits<
+                concat_range_detail::FirstIteratorType<Ranges...>>::reference,
+            IterCategory> {
+   public:
+    using BaseIter = concat_range_detail::FirstIteratorType<Ranges...>;
+    using BaseRevIter = std::reverse_iterator<BaseIter>;
+
+    // Constructs the reverse iterator referring to the element before 'it' in
+    // the given segment.
+    ReverseSegmentConcatIterator(const ConcatRange<Ranges...>* range,
+                                 int segment, BaseIter it)
+        : concat_(range), segment_(segment), it_(std::move(it)) {
+      SkipEmptySegments();
+    }
+
+   private:
+    friend class IteratorFacadePrivateAccess<ReverseSegmentConcatIterator>;
+
+    const auto& Begins() const { return concat_->segment_begins_; }
+    const auto& Ends() const { return concat_->segment_ends_; }
+
+    // Moves past the beginning of the current segment to the end of the
+    // previous non-empty segment, or to the beginning of the first segment.
+    void SkipEmptySegments() {
+      while (it_.base() == Begins()[segment_] && segment_ > 0) {
+        --segment_;
+        it_ = BaseRevIter(Ends()[segment_]);
+      }
+    }
+
+    // Calculates the offset of it_.base() in the concatenated range.
+    int ForwardIndex() const {
+      return concat_->accumulated_sizes_[segment_] -
+             (Ends()[segment_] - it_.base());
+    }
+
+    // Sets the iterator to refer to the element before a forward index.
+    void SetToForwardIndex(int index) {
+      const auto& sizes = concat_->accumulated_sizes_;
+      const auto it = std::lower_bound(sizes.cbegin(), sizes.cend(), index);
+      segment_ = std::min<int>(sizeof...(Ranges) - 1, it - sizes.cbegin());
+      it_ = BaseRevIter(Ends()[segment_] - (sizes[segment_] - index));
+    }
+
+    using OutputRefType = typename std::iterator_traits<BaseIter>::reference;
+    OutputRefType Dereference() const { return *it_; }
+    void Increment() {
+      ++it_;
+      if (it_.base() == Begins()[segment_]) {
+        SkipEmptySegments();
+      }
+    }
+    void Decrement() {
+      while (it_.base() == Ends()[segment_]) {
+        ++segment_;
+        it_ = BaseRevIter(Begins()[segment_]);
+      }
+      --it_;
+    }
+    bool IsEqual(const ReverseSegmentConcatIterator& rhs) const {
+      return segment_ == rhs.segment_ && it_ == rhs.it_;
+    }
+    int DistanceTo(const ReverseSegmentConcatIterator& rhs) const {
+      // Assumes that both iterators refer to the same range.
+      return ForwardIndex() - rhs.ForwardIndex();
+    }
+    void Advance(int n) {
+      // Stay within the current segment if possible.
+      if (n >= 0 ? n < it_.base() - Begins()[segment_]
+                 : -n <= Ends()[segment_] - it_.base()) {
+        it_ += n;
+        if (it_.base() == Begins()[segment_]) {
+          SkipEmptySegments();
+        }
+      } else {
+        SetToForwardIndex(ForwardIndex() - n);
+      }
+    }
+
+    const ConcatRange<Ranges...>* concat_;
+    int segment_;
+    BaseRevIter it_;
+  };
+  friend class ReverseSegmentConcatIterator;
+
+  using ConcatIterator = std::conditional_t<kHasSameIterators,
+                                            SegmentConcatIterator,
+                                            VariantConcatIterator>;
 
   using iterator = ConcatIterator;
   using value_type = typename std::iterator_traits<ConcatIterator>::value_type;
@@ -283,6 +624,16 @@ class ConcatRange {
  private:
   using IndexSeq = absl::make_index_sequence<sizeof...(Ranges)>;
 
+  template <size_t... Ids>
+  void SetSegments(absl::index_sequence<Ids...>) {
+    if constexpr (kHasSameIterators) {
+      using std::begin;
+      using std::end;
+      segment_begins_ = {begin(std::get<Ids>(ranges_))...};
+      segment_ends_ = {end(std::get<Ids>(ranges_))...};
+    }
+  }
+
   template <typename Category, size_t... Ids>
   void SetAccumulatedSizes(Category, absl::index_sequence<Ids...> ids) {
     // No op.
@@ -299,13 +650,19 @@ class ConcatRange {
 
   struct None {};
   using AccumulatedSizes =
-      std::conditional_t<std::is_same_v<typename std::iterator_traits<
-                                            ConcatIterator>::iterator_category,
-                                        std::random_access_iterator_tag>,
-                         std::array<int, sizeof...(Ranges)>, None>;
+      std::conditional_t<kIsRandomAccess, std::array<int, sizeof...(Ranges)>,
+                         None>;
+  // The bounds of the ranges, if they all have the same iterator type.
+  using SegmentTable = std::conditional_t<
+      kHasSameIterators,
+      std::array<concat_range_detail::FirstIteratorType<Ranges...>,
+                 sizeof...(Ranges)>,
+      None>;
 
   std::tuple<Ranges...> ranges_;
   AccumulatedSizes accumulated_sizes_;
+  SegmentTable segment_begins_;
+  SegmentTable segment_ends_;
 };
 
 // Deduction guide
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares iterating over a ConcatRange of ranges with the same iterator type
+// with the segment-based iterator and with the variant-based iterator, for 2
+// to 16 segments.
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/utility/utility.h"
+#include "benchmark/benchmark.h"
+#include "genit/concat_range.h"
+#include "genit/iterator_range.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumElements = 1 << 16;
+
+std::vector<std::vector<float>> MakePieces(int num_pieces) {
+  std::vector<std::vector<float>> pieces(num_pieces);
+  for (int i = 0; i < kNumElements; ++i) {
+    pieces[i % num_pieces].push_back(i * 0.5f);
+  }
+  return pieces;
+}
+
+template <std::size_t... Ids>
+auto ConcatenatePieces(const std::vector<std::vector<float>>& pieces,
+                       absl::index_sequence<Ids...>) {
+  return ConcatenateRanges(pieces[Ids]...);
+}
+
+template <typename Range>
+auto VariantIterators(const Range& range) {
+  using Iter = typename Range::VariantConcatIterator;
+  return MakeIteratorRange(Iter(concat_range_detail::BeginTag{}, &range),
+                           Iter(concat_range_detail::EndTag{}, &range));
+}
+
+template <int NumSegments, bool UseVariant>
+void BM_Iterate(benchmark::State& state) {
+  const auto pieces = MakePieces(NumSegments);
+  const auto range =
+      ConcatenatePieces(pieces, absl::make_index_sequence<NumSegments>());
+  for (auto _ : state) {
+    float sum = 0.0f;
+    if constexpr (UseVariant) {
+      for (float x : VariantIterators(range)) {
+        sum += x;
+      }
+    } else {
+      for (float x : range) {
+        sum += x;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumElements);
+}
+
+template <int NumSegments, bool UseVariant>
+void BM_RandomAccess(benchmark::State& state) {
+  const auto pieces = MakePieces(NumSegments);
+  const auto range =
+      ConcatenatePieces(pieces, absl::make_index_sequence<NumSegments>());
+  for (auto _ : state) {
+    float sum = 0.0f;
+    auto run = [&sum](auto first) {
+      for (int i = 0; i < kNumElements; i += 97) {
+        sum += first[i];
+      }
+    };
+    if constexpr (UseVariant) {
+      run(VariantIterators(range).begin());
+    } else {
+      run(range.begin());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * (kNumElements / 97 + 1));
+}
+
+BENCHMARK_TEMPLATE(BM_Iterate, 2, false);
+BENCHMARK_TEMPLATE(BM_Iterate, 2, true);
+BENCHMARK_TEMPLATE(BM_Iterate, 4, false);
+BENCHMARK_TEMPLATE(BM_Iterate, 4, true);
+BENCHMARK_TEMPLATE(BM_Iterate, 8, false);
+BENCHMARK_TEMPLATE(BM_Iterate, 8, true);
+BENCHMARK_TEMPLATE(BM_Iterate, 16, false);
+BENCHMARK_TEMPLATE(BM_Iterate, 16, true);
+
+BENCHMARK_TEMPLATE(BM_RandomAccess, 2, false);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 2, true);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 4, false);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 4, true);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 8, false);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 8, true);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 16, false);
+BENCHMARK_TEMPLATE(BM_RandomAccess, 16, true);
+
+}  // namespace
+}  // namespace genit
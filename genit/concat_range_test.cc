@@ -307,5 +307,76 @@ TEST(ConcatRange, IteratorTag) {
   ExpectIteratorCategory(forward_range, std::forward_iterator_tag{});
 }
 
+TEST(ConcatRange, SameIteratorTypesUseSegments) {
+  std::vector<int> v1 = {1, 2, 3};
+  std::vector<int> v2 = {4, 5};
+  std::list<int> l = {6};
+  const auto same = ConcatenateRanges(v1, v2);
+  using SameRange = std::decay_t<decltype(same)>;
+  EXPECT_TRUE((std::is_same_v<SameRange::iterator,
+                              SameRange::SegmentConcatIterator>));
+  const auto mixed = ConcatenateRanges(v1, l);
+  using MixedRange = std::decay_t<decltype(mixed)>;
+  EXPECT_TRUE((std::is_same_v<MixedRange::iterator,
+                              MixedRange::VariantConcatIterator>));
+}
+
+TEST(ConcatRange, SameIteratorTypesRandomAccess) {
+  std::vector<int> v1 = {0, 1, 2};
+  std::vector<int> empty;
+  std::vector<int> v2 = {3, 4};
+  std::vector<int> v3 = {5, 6, 7, 8};
+  const auto range = ConcatenateRanges(empty, v1, empty, empty, v2, v3, empty);
+  EXPECT_THAT(range, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8));
+  EXPECT_EQ(range.end() - range.begin(), 9);
+  for (int i = 0; i <= 9; ++i) {
+    for (int j = 0; j <= 9; ++j) {
+      const auto it = range.begin() + i;
+      EXPECT_EQ(it + (j - i), range.begin() + j) << i << " " << j;
+      EXPECT_EQ((range.begin() + j) - it, j - i) << i << " " << j;
+      if (j < 9) {
+        EXPECT_EQ(it[j - i], j);
+      }
+    }
+  }
+  std::vector<int> reversed(std::make_reverse_iterator(range.end()),
+                            std::make_reverse_iterator(range.begin()));
+  EXPECT_THAT(reversed, ElementsAre(8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+TEST(ConcatRange, SameIteratorTypesReverseRange) {
+  std::vector<int> v1 = {0, 1, 2};
+  std::vector<int> empty;
+  std::vector<int> v2 = {3, 4};
+  const auto range = ConcatenateRanges(empty, v1, empty, v2, empty);
+  const auto reversed = ReverseRange(range);
+  EXPECT_THAT(reversed, ElementsAre(4, 3, 2, 1, 0));
+  EXPECT_EQ(reversed.end() - reversed.begin(), 5);
+  for (int i = 0; i <= 5; ++i) {
+    for (int j = 0; j <= 5; ++j) {
+      const auto it = reversed.begin() + i;
+      EXPECT_EQ(it + (j - i), reversed.begin() + j) << i << " " << j;
+      EXPECT_EQ((reversed.begin() + j) - it, j - i) << i << " " << j;
+      if (j < 5) {
+        EXPECT_EQ(it[j - i], 4 - j);
+      }
+    }
+  }
+  std::vector<int> forward;
+  for (auto it = reversed.end(); it != reversed.begin();) {
+    forward.push_back(*--it);
+  }
+  EXPECT_THAT(forward, ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_TRUE(ReverseRange(ConcatenateRanges(empty, empty)).empty());
+}
+
+TEST(ConcatRange, SameIteratorTypesCopyOwnedRanges) {
+  auto range = ConcatenateRanges(std::vector<int>{1, 2}, std::vector<int>{3});
+  const auto copy = range;
+  const auto moved = std::move(range);
+  EXPECT_THAT(copy, ElementsAre(1, 2, 3));
+  EXPECT_THAT(moved, ElementsAre(1, 2, 3));
+}
+
 }  // namespace
 }  // namespace genit
@@ -0,0 +1,410 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides numeric conversion ranges, which convert each
+// element x of a range to To(x * scale + offset):
+//
+//   const std::vector<uint16_t> depth_mm = ...;
+//   for (float depth_m : ConvertRange<float>(depth_mm, 0.001)) { ... }
+//
+// A ConvertRange is a regular random-access range (if the underlying range
+// is), and has a bulk ConvertInto path, which runs a batch kernel when the
+// underlying range is contiguous:
+//
+//   std::vector<float> depth_m(depth_mm.size());
+//   ConvertRange<float>(depth_mm, 0.001).ConvertInto(depth_m);
+//
+// The batch kernels are written so that compilers vectorize them, and are
+// compiled for AVX2 as well, which is chosen at runtime when available (see
+// cpu_dispatch.h). This includes the conversions between Half and any of the
+// other types: Half converts to and from float without branches, and
+// saturates with an integer select.
+//
+// The computation is done in float when both types have at most 16 bits
+// (e.g., uint16_t, int16_t, Half) or are float, and in double otherwise.
+// Conversions to integers truncate toward zero (like static_cast).
+//
+// By default, converting a value out of the range of an integer type is
+// undefined behavior (like static_cast), and floating-point values out of
+// the range of Half become infinite. With ConversionOverflow::kSaturate,
+// values are clamped to the range of the destination type, and NaN converts
+// to the lowest value of integer types (0 for unsigned types):
+//
+//   ConvertRange<uint16_t, ConversionOverflow::kSaturate>(depth_m, 1000.0)
+//
+// Half is an IEEE 754 half-precision (binary16) floating-point number:
+//
+//   for (float value : ConvertRange<float>(half_values)) { ... }
+
+#ifndef GENIT_CONVERT_RANGE_H_
+#define GENIT_CONVERT_RANGE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/cpu_dispatch.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+
+// An IEEE 754 half-precision floating-point number, for storage. Conversions
+// to and from float are exact, and round to nearest even, respectively.
+class Half {
+ public:
+  Half() = default;
+  explicit Half(float value) : bits_(FromFloat(value)) {}
+
+  static Half FromBits(uint16_t bits) {
+    Half half;
+    half.bits_ = bits;
+    return half;
+  }
+  uint16_t bits() const { return bits_; }
+
+  explicit operator float() const { return ToFloat(bits_); }
+
+  friend bool operator==(Half lhs, Half rhs) { return lhs.bits_ == rhs.bits_; }
+  friend bool operator!=(Half lhs, Half rhs) { return lhs.bits_ != rhs.bits_; }
+
+ private:
+  static uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+  static float BitsFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  // Branch-free, so that loops of conversions vectorize.
+  static float ToFloat(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent_mantissa = half & 0x7fff;
+    // Moving the exponent and mantissa to their place in a float and scaling
+    // by 2^(127 - 15) rebiases the exponent, for normal and subnormal values.
+    const uint32_t scaled =
+        FloatBits(BitsFloat(exponent_mantissa << 13) * 0x1p112f);
+    // Infinities and NaNs (exponent_mantissa >= 0x7c00) keep the maximum
+    // exponent. The selection is done with a mask, which compilers do not
+    // turn into a branch.
+    const uint32_t special_mask = 0u - ((exponent_mantissa + 0x0400) >> 15);
+    const uint32_t special = (exponent_mantissa << 13) | 0x7f800000;
+    const uint32_t bits = (scaled & ~special_mask) | (special & special_mask);
+    return BitsFloat(bits | sign);
+  }
+
+  // Branch-free as well: the three cases are computed, and one is selected
+  // with masks.
+  static uint16_t FromFloat(float value) {
+    const uint32_t float_bits = FloatBits(value);
+    const uint32_t sign = (float_bits >> 16) & 0x8000;
+    const uint32_t bits = float_bits & 0x7fffffff;
+    // Normal: rebias the exponent, and round the 13 dropped bits to nearest
+    // even (a carry into the exponent gives the next power of 2, or infinity).
+    const uint32_t mantissa_odd = (bits >> 13) & 1;
+    const uint32_t normal =
+        (bits + (static_cast<uint32_t>(15 - 127) << 23) + 0xfff +
+         mantissa_odd) >>
+        13;
+    // Subnormal or zero: adding 0.5 aligns the mantissa, and the float
+    // addition rounds to nearest even.
+    const float magic = BitsFloat((127 - 1) << 23);
+    const uint32_t subnormal =
+        FloatBits(BitsFloat(bits) + magic) - FloatBits(magic);
+    // Overflow to infinity, or NaN (quiet).
+    const uint32_t nan_mask = 0u - static_cast<uint32_t>(bits > 0x7f800000u);
+    const uint32_t special = 0x7c00 | (nan_mask & 0x0200);
+    const uint32_t subnormal_mask =
+        0u - static_cast<uint32_t>(bits < (127 - 14) << 23);
+    const uint32_t special_mask =
+        0u - static_cast<uint32_t>(bits >= (127 + 16) << 23);
+    uint32_t half = (normal & ~subnormal_mask) | (subnormal & subnormal_mask);
+    half = (half & ~special_mask) | (special & special_mask);
+    return static_cast<uint16_t>(half | sign);
+  }
+
+  uint16_t bits_ = 0;
+};
+
+// How to convert values out of the range of the destination type.
+enum class ConversionOverflow {
+  // Like static_cast: undefined behavior for integers, infinity for Half.
+  kUnchecked,
+  // Clamp to the range of the destination type.
+  kSaturate,
+};
+
+namespace convert_range_detail {
+
+template <typename T>
+inline constexpr bool kIsSmall =
+    std::is_same_v<T, float> || std::is_same_v<T, Half> ||
+    (std::is_integral_v<T> && sizeof(T) <= 2);
+
+// Type in which x * scale + offset is computed.
+template <typename To, typename From>
+using ComputeType =
+    std::conditional_t<kIsSmall<To> && kIsSmall<From>, float, double>;
+
+template <typename C, typename From>
+C ToCompute(From value) {
+  if constexpr (std::is_same_v<From, Half>) {
+    return static_cast<C>(static_cast<float>(value));
+  } else {
+    return static_cast<C>(value);
+  }
+}
+
+template <typename To, ConversionOverflow kOverflow, typename C>
+To FromCompute(C value) {
+  if constexpr (std::is_same_v<To, Half>) {
+    const Half half(static_cast<float>(value));
+    if constexpr (kOverflow == ConversionOverflow::kSaturate) {
+      // Infinities become the largest finite value of the same sign (one less
+      // in bits), and NaN is kept. This integer select vectorizes, unlike a
+      // clamp of value.
+      const uint16_t bits = half.bits();
+      return Half::FromBits(
+          static_cast<uint16_t>(bits - ((bits & 0x7fff) == 0x7c00)));
+    }
+    return half;
+  } else if constexpr (std::is_floating_point_v<To>) {
+    if constexpr (kOverflow == ConversionOverflow::kSaturate &&
+                  sizeof(To) < sizeof(C)) {
+      constexpr C kMax = std::numeric_limits<To>::max();
+      value = value < -kMax ? -kMax : (value > kMax ? kMax : value);
+    }
+    return static_cast<To>(value);
+  } else if constexpr (kOverflow == ConversionOverflow::kSaturate) {
+    constexpr C kLowest = std::numeric_limits<To>::lowest();
+    constexpr C kMax = std::numeric_limits<To>::max();
+    if constexpr (sizeof(To) < 8) {
+      // kLowest and kMax are exact. NaN fails the first comparison.
+      return static_cast<To>(
+          value > kLowest ? (value < kMax ? value : kMax) : kLowest);
+    } else {
+      // kMax is rounded up to a power of 2, which is out of range.
+      if (!(value > kLowest)) {
+        return std::numeric_limits<To>::lowest();
+      }
+      if (value >= kMax) {
+        return std::numeric_limits<To>::max();
+      }
+      return static_cast<To>(value);
+    }
+  } else {
+    return static_cast<To>(value);
+  }
+}
+
+// Functor converting x to To(x * scale + offset).
+template <typename To, typename From, ConversionOverflow kOverflow>
+class Converter {
+ public:
+  using Compute = ComputeType<To, From>;
+
+  Converter() = default;
+  Converter(Compute scale, Compute offset) : scale_(scale), offset_(offset) {}
+
+  To operator()(From value) const {
+    return FromCompute<To, kOverflow>(ToCompute<Compute>(value) * scale_ +
+                                      offset_);
+  }
+
+ private:
+  Compute scale_ = 1;
+  Compute offset_ = 0;
+};
+
+template <typename To, typename From, ConversionOverflow kOverflow>
+using ConvertFn = void (*)(const From*, std::size_t, To*,
+                           ComputeType<To, From>, ComputeType<To, From>);
+
+// Inlined in the kernels of each level, and compiled for that level. The
+// blocks of constant size are vectorized even by the cheapest cost models.
+template <typename To, typename From, ConversionOverflow kOverflow>
+__attribute__((always_inline)) inline void ConvertLoop(
+    const From* __restrict in, std::size_t n, To* __restrict out,
+    ComputeType<To, From> scale, ComputeType<To, From> offset) {
+  const Converter<To, From, kOverflow> convert(scale, offset);
+  constexpr std::size_t kBlockSize = 16;
+  std::size_t i = 0;
+  for (; i + kBlockSize <= n; i += kBlockSize) {
+    for (std::size_t j = 0; j < kBlockSize; ++j) {
+      out[i + j] = convert(in[i + j]);
+    }
+  }
+  for (; i < n; ++i) {
+    out[i] = convert(in[i]);
+  }
+}
+
+template <typename To, typename From, ConversionOverflow kOverflow>
+void ConvertScalar(const From* in, std::size_t n, To* out,
+                   ComputeType<To, From> scale, ComputeType<To, From> offset) {
+  ConvertLoop<To, From, kOverflow>(in, n, out, scale, offset);
+}
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+
+template <typename To, typename From, ConversionOverflow kOverflow>
+__attribute__((target("avx2"))) void ConvertAvx2(
+    const From* in, std::size_t n, To* out, ComputeType<To, From> scale,
+    ComputeType<To, From> offset) {
+  ConvertLoop<To, From, kOverflow>(in, n, out, scale, offset);
+}
+
+template <typename To, typename From, ConversionOverflow kOverflow>
+inline const CpuDispatchedFunction<ConvertFn<To, From, kOverflow>> kConvert(
+    ConvertScalar<To, From, kOverflow>, nullptr,
+    ConvertAvx2<To, From, kOverflow>);
+
+#else  // GENIT_HAVE_X86_DISPATCH
+
+template <typename To, typename From, ConversionOverflow kOverflow>
+inline const CpuDispatchedFunction<ConvertFn<To, From, kOverflow>> kConvert(
+    ConvertScalar<To, From, kOverflow>);
+
+#endif  // GENIT_HAVE_X86_DISPATCH
+
+// Whether the elements of [first, last) are contiguous in memory (only
+// detected for pointers and the iterators of std::vector in C++17).
+template <typename Iter>
+inline constexpr bool kIsContiguousIterator =
+#if __cplusplus >= 202002L
+    std::contiguous_iterator<Iter>;
+#else
+    std::is_pointer_v<Iter> ||
+    std::is_same_v<Iter, typename std::vector<typename std::iterator_traits<
+                             Iter>::value_type>::iterator> ||
+    std::is_same_v<Iter, typename std::vector<typename std::iterator_traits<
+                             Iter>::value_type>::const_iterator>;
+#endif
+
+}  // namespace convert_range_detail
+
+// Writes To(in[i] * scale + offset) to out[i] for i < n, with the batch
+// kernel for the CPU. out must not overlap in.
+template <typename To,
+          ConversionOverflow kOverflow = ConversionOverflow::kUnchecked,
+          typename From>
+void ConvertInto(const From* in, std::size_t n, To* out, double scale = 1,
+                 double offset = 0) {
+  using Compute = convert_range_detail::ComputeType<To, From>;
+  convert_range_detail::kConvert<To, From, kOverflow>(
+      in, n, out, static_cast<Compute>(scale), static_cast<Compute>(offset));
+}
+
+// ConvertedRange wraps a range and converts its elements x to
+// To(x * scale + offset). See ConvertRange below.
+template <typename BaseRange, typename To, ConversionOverflow kOverflow>
+class ConvertedRange
+    : public AliasRangeFacade<
+          ConvertedRange<BaseRange, To, kOverflow>, BaseRange,
+          TransformIterator<
+              RangeIteratorType<BaseRange>,
+              convert_range_detail::Converter<
+                  To,
+                  typename std::iterator_traits<
+                      RangeIteratorType<BaseRange>>::value_type,
+                  kOverflow>>> {
+ public:
+  using BaseIter = RangeIteratorType<BaseRange>;
+  using From = typename std::iterator_traits<BaseIter>::value_type;
+  using Convert = convert_range_detail::Converter<To, From, kOverflow>;
+  using ConvIter = TransformIterator<BaseIter, Convert>;
+  using BaseFacade =
+      AliasRangeFacade<ConvertedRange<BaseRange, To, kOverflow>, BaseRange,
+                       ConvIter>;
+  using Compute = typename Convert::Compute;
+  static constexpr std::size_t kExtent = kStaticExtent<BaseRange>;
+
+  template <typename OtherRange>
+  ConvertedRange(OtherRange&& r, double scale, double offset)
+      : BaseFacade(std::forward<OtherRange>(r)),
+        scale_(static_cast<Compute>(scale)),
+        offset_(static_cast<Compute>(offset)),
+        convert_(scale_, offset_) {}
+
+  // Writes the size() converted elements to out, with the batch kernel for
+  // the CPU if the underlying range is contiguous. out must not overlap the
+  // underlying range.
+  void ConvertInto(To* out) const {
+    ConvIter first = this->begin();
+    ConvIter last = this->end();
+    if constexpr (convert_range_detail::kIsContiguousIterator<BaseIter>) {
+      const std::size_t n = last.base() - first.base();
+      if (n > 0) {
+        genit::ConvertInto<To, kOverflow>(&*first.base(), n, out, scale_,
+                                          offset_);
+      }
+    } else {
+      std::copy(first, last, out);
+    }
+  }
+
+  // Writes the converted elements to the first size() elements of a
+  // contiguous range, e.g., a std::vector.
+  template <typename OutRange,
+            std::enable_if_t<!std::is_pointer_v<OutRange>, int> = 0>
+  void ConvertInto(OutRange& out) const {
+    assert(std::size(out) >= static_cast<std::size_t>(this->size()));
+    ConvertInto(std::data(out));
+  }
+
+ private:
+  friend class AliasRangeFacadePrivateAccess<
+      ConvertedRange<BaseRange, To, kOverflow>>;
+
+  auto Begin(const BaseRange& base_range) const {
+    using std::begin;
+    return ConvIter(begin(base_range), &convert_);
+  }
+  auto End(const BaseRange& base_range) const {
+    using std::end;
+    return ConvIter(end(base_range), &convert_);
+  }
+
+  Compute scale_;
+  Compute offset_;
+  Convert convert_;
+};
+
+// Returns a range of the elements x of a range converted to
+// To(x * scale + offset).
+template <typename To,
+          ConversionOverflow kOverflow = ConversionOverflow::kUnchecked,
+          typename Range>
+auto ConvertRange(Range&& range, double scale = 1, double offset = 0) {
+  return ConvertedRange<decltype(MoveOrAliasRange(std::forward<Range>(range))),
+                        To, kOverflow>(
+      MoveOrAliasRange(std::forward<Range>(range)), scale, offset);
+}
+
+}  // namespace genit
+
+#endif  // GENIT_CONVERT_RANGE_H_
@@ -0,0 +1,175 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares converting a 640x480 depth image (uint16_t millimeters to float
+// meters), half floats to floats and back, and float meters back to saturated
+// uint16_t millimeters, with ConvertRange (iterated, or ConvertInto at each
+// instruction set level) and TransformRange with a lambda copied to the
+// output.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/convert_range.h"
+#include "genit/cpu_dispatch.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumPixels = 640 * 480;
+
+std::vector<uint16_t> MakeDepth() {
+  std::vector<uint16_t> depth(kNumPixels);
+  for (int i = 0; i < kNumPixels; ++i) {
+    depth[i] = static_cast<uint16_t>(500 + (i * 7) % 5000);
+  }
+  return depth;
+}
+
+void BM_DepthTransformRange(benchmark::State& state) {
+  const auto depth = MakeDepth();
+  std::vector<float> out(depth.size());
+  for (auto _ : state) {
+    const auto meters = TransformRange(
+        depth, [](uint16_t mm) { return static_cast<float>(mm) * 0.001f; });
+    std::copy(meters.begin(), meters.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+void BM_DepthConvertRangeCopy(benchmark::State& state) {
+  const auto depth = MakeDepth();
+  std::vector<float> out(depth.size());
+  for (auto _ : state) {
+    const auto meters = ConvertRange<float>(depth, 0.001);
+    std::copy(meters.begin(), meters.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+// The argument is the CpuLevel.
+void BM_DepthConvertInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  const auto depth = MakeDepth();
+  std::vector<float> out(depth.size());
+  for (auto _ : state) {
+    ConvertRange<float>(depth, 0.001).ConvertInto(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+void BM_HalfToFloatCopy(benchmark::State& state) {
+  std::vector<Half> halves(kNumPixels);
+  for (int i = 0; i < kNumPixels; ++i) {
+    halves[i] = Half(i * 0.01f);
+  }
+  std::vector<float> out(halves.size());
+  for (auto _ : state) {
+    const auto floats = ConvertRange<float>(halves);
+    std::copy(floats.begin(), floats.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+void BM_HalfToFloatConvertInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  std::vector<Half> halves(kNumPixels);
+  for (int i = 0; i < kNumPixels; ++i) {
+    halves[i] = Half(i * 0.01f);
+  }
+  std::vector<float> out(halves.size());
+  for (auto _ : state) {
+    ConvertRange<float>(halves).ConvertInto(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+void BM_FloatToHalfConvertInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  std::vector<float> floats(kNumPixels);
+  for (int i = 0; i < kNumPixels; ++i) {
+    floats[i] = i * 0.01f;
+  }
+  std::vector<Half> out(floats.size());
+  for (auto _ : state) {
+    ConvertRange<Half>(floats).ConvertInto(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+void BM_MetersToSaturatedDepthConvertInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  std::vector<float> meters(kNumPixels);
+  for (int i = 0; i < kNumPixels; ++i) {
+    meters[i] = (i % 9000) * 0.01f - 10.0f;
+  }
+  std::vector<uint16_t> out(meters.size());
+  for (auto _ : state) {
+    ConvertRange<uint16_t, ConversionOverflow::kSaturate>(meters, 1000.0)
+        .ConvertInto(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetItemsProcessed(state.iterations() * kNumPixels);
+}
+
+BENCHMARK(BM_DepthTransformRange);
+BENCHMARK(BM_DepthConvertRangeCopy);
+BENCHMARK(BM_DepthConvertInto)->Arg(0)->Arg(2);
+BENCHMARK(BM_HalfToFloatCopy);
+BENCHMARK(BM_HalfToFloatConvertInto)->Arg(0)->Arg(2);
+BENCHMARK(BM_FloatToHalfConvertInto)->Arg(0)->Arg(2);
+BENCHMARK(BM_MetersToSaturatedDepthConvertInto)->Arg(0)->Arg(2);
+
+}  // namespace
+}  // namespace genit
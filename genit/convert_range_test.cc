@@ -0,0 +1,252 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/convert_range.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <type_traits>
+#include <vector>
+
+#include "genit/cpu_dispatch.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+
+TEST(HalfTest, KnownValues) {
+  EXPECT_EQ(Half(1.0f).bits(), 0x3c00);
+  EXPECT_EQ(Half(-2.0f).bits(), 0xc000);
+  EXPECT_EQ(Half(0.0f).bits(), 0x0000);
+  EXPECT_EQ(Half(-0.0f).bits(), 0x8000);
+  EXPECT_EQ(Half(65504.0f).bits(), 0x7bff);
+  EXPECT_EQ(Half(std::ldexp(1.0f, -24)).bits(), 0x0001);
+  EXPECT_EQ(Half(std::numeric_limits<float>::infinity()).bits(), 0x7c00);
+  EXPECT_EQ(Half(1e6f).bits(), 0x7c00);
+  EXPECT_EQ(Half(std::nanf("")).bits() & 0x7e00, 0x7e00);
+  EXPECT_EQ(static_cast<float>(Half::FromBits(0x3555)), 0.333251953125f);
+  EXPECT_EQ(static_cast<float>(Half::FromBits(0x0001)), std::ldexp(1.0f, -24));
+  EXPECT_TRUE(std::isnan(static_cast<float>(Half::FromBits(0x7e00))));
+  EXPECT_EQ(static_cast<float>(Half::FromBits(0xfc00)),
+            -std::numeric_limits<float>::infinity());
+}
+
+TEST(HalfTest, RoundsToNearestEven) {
+  const float ulp = std::ldexp(1.0f, -10);
+  // Ties round to the even mantissa.
+  EXPECT_EQ(Half(1.0f + ulp / 2).bits(), 0x3c00);
+  EXPECT_EQ(Half(1.0f + 3 * ulp / 2).bits(), 0x3c02);
+  EXPECT_EQ(Half(1.0f + ulp / 2 + ulp / 8).bits(), 0x3c01);
+  // Rounds up to infinity past the largest half.
+  EXPECT_EQ(Half(65520.0f).bits(), 0x7c00);
+  EXPECT_EQ(Half(65519.0f).bits(), 0x7bff);
+  // Subnormals.
+  EXPECT_EQ(Half(std::ldexp(1.0f, -25)).bits(), 0x0000);
+  EXPECT_EQ(Half(std::ldexp(3.0f, -25)).bits(), 0x0002);
+}
+
+TEST(HalfTest, RoundTripsAllValues) {
+  for (uint32_t bits = 0; bits <= 0xffff; ++bits) {
+    const Half half = Half::FromBits(bits);
+    const float value = static_cast<float>(half);
+    if (std::isnan(value)) {
+      continue;
+    }
+    ASSERT_EQ(Half(value).bits(), bits) << value;
+  }
+}
+
+TEST(ConvertRangeTest, DepthToMeters) {
+  const std::vector<uint16_t> depth_mm = {0, 1000, 1500, 65535};
+  const auto depth_m = ConvertRange<float>(depth_mm, 0.001);
+  EXPECT_THAT(depth_m, ElementsAre(0.0f, 1.0f, FloatEq(1.5f),
+                                   FloatEq(65.535f)));
+  using It = decltype(depth_m.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_EQ(depth_m.size(), 4);
+  EXPECT_THAT(depth_m[1], FloatEq(1.0f));
+}
+
+TEST(ConvertRangeTest, ScaleAndOffset) {
+  const std::vector<int16_t> counts = {-100, 0, 100};
+  EXPECT_THAT(ConvertRange<float>(counts, 0.5, 1.0),
+              ElementsAre(-49.0f, 1.0f, 51.0f));
+  EXPECT_THAT(ConvertRange<double>(std::vector<int>{1, 2}),
+              ElementsAre(1.0, 2.0));
+}
+
+TEST(ConvertRangeTest, TruncatesToIntegers) {
+  const std::vector<float> values = {1.9f, -1.9f, 2.0f};
+  EXPECT_THAT(ConvertRange<int>(values), ElementsAre(1, -1, 2));
+}
+
+TEST(ConvertRangeTest, Saturates) {
+  const std::vector<float> meters = {-1.0f, 0.5f, 70.0f, std::nanf("")};
+  EXPECT_THAT(
+      (ConvertRange<uint16_t, ConversionOverflow::kSaturate>(meters, 1000.0)),
+      ElementsAre(0, 500, 65535, 0));
+  const std::vector<double> big = {1e30, -1e30, 3.0};
+  EXPECT_THAT((ConvertRange<int64_t, ConversionOverflow::kSaturate>(big)),
+              ElementsAre(std::numeric_limits<int64_t>::max(),
+                          std::numeric_limits<int64_t>::lowest(), 3));
+  EXPECT_THAT((ConvertRange<int8_t, ConversionOverflow::kSaturate>(
+                  std::vector<int>{-1000, 5, 1000})),
+              ElementsAre(-128, 5, 127));
+  const auto halves = ConvertRange<Half, ConversionOverflow::kSaturate>(
+      std::vector<float>{1e6f, -1e6f});
+  EXPECT_THAT(halves, ElementsAre(Half(65504.0f), Half(-65504.0f)));
+  EXPECT_EQ(ConvertRange<Half>(std::vector<float>{1e6f})[0].bits(), 0x7c00);
+}
+
+TEST(ConvertRangeTest, HalfToFloat) {
+  const std::vector<Half> halves = {Half(1.0f), Half(-0.5f), Half(2048.0f)};
+  EXPECT_THAT(ConvertRange<float>(halves), ElementsAre(1.0f, -0.5f, 2048.0f));
+  EXPECT_THAT(ConvertRange<float>(halves, 2.0), ElementsAre(2.0f, -1.0f,
+                                                            4096.0f));
+}
+
+TEST(ConvertRangeTest, ConvertIntoMatchesRange) {
+  std::vector<uint16_t> depth_mm(1000);
+  for (int i = 0; i < 1000; ++i) {
+    depth_mm[i] = static_cast<uint16_t>(i * 65);
+  }
+  const auto depth_m = ConvertRange<float>(depth_mm, 0.001, -0.25);
+  const std::vector<float> expected(depth_m.begin(), depth_m.end());
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    std::vector<float> out(depth_mm.size());
+    depth_m.ConvertInto(out);
+    EXPECT_EQ(out, expected) << CpuLevelName(level);
+  }
+}
+
+TEST(ConvertRangeTest, ConvertIntoHalves) {
+  std::vector<Half> halves;
+  for (uint32_t bits = 0; bits < 0x7c00; bits += 7) {
+    halves.push_back(Half::FromBits(bits));
+  }
+  std::vector<float> floats(halves.size());
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    ConvertRange<float>(halves).ConvertInto(floats);
+    std::vector<Half> round_trip(floats.size());
+    ConvertInto<Half>(floats.data(), floats.size(), round_trip.data());
+    EXPECT_EQ(round_trip, halves) << CpuLevelName(level);
+  }
+}
+
+TEST(ConvertRangeTest, ConvertIntoHalvesRoundsToNearestEvenAtEachLevel) {
+  // The midpoint between each pair of consecutive finite halves (and the
+  // largest one and infinity), and the floats right below and above it.
+  std::vector<float> floats;
+  std::vector<uint16_t> expected;
+  for (uint32_t bits = 0; bits < 0x7c00; ++bits) {
+    const float lo = static_cast<float>(Half::FromBits(bits));
+    const float hi = bits + 1 == 0x7c00
+                         ? 65536.0f
+                         : static_cast<float>(Half::FromBits(bits + 1));
+    const float mid = (lo + hi) / 2;
+    const uint32_t even = bits % 2 == 0 ? bits : bits + 1;
+    for (const uint16_t sign : {0x0000, 0x8000}) {
+      const float s = sign == 0 ? 1.0f : -1.0f;
+      floats.insert(floats.end(), {s * std::nextafter(mid, lo), s * mid,
+                                   s * std::nextafter(mid, hi)});
+      expected.insert(expected.end(),
+                      {static_cast<uint16_t>(bits | sign),
+                       static_cast<uint16_t>(even | sign),
+                       static_cast<uint16_t>((bits + 1) | sign)});
+    }
+  }
+  std::vector<Half> halves(floats.size());
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    ConvertInto<Half>(floats.data(), floats.size(), halves.data());
+    for (std::size_t i = 0; i < floats.size(); ++i) {
+      ASSERT_EQ(halves[i].bits(), expected[i])
+          << CpuLevelName(level) << ", " << floats[i];
+    }
+  }
+}
+
+TEST(ConvertRangeTest, ConvertIntoSaturatedHalvesAtEachLevel) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const std::vector<float> floats = {
+      1e6f, -1e6f, inf, -inf, 65519.0f, 65520.0f, 1.0f, std::nanf("")};
+  std::vector<Half> halves(floats.size());
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    ConvertInto<Half, ConversionOverflow::kSaturate>(
+        floats.data(), floats.size(), halves.data());
+    EXPECT_EQ(halves[0].bits(), 0x7bff) << CpuLevelName(level);
+    EXPECT_EQ(halves[1].bits(), 0xfbff) << CpuLevelName(level);
+    EXPECT_EQ(halves[2].bits(), 0x7bff) << CpuLevelName(level);
+    EXPECT_EQ(halves[3].bits(), 0xfbff) << CpuLevelName(level);
+    EXPECT_EQ(halves[4].bits(), 0x7bff) << CpuLevelName(level);
+    EXPECT_EQ(halves[5].bits(), 0x7bff) << CpuLevelName(level);
+    EXPECT_EQ(halves[6].bits(), 0x3c00) << CpuLevelName(level);
+    EXPECT_EQ(halves[7].bits() & 0x7e00, 0x7e00) << CpuLevelName(level);
+  }
+}
+
+TEST(ConvertRangeTest, ConvertIntoNonContiguous) {
+  const std::list<int16_t> counts = {1, 2, 3};
+  float out[3];
+  ConvertRange<float>(counts, 0.25).ConvertInto(out);
+  EXPECT_THAT(out, ElementsAre(0.25f, 0.5f, 0.75f));
+}
+
+TEST(ConvertRangeTest, ConvertIntoEmpty) {
+  const std::vector<uint16_t> empty;
+  std::vector<float> out;
+  ConvertRange<float>(empty).ConvertInto(out);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(ConvertRangeTest, ConvertIntoSaturates) {
+  const std::vector<float> values = {-5.0f, 1.5f, 300.0f, std::nanf(""),
+                                     42.0f, 1e10f, -1e10f, 255.0f,
+                                     0.0f,  7.9f,  100.0f, 200.0f,
+                                     250.0f, 256.0f, 1.0f, 2.0f,
+                                     3.0f,  -0.5f};
+  std::vector<uint8_t> expected;
+  for (float value : values) {
+    expected.push_back(
+        value > 0 ? (value < 255 ? static_cast<uint8_t>(value) : 255) : 0);
+  }
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    std::vector<uint8_t> out(values.size());
+    ConvertInto<uint8_t, ConversionOverflow::kSaturate>(
+        values.data(), values.size(), out.data());
+    EXPECT_EQ(out, expected) << CpuLevelName(level);
+  }
+}
+
+TEST(ConvertRangeTest, KeepsStaticExtent) {
+  const std::array<uint16_t, 3> a = {1, 2, 3};
+  static_assert(kStaticExtent<decltype(ConvertRange<float>(a))> == 3);
+  EXPECT_THAT(ConvertRange<float>(a, 2.0), ElementsAre(2.0f, 4.0f, 6.0f));
+}
+
+}  // namespace
+}  // namespace genit
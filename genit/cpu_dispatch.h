@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides runtime dispatch of kernels on the instruction
+// set extensions of the CPU, so that one binary (built for the baseline
+// x86-64 instruction set) runs the best kernel on each machine:
+//
+//   inline const CpuDispatchedFunction<int (*)(const float*, int)> kSum(
+//       SumScalar, SumSse42, SumAvx2, SumAvx512);
+//   ...
+//   const int sum = kSum(values, n);
+//
+// where the kernels for each level are compiled with the matching
+// __attribute__((target(...))). The CPU is inspected (cpuid) once, and the
+// kernel chosen on the first call is cached in a function pointer.
+//
+// Tests can lower the level to run each kernel on a single machine:
+//
+//   for (CpuLevel level : SupportedCpuLevels()) {
+//     ScopedCpuLevelOverride override(level);
+//     EXPECT_EQ(kSum(values, n), expected);
+//   }
+
+#ifndef GENIT_CPU_DISPATCH_H_
+#define GENIT_CPU_DISPATCH_H_
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define GENIT_HAVE_X86_DISPATCH 1
+#endif
+
+namespace genit {
+
+// Instruction set levels, in increasing order:
+//   kSse42:  SSE4.2 and POPCNT.
+//   kAvx2:   AVX2 (and the above).
+//   kAvx512: AVX-512 F and BW (and the above).
+enum class CpuLevel { kScalar = 0, kSse42 = 1, kAvx2 = 2, kAvx512 = 3 };
+
+inline const char* CpuLevelName(CpuLevel level) {
+  switch (level) {
+    case CpuLevel::kScalar:
+      return "scalar";
+    case CpuLevel::kSse42:
+      return "sse4.2";
+    case CpuLevel::kAvx2:
+      return "avx2";
+    case CpuLevel::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+namespace cpu_dispatch_detail {
+
+inline CpuLevel DetectCpuLevel() {
+#ifdef GENIT_HAVE_X86_DISPATCH
+  // Also checks that the OS saves the AVX registers.
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("sse4.2") || !__builtin_cpu_supports("popcnt")) {
+    return CpuLevel::kScalar;
+  }
+  if (!__builtin_cpu_supports("avx2")) {
+    return CpuLevel::kSse42;
+  }
+  if (!__builtin_cpu_supports("avx512f") ||
+      !__builtin_cpu_supports("avx512bw")) {
+    return CpuLevel::kAvx2;
+  }
+  return CpuLevel::kAvx512;
+#else
+  return CpuLevel::kScalar;
+#endif
+}
+
+// Maximum level set by ScopedCpuLevelOverride, or -1.
+inline std::atomic<int> max_level_override{-1};
+
+// Incremented each time the override changes, to invalidate the kernels
+// cached by CpuDispatchedFunction. Starts at 1, so that 0 means "not cached".
+inline std::atomic<unsigned> generation{1};
+
+}  // namespace cpu_dispatch_detail
+
+// Returns the highest level supported by the CPU.
+inline CpuLevel DetectedCpuLevel() {
+  static const CpuLevel level = cpu_dispatch_detail::DetectCpuLevel();
+  return level;
+}
+
+// Returns the level of the kernels to run: the detected level, lowered by
+// ScopedCpuLevelOverride if any.
+inline CpuLevel ActiveCpuLevel() {
+  const int max_level = cpu_dispatch_detail::max_level_override.load(
+      std::memory_order_relaxed);
+  const CpuLevel detected = DetectedCpuLevel();
+  return max_level < 0 ? detected
+                       : std::min(detected, static_cast<CpuLevel>(max_level));
+}
+
+// Returns the levels supported by the CPU, from kScalar to the detected one.
+inline std::vector<CpuLevel> SupportedCpuLevels() {
+  std::vector<CpuLevel> levels;
+  for (int level = 0; level <= static_cast<int>(DetectedCpuLevel()); ++level) {
+    levels.push_back(static_cast<CpuLevel>(level));
+  }
+  return levels;
+}
+
+// Lowers the active level to at most max_level while in scope (levels above
+// the detected one are never used). For tests and benchmarks: it must not be
+// created while dispatched functions are called from other threads.
+class ScopedCpuLevelOverride {
+ public:
+  explicit ScopedCpuLevelOverride(CpuLevel max_level)
+      : previous_(cpu_dispatch_detail::max_level_override.exchange(
+            static_cast<int>(max_level))) {
+    cpu_dispatch_detail::generation.fetch_add(1);
+  }
+  ~ScopedCpuLevelOverride() {
+    cpu_dispatch_detail::max_level_override.store(previous_);
+    cpu_dispatch_detail::generation.fetch_add(1);
+  }
+
+  ScopedCpuLevelOverride(const ScopedCpuLevelOverride&) = delete;
+  ScopedCpuLevelOverride& operator=(const ScopedCpuLevelOverride&) = delete;
+
+ private:
+  int previous_;
+};
+
+// A function with one kernel per level, which calls the kernel of the highest
+// level not above ActiveCpuLevel(). Fn is a function pointer type. Kernels of
+// intermediate levels may be nullptr, in which case the kernel of the level
+// below is used. The scalar kernel is required.
+template <typename Fn>
+class CpuDispatchedFunction {
+ public:
+  constexpr explicit CpuDispatchedFunction(Fn scalar, Fn sse42 = nullptr,
+                                           Fn avx2 = nullptr,
+                                           Fn avx512 = nullptr)
+      : kernels_{scalar, sse42, avx2, avx512} {}
+
+  // Returns the kernel to call, chosen on the first call (and after each
+  // change of the override).
+  Fn Get() const {
+    const unsigned generation =
+        cpu_dispatch_detail::generation.load(std::memory_order_relaxed);
+    if (cached_generation_.load(std::memory_order_acquire) == generation) {
+      return cached_kernel_.load(std::memory_order_relaxed);
+    }
+    const Fn kernel = Resolve(ActiveCpuLevel());
+    cached_kernel_.store(kernel, std::memory_order_relaxed);
+    cached_generation_.store(generation, std::memory_order_release);
+    return kernel;
+  }
+
+  // Returns the kernel called at the given level.
+  Fn Resolve(CpuLevel level) const {
+    for (int i = static_cast<int>(level); i > 0; --i) {
+      if (kernels_[i] != nullptr) {
+        return kernels_[i];
+      }
+    }
+    return kernels_[0];
+  }
+
+  template <typename... Args>
+  decltype(auto) operator()(Args&&... args) const {
+    return Get()(std::forward<Args>(args)...);
+  }
+
+ private:
+  Fn kernels_[4];
+  mutable std::atomic<Fn> cached_kernel_{nullptr};
+  mutable std::atomic<unsigned> cached_generation_{0};
+};
+
+}  // namespace genit
+
+#endif  // GENIT_CPU_DISPATCH_H_
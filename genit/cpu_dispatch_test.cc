@@ -0,0 +1,92 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/cpu_dispatch.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+using LevelFn = CpuLevel (*)();
+
+CpuLevel ScalarKernel() { return CpuLevel::kScalar; }
+CpuLevel Sse42Kernel() { return CpuLevel::kSse42; }
+CpuLevel Avx512Kernel() { return CpuLevel::kAvx512; }
+
+// No AVX2-specific kernel: the SSE4.2 one is used at that level.
+const CpuDispatchedFunction<LevelFn> kLevelOfKernel(ScalarKernel, Sse42Kernel,
+                                                    nullptr, Avx512Kernel);
+
+int Add(int a, int b) { return a + b; }
+
+TEST(CpuDispatchTest, ActiveLevelIsDetectedLevel) {
+  EXPECT_EQ(ActiveCpuLevel(), DetectedCpuLevel());
+  EXPECT_EQ(SupportedCpuLevels().front(), CpuLevel::kScalar);
+  EXPECT_EQ(SupportedCpuLevels().back(), DetectedCpuLevel());
+}
+
+TEST(CpuDispatchTest, LevelNames) {
+  EXPECT_EQ(std::string(CpuLevelName(CpuLevel::kScalar)), "scalar");
+  EXPECT_EQ(std::string(CpuLevelName(CpuLevel::kAvx512)), "avx512");
+}
+
+TEST(CpuDispatchTest, ResolvesToHighestAvailableKernel) {
+  EXPECT_EQ(kLevelOfKernel.Resolve(CpuLevel::kScalar), &ScalarKernel);
+  EXPECT_EQ(kLevelOfKernel.Resolve(CpuLevel::kSse42), &Sse42Kernel);
+  EXPECT_EQ(kLevelOfKernel.Resolve(CpuLevel::kAvx2), &Sse42Kernel);
+  EXPECT_EQ(kLevelOfKernel.Resolve(CpuLevel::kAvx512), &Avx512Kernel);
+}
+
+TEST(CpuDispatchTest, OverrideLowersLevel) {
+  const CpuLevel detected = DetectedCpuLevel();
+  {
+    ScopedCpuLevelOverride override(CpuLevel::kScalar);
+    EXPECT_EQ(ActiveCpuLevel(), CpuLevel::kScalar);
+    EXPECT_EQ(kLevelOfKernel(), CpuLevel::kScalar);
+    {
+      // Never above the detected level.
+      ScopedCpuLevelOverride nested(CpuLevel::kAvx512);
+      EXPECT_EQ(ActiveCpuLevel(), detected);
+      EXPECT_EQ(kLevelOfKernel.Get(),
+                kLevelOfKernel.Resolve(detected));
+    }
+    EXPECT_EQ(kLevelOfKernel(), CpuLevel::kScalar);
+  }
+  EXPECT_EQ(ActiveCpuLevel(), detected);
+  EXPECT_EQ(kLevelOfKernel.Get(), kLevelOfKernel.Resolve(detected));
+}
+
+TEST(CpuDispatchTest, EachSupportedLevel) {
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    EXPECT_EQ(ActiveCpuLevel(), level);
+    EXPECT_EQ(kLevelOfKernel.Get(), kLevelOfKernel.Resolve(level));
+  }
+}
+
+TEST(CpuDispatchTest, ForwardsArguments) {
+  const CpuDispatchedFunction<int (*)(int, int)> add(Add);
+  EXPECT_EQ(add(2, 3), 5);
+  ScopedCpuLevelOverride override(CpuLevel::kAvx2);
+  EXPECT_EQ(add(4, 3), 7);
+}
+
+}  // namespace
+}  // namespace genit
@@ -33,6 +33,7 @@
 #include <utility>
 
 #include "genit/iterator_facade.h"
+#include "genit/iterator_position.h"
 #include "genit/iterator_range.h"
 #include "genit/zip_iterator.h"
 
@@ -41,6 +42,18 @@ namespace genit {
 // Forward-decl.
 template <typename BaseRange, typename Predicate>
 class FilteredRange;
+template <typename BaseRange, typename Predicate>
+class ReverseFilterIterator;
+
+namespace filter_iterator_detail {
+
+template <typename BaseRange>
+using FilterIterCategory = zip_iterator_detail::LeastPermissive<
+    std::bidirectional_iterator_tag,
+    zip_iterator_detail::ReduceToStdIterCategory<typename std::iterator_traits<
+        RangeIteratorType<BaseRange>>::iterator_category>>;
+
+}  // namespace filter_iterator_detail
 
 template <typename BaseRange, typename Predicate>
 class FilterIterator
@@ -48,12 +61,9 @@ class FilterIterator
           FilterIterator<BaseRange, Predicate>,
           typename std::iterator_traits<
               RangeIteratorType<BaseRange>>::reference,
-          zip_iterator_detail::LeastPermissive<
-              std::bidirectional_iterator_tag,
-              zip_iterator_detail::ReduceToStdIterCategory<
-                  typename std::iterator_traits<
-                      RangeIteratorType<BaseRange>>::iterator_category>>> {
+          filter_iterator_detail::FilterIterCategory<BaseRange>> {
  public:
+  FilterIterator() = default;
   FilterIterator(RangeIteratorType<BaseRange> it,
                  const FilteredRange<BaseRange, Predicate>* parent)
       : it_(std::move(it)), parent_(parent) {
@@ -79,10 +89,92 @@ class FilterIterator
   }
   bool IsEqual(const FilterIterator& other) const { return it_ == other.it_; }
 
+  // Iterates backwards over the base range and evaluates the predicate once
+  // per element, see MakeReverseIterator.
+  friend ReverseFilterIterator<BaseRange, Predicate> MakeNativeReverseIterator(
+      const FilterIterator& it, const FilterIterator& first) {
+    using BaseRevIter = std::reverse_iterator<RangeIteratorType<BaseRange>>;
+    return ReverseFilterIterator<BaseRange, Predicate>(
+        BaseRevIter(it.it_), BaseRevIter(first.it_), it.parent_);
+  }
+
+  // The position of the base iterator, so that restoring it evaluates the
+  // predicate once, see iterator_position.h.
+  friend void AppendNativePosition(const FilterIterator& it,
+                                   IteratorPosition* position) {
+    it.AppendBasePosition(position);
+  }
+  friend bool ReadNativePosition(const FilterIterator& last,
+                                 IteratorPositionReader* reader,
+                                 FilterIterator* it) {
+    return last.ReadBasePosition(reader, it);
+  }
+  void AppendBasePosition(IteratorPosition* position) const {
+    AppendPosition(parent_->Base(), it_, position);
+  }
+  bool ReadBasePosition(IteratorPositionReader* reader,
+                        FilterIterator* it) const {
+    RangeIteratorType<BaseRange> base = it_;
+    if (!ReadPosition(parent_->Base(), reader, &base)) {
+      return false;
+    }
+    *it = FilterIterator(std::move(base), parent_);
+    return true;
+  }
+
   RangeIteratorType<BaseRange> it_;
   const FilteredRange<BaseRange, Predicate>* parent_ = nullptr;
 };
 
+// Iterates backwards over a filtered range. Unlike
+// std::reverse_iterator<FilterIterator>, only the (cheap) base iterator is
+// reversed, so that the predicate is evaluated once per element.
+template <typename BaseRange, typename Predicate>
+class ReverseFilterIterator
+    : public IteratorFacade<
+          ReverseFilterIterator<BaseRange, Predicate>,
+          typename std::iterator_traits<
+              RangeIteratorType<BaseRange>>::reference,
+          filter_iterator_detail::FilterIterCategory<BaseRange>> {
+ public:
+  using BaseRevIter = std::reverse_iterator<RangeIteratorType<BaseRange>>;
+
+  ReverseFilterIterator() = default;
+  // Skips to the first element at or after 'it' (in reverse order) that
+  // satisfies the predicate, or to 'last'.
+  ReverseFilterIterator(BaseRevIter it, BaseRevIter last,
+                        const FilteredRange<BaseRange, Predicate>* parent)
+      : it_(std::move(it)), last_(std::move(last)), parent_(parent) {
+    while (it_ != last_ && !parent_->EvaluatePredicate(*it_)) {
+      ++it_;
+    }
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<ReverseFilterIterator>;
+
+  using OutputRefType =
+      typename std::iterator_traits<RangeIteratorType<BaseRange>>::reference;
+
+  OutputRefType Dereference() const { return *it_; }
+  void Increment() {
+    while (++it_ != last_ && !parent_->EvaluatePredicate(*it_)) {
+    }
+  }
+  void Decrement() {
+    while (!parent_->EvaluatePredicate(*--it_)) {
+    }
+  }
+  bool IsEqual(const ReverseFilterIterator& other) const {
+    return it_ == other.it_;
+  }
+
+  BaseRevIter it_;
+  // The reverse end of the base range.
+  BaseRevIter last_;
+  const FilteredRange<BaseRange, Predicate>* parent_ = nullptr;
+};
+
 template <typename BaseRange, typename Predicate>
 class FilteredRange
     : public AliasRangeFacade<FilteredRange<BaseRange, Predicate>, BaseRange,
@@ -108,6 +200,7 @@ class FilteredRange
   friend class AliasRangeFacadePrivateAccess<
       FilteredRange<BaseRange, Predicate>>;
   friend class FilterIterator<BaseRange, Predicate>;
+  friend class ReverseFilterIterator<BaseRange, Predicate>;
 
   auto Begin(const BaseRange& base_range) const {
     using std::begin;
@@ -118,6 +211,7 @@ class FilteredRange
     return FiltIter(end(base_range), this);
   }
 
+  const BaseRange& Base() const { return this->base_range_; }
   auto BaseEnd() const {
     using std::end;
     return end(this->base_range_);
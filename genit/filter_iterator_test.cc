@@ -19,6 +19,7 @@
 #include <iterator>
 #include <list>
 #include <sstream>
+#include <vector>
 
 #include "genit/iterator_range.h"
 #include "genit/zip_iterator.h"
@@ -123,6 +124,35 @@ TEST(FilterIteratorTest, BackwardIterationIncludingBoundary) {
   }
 }
 
+TEST(FilterIteratorTest, BackwardIterationEvaluatesPredicateOncePerElement) {
+  const int xs[] = {1, 2, 3, 4, 5, 6, 7};
+  int num_calls = 0;
+  const auto range = FilterRange(xs, [&num_calls](int x) {
+    ++num_calls;
+    return x % 3 != 0;
+  });
+  std::vector<int> reversed;
+  for (int x : ReverseRange(range)) {
+    reversed.push_back(x);
+  }
+  EXPECT_EQ(reversed, (std::vector<int>{7, 5, 4, 2, 1}));
+  // Once per element, plus once to find the (forward) beginning of the range.
+  EXPECT_EQ(num_calls, 8);
+}
+
+TEST(FilterIteratorTest, BackwardIterationOverSubRange) {
+  const int xs[] = {1, 2, 3, 4, 5, 6};
+  const auto range = FilterRange(xs, IsEven{});
+  const auto sub_range =
+      MakeIteratorRange(std::next(range.begin()), range.end());
+  std::vector<int> reversed;
+  for (int x : ReverseRange(sub_range)) {
+    reversed.push_back(x);
+  }
+  EXPECT_EQ(reversed, (std::vector<int>{6, 4}));
+  EXPECT_TRUE(ReverseRange(FilterRange(xs, FalsePredicate{})).empty());
+}
+
 TEST(FilterIteratorTest, WriteToFilteredRange) {
   int xs[] = {0, 2, 0, 4, 5};
   const int expected[] = {0, 1, 0, 1, 1};
@@ -0,0 +1,284 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENIT_FLAT_MAP_H_
+#define GENIT_FLAT_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_range.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+
+namespace flat_map_detail {
+
+// Branchless lower bound on a sorted array: each step halves the search
+// window with a conditional move instead of a (mispredicted) branch, and the
+// number of steps only depends on n.
+template <typename Key, typename Compare>
+const Key* BranchlessLowerBound(const Key* first, std::size_t n,
+                                const Key& key, const Compare& comp) {
+  if (n == 0) {
+    return first;
+  }
+  while (n > 1) {
+    const std::size_t half = n / 2;
+    first = comp(first[half], key) ? first + half : first;
+    n -= half;
+  }
+  return first + (comp(*first, key) ? 1 : 0);
+}
+
+}  // namespace flat_map_detail
+
+// A FlatMap is a sorted associative container that stores its keys and its
+// values in two separate contiguous arrays (structure of arrays). Compared to
+// std::map, lookups touch only the (densely packed) keys and do not chase
+// pointers, and iteration over keys or values only is a linear scan.
+//
+// Iteration over the map goes through a ZipRange of the key and value arrays,
+// producing std::tuple<const Key&, Value&> elements:
+//
+//   FlatMap<int, double> map = ...;
+//   for (auto [key, value] : map) { ... }
+//   for (int key : map.Keys()) { ... }
+//   for (double& value : map.Values()) { ... }
+//
+// Bulk construction from any range of pair-like elements (std::pair,
+// std::tuple, or a ZipRange of keys and values) sorts the input once.
+//
+// Caveats:
+//  - Insertion and erasure are O(n), like for a sorted std::vector. Prefer
+//    bulk construction when building large maps.
+//  - Insertion and erasure invalidate all iterators and references.
+//  - Value cannot be bool (std::vector<bool> is not contiguous).
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+  static_assert(!std::is_same_v<Value, bool>,
+                "FlatMap does not support bool values.");
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using iterator = ZipIterator<typename std::vector<Key>::const_iterator,
+                               typename std::vector<Value>::iterator>;
+  using const_iterator =
+      ZipIterator<typename std::vector<Key>::const_iterator,
+                  typename std::vector<Value>::const_iterator>;
+  using value_type = std::tuple<Key, Value>;
+  using reference = typename std::iterator_traits<iterator>::reference;
+  using const_reference =
+      typename std::iterator_traits<const_iterator>::reference;
+
+  FlatMap() = default;
+
+  explicit FlatMap(const Compare& comp) : comp_(comp) {}
+
+  // Constructs a map from a range of pair-like elements, sorting the range
+  // once. For duplicate keys, the first element in the range is kept (as for
+  // std::map::insert).
+  template <typename Range,
+            typename = decltype(std::get<1>(
+                *std::begin(std::declval<const Range&>())))>
+  explicit FlatMap(const Range& pairs, const Compare& comp = Compare())
+      : comp_(comp) {
+    Assign(pairs);
+  }
+
+  FlatMap(std::initializer_list<std::pair<Key, Value>> pairs,
+          const Compare& comp = Compare())
+      : comp_(comp) {
+    Assign(pairs);
+  }
+
+  std::size_t size() const { return keys_.size(); }
+  bool empty() const { return keys_.empty(); }
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+  void reserve(std::size_t n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+
+  iterator begin() { return iterator(keys_.cbegin(), values_.begin()); }
+  iterator end() { return iterator(keys_.cend(), values_.end()); }
+  const_iterator begin() const {
+    return const_iterator(keys_.cbegin(), values_.cbegin());
+  }
+  const_iterator end() const {
+    return const_iterator(keys_.cend(), values_.cend());
+  }
+
+  // Returns the sorted keys as a contiguous range.
+  PtrRange<const Key> Keys() const {
+    return PtrRange<const Key>(keys_.data(), keys_.data() + keys_.size());
+  }
+
+  // Returns the values (in key order) as a contiguous range.
+  PtrRange<Value> Values() {
+    return PtrRange<Value>(values_.data(), values_.data() + values_.size());
+  }
+  PtrRange<const Value> Values() const {
+    return PtrRange<const Value>(values_.data(),
+                                 values_.data() + values_.size());
+  }
+
+  // Returns the index of the first key that is not less than key.
+  std::size_t LowerBoundIndex(const Key& key) const {
+    return flat_map_detail::BranchlessLowerBound(keys_.data(), keys_.size(),
+                                                 key, comp_) -
+           keys_.data();
+  }
+
+  // Returns the index of key, or size() if key is not in the map.
+  std::size_t FindIndex(const Key& key) const {
+    const std::size_t i = LowerBoundIndex(key);
+    return (i != keys_.size() && !comp_(key, keys_[i])) ? i : keys_.size();
+  }
+
+  iterator lower_bound(const Key& key) {
+    return IteratorAt(LowerBoundIndex(key));
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return IteratorAt(LowerBoundIndex(key));
+  }
+  iterator find(const Key& key) { return IteratorAt(FindIndex(key)); }
+  const_iterator find(const Key& key) const {
+    return IteratorAt(FindIndex(key));
+  }
+  bool contains(const Key& key) const { return FindIndex(key) != size(); }
+  std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+  // Returns a pointer to the value for key, or nullptr if key is not found.
+  Value* FindOrNull(const Key& key) {
+    const std::size_t i = FindIndex(key);
+    return i != size() ? &values_[i] : nullptr;
+  }
+  const Value* FindOrNull(const Key& key) const {
+    const std::size_t i = FindIndex(key);
+    return i != size() ? &values_[i] : nullptr;
+  }
+
+  // Inserts a value constructed from args if key is not in the map yet.
+  // Returns the iterator to the element for key, and whether it was inserted.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    const std::size_t i = LowerBoundIndex(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+      return {IteratorAt(i), false};
+    }
+    // Keeps keys_ and values_ the same size if either insertion throws.
+    values_.emplace(values_.begin() + i, std::forward<Args>(args)...);
+    try {
+      keys_.insert(keys_.begin() + i, key);
+    } catch (...) {
+      values_.erase(values_.begin() + i);
+      throw;
+    }
+    return {IteratorAt(i), true};
+  }
+
+  std::pair<iterator, bool> insert(const std::pair<Key, Value>& pair) {
+    return try_emplace(pair.first, pair.second);
+  }
+
+  // Inserts the value for key, or assigns it if key is in the map already.
+  template <typename OtherValue>
+  std::pair<iterator, bool> insert_or_assign(const Key& key,
+                                             OtherValue&& value) {
+    auto result = try_emplace(key, std::forward<OtherValue>(value));
+    if (!result.second) {
+      std::get<1>(*result.first) = std::forward<OtherValue>(value);
+    }
+    return result;
+  }
+
+  // Returns the value for key, inserting a default-constructed one if needed.
+  Value& operator[](const Key& key) {
+    return std::get<1>(*try_emplace(key).first);
+  }
+
+  // Removes key from the map. Returns the number of removed elements.
+  std::size_t erase(const Key& key) {
+    const std::size_t i = FindIndex(key);
+    if (i == keys_.size()) {
+      return 0;
+    }
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return 1;
+  }
+
+ private:
+  iterator IteratorAt(std::size_t i) {
+    return iterator(keys_.cbegin() + i, values_.begin() + i);
+  }
+  const_iterator IteratorAt(std::size_t i) const {
+    return const_iterator(keys_.cbegin() + i, values_.cbegin() + i);
+  }
+
+  template <typename Range>
+  void Assign(const Range& pairs) {
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    for (auto&& pair : pairs) {
+      keys.emplace_back(std::get<0>(pair));
+      values.emplace_back(std::get<1>(pair));
+    }
+
+    // Sort a permutation once, then gather keys and values in sorted order.
+    std::vector<std::size_t> order(keys.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys, this](std::size_t lhs, std::size_t rhs) {
+                       return comp_(keys[lhs], keys[rhs]);
+                     });
+
+    keys_.clear();
+    values_.clear();
+    reserve(order.size());
+    for (std::size_t i : order) {
+      if (!keys_.empty() && !comp_(keys_.back(), keys[i])) {
+        continue;  // Duplicate key, keep the first one.
+      }
+      keys_.push_back(std::move(keys[i]));
+      values_.push_back(std::move(values[i]));
+    }
+  }
+
+  std::vector<Key> keys_;
+  std::vector<Value> values_;
+  Compare comp_;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_FLAT_MAP_H_
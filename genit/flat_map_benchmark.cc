@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares lookups and iteration of FlatMap against std::map and
+// absl::btree_map for map sizes from 10^3 to 10^6.
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/container/btree_map.h"
+#include "benchmark/benchmark.h"
+#include "genit/flat_map.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumLookups = 1024;
+
+std::vector<std::pair<int64_t, int64_t>> MakePairs(int n) {
+  std::mt19937_64 rng(n);
+  std::vector<std::pair<int64_t, int64_t>> pairs;
+  pairs.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    pairs.emplace_back(rng(), i);
+  }
+  return pairs;
+}
+
+// Lookup keys: half hits, half misses, in random order.
+std::vector<int64_t> MakeLookupKeys(
+    const std::vector<std::pair<int64_t, int64_t>>& pairs) {
+  std::mt19937_64 rng(1);
+  std::vector<int64_t> keys;
+  for (int i = 0; i < kNumLookups; ++i) {
+    keys.push_back(i % 2 == 0 ? pairs[rng() % pairs.size()].first : rng());
+  }
+  return keys;
+}
+
+template <typename Map>
+void BM_Lookup(benchmark::State& state) {
+  const auto pairs = MakePairs(state.range(0));
+  const Map map(pairs.begin(), pairs.end());
+  const auto keys = MakeLookupKeys(pairs);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int64_t key : keys) {
+      const auto it = map.find(key);
+      if (it != map.end()) {
+        sum += it->second;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLookups);
+}
+
+void BM_FlatMapLookup(benchmark::State& state) {
+  const auto pairs = MakePairs(state.range(0));
+  const FlatMap<int64_t, int64_t> map(pairs);
+  const auto keys = MakeLookupKeys(pairs);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int64_t key : keys) {
+      if (const int64_t* value = map.FindOrNull(key)) {
+        sum += *value;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLookups);
+}
+
+template <typename Map>
+void BM_IterateValues(benchmark::State& state) {
+  const auto pairs = MakePairs(state.range(0));
+  const Map map(pairs.begin(), pairs.end());
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const auto& [key, value] : map) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * map.size());
+}
+
+void BM_FlatMapIterateValues(benchmark::State& state) {
+  const auto pairs = MakePairs(state.range(0));
+  const FlatMap<int64_t, int64_t> map(pairs);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int64_t value : map.Values()) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * map.size());
+}
+
+void BM_FlatMapBuild(benchmark::State& state) {
+  const auto pairs = MakePairs(state.range(0));
+  for (auto _ : state) {
+    FlatMap<int64_t, int64_t> map(pairs);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+
+template <typename Map>
+void BM_Build(benchmark::State& state) {
+  const auto pairs = MakePairs(state.range(0));
+  for (auto _ : state) {
+    Map map(pairs.begin(), pairs.end());
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+
+BENCHMARK(BM_FlatMapLookup)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Lookup<std::map<int64_t, int64_t>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Lookup<absl::btree_map<int64_t, int64_t>>)
+    ->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_FlatMapIterateValues)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_IterateValues<std::map<int64_t, int64_t>>)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_IterateValues<absl::btree_map<int64_t, int64_t>>)
+    ->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_FlatMapBuild)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Build<std::map<int64_t, int64_t>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Build<absl::btree_map<int64_t, int64_t>>)
+    ->Range(1 << 10, 1 << 20);
+
+}  // namespace
+}  // namespace genit
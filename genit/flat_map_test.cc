@@ -0,0 +1,157 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/flat_map.h"
+
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "genit/transform_iterator.h"
+#include "genit/zip_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FieldsAre;
+
+TEST(FlatMapTest, BranchlessLowerBound) {
+  const std::vector<int> keys = {1, 3, 3, 5, 7, 9, 11};
+  for (int key = 0; key <= 12; ++key) {
+    for (std::size_t n = 0; n <= keys.size(); ++n) {
+      EXPECT_EQ(flat_map_detail::BranchlessLowerBound(keys.data(), n, key,
+                                                      std::less<int>()),
+                std::lower_bound(keys.data(), keys.data() + n, key))
+          << "key = " << key << ", n = " << n;
+    }
+  }
+}
+
+TEST(FlatMapTest, ConstructFromInitializerList) {
+  const FlatMap<int, std::string> map = {{3, "c"}, {1, "a"}, {2, "b"}};
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_THAT(map.Keys(), ElementsAre(1, 2, 3));
+  EXPECT_THAT(map.Values(), ElementsAre("a", "b", "c"));
+  EXPECT_THAT(map, ElementsAre(FieldsAre(1, "a"), FieldsAre(2, "b"),
+                               FieldsAre(3, "c")));
+}
+
+TEST(FlatMapTest, ConstructFromZipRangeKeepsFirstDuplicate) {
+  const std::vector<int> keys = {5, 2, 5, 8, 2};
+  const std::vector<double> values = {0.5, 0.2, 1.5, 0.8, 1.2};
+  const FlatMap<int, double> map(ZipRange(keys, values));
+  EXPECT_THAT(map.Keys(), ElementsAre(2, 5, 8));
+  EXPECT_THAT(map.Values(), ElementsAre(0.2, 0.5, 0.8));
+}
+
+TEST(FlatMapTest, ConstructFromTransformedRange) {
+  const std::vector<int> xs = {4, 1, 3};
+  const FlatMap<int, int, std::greater<int>> map(
+      TransformRange(xs, [](int x) { return std::pair(x, x * x); }));
+  EXPECT_THAT(map.Keys(), ElementsAre(4, 3, 1));
+  EXPECT_THAT(map.Values(), ElementsAre(16, 9, 1));
+}
+
+TEST(FlatMapTest, Find) {
+  FlatMap<int, int> map = {{10, 1}, {20, 2}, {30, 3}};
+  EXPECT_TRUE(map.contains(20));
+  EXPECT_FALSE(map.contains(25));
+  EXPECT_EQ(map.count(30), 1);
+  EXPECT_EQ(map.find(25), map.end());
+  EXPECT_EQ(std::get<1>(*map.find(30)), 3);
+  EXPECT_EQ(std::get<0>(*map.lower_bound(15)), 20);
+  ASSERT_NE(map.FindOrNull(10), nullptr);
+  EXPECT_EQ(*map.FindOrNull(10), 1);
+  EXPECT_EQ(map.FindOrNull(0), nullptr);
+  EXPECT_EQ(map.FindIndex(40), map.size());
+
+  std::get<1>(*map.find(10)) = 100;
+  EXPECT_EQ(map[10], 100);
+}
+
+TEST(FlatMapTest, InsertAndErase) {
+  FlatMap<int, std::string> map;
+  EXPECT_TRUE(map.insert({2, "b"}).second);
+  EXPECT_TRUE(map.try_emplace(1, "a").second);
+  EXPECT_FALSE(map.insert({2, "x"}).second);
+  EXPECT_FALSE(map.insert_or_assign(1, "A").second);
+  EXPECT_TRUE(map.insert_or_assign(3, "C").second);
+  map[4] = "D";
+  EXPECT_THAT(map, ElementsAre(FieldsAre(1, "A"), FieldsAre(2, "b"),
+                               FieldsAre(3, "C"), FieldsAre(4, "D")));
+  EXPECT_EQ(map.erase(2), 1);
+  EXPECT_EQ(map.erase(2), 0);
+  EXPECT_THAT(map.Keys(), ElementsAre(1, 3, 4));
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+// Throws when constructed from a negative value.
+struct ThrowingValue {
+  explicit ThrowingValue(int v) : value(v) {
+    if (v < 0) {
+      throw std::invalid_argument("negative value");
+    }
+  }
+  int value;
+};
+
+TEST(FlatMapTest, ThrowingValueConstructorLeavesMapUnchanged) {
+  FlatMap<int, ThrowingValue> map;
+  map.try_emplace(1, 10);
+  map.try_emplace(3, 30);
+  EXPECT_THROW(map.try_emplace(2, -1), std::invalid_argument);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_THAT(map.Keys(), ElementsAre(1, 3));
+  EXPECT_EQ(map.FindOrNull(2), nullptr);
+  ASSERT_NE(map.FindOrNull(3), nullptr);
+  EXPECT_EQ(map.FindOrNull(3)->value, 30);
+  EXPECT_TRUE(map.try_emplace(2, 20).second);
+  EXPECT_EQ(map.FindOrNull(2)->value, 20);
+  EXPECT_EQ(map.FindOrNull(3)->value, 30);
+}
+
+TEST(FlatMapTest, MatchesStdMap) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 999);
+  std::vector<std::pair<int, int>> pairs;
+  std::map<int, int> expected;
+  for (int i = 0; i < 500; ++i) {
+    pairs.emplace_back(dist(rng), i);
+    expected.insert(pairs.back());
+  }
+  const FlatMap<int, int> map(pairs);
+  EXPECT_EQ(map.size(), expected.size());
+  for (int key = -1; key <= 1000; ++key) {
+    const auto it = expected.find(key);
+    const int* value = map.FindOrNull(key);
+    if (it == expected.end()) {
+      EXPECT_EQ(value, nullptr);
+    } else {
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*value, it->second);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace genit
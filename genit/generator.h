@@ -0,0 +1,346 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides Generator<T>, an input range whose elements are
+// produced by a coroutine, for stateful producers (decoders, tree walkers,
+// simulations) that are awkward to write as an IteratorFacade:
+//
+//   Generator<int> Fibonacci(int n) {
+//     int a = 0, b = 1;
+//     for (int i = 0; i < n; ++i) {
+//       co_yield a;
+//       a = std::exchange(b, a + b);
+//     }
+//   }
+//
+//   for (int x : FilterRange(Fibonacci(20), IsEven)) { ... }
+//
+// A generator can yield all the elements of another one with
+// co_yield ElementsOf(...), e.g., for recursive walks:
+//
+//   Generator<const Node*> InOrder(const Node* node) {
+//     if (node == nullptr) co_return;
+//     co_yield ElementsOf(InOrder(node->left));
+//     co_yield node;
+//     co_yield ElementsOf(InOrder(node->right));
+//   }
+//
+// The iterator resumes the innermost generator directly, so each element
+// costs O(1) whatever the nesting depth, and generators transfer control to
+// each other with symmetric transfer, which does not grow the stack when the
+// compiler turns it into a tail call (with optimizations).
+//
+// The coroutine frames are allocated from a thread-local pool of recycled
+// blocks (GeneratorFramePool), so creating a generator (e.g., one per node in
+// the example above) does not go through the global allocator in steady
+// state.
+//
+// The elements are yielded by reference (const T&) without copies, and stay
+// valid until the next increment. An exception thrown by a generator is
+// rethrown by the increment (or begin()), and by the co_yield ElementsOf in
+// the enclosing generators.
+//
+// Generators require C++20 coroutines: the header defines
+// GENIT_HAVE_COROUTINES when they are available, and is empty otherwise.
+
+#ifndef GENIT_GENERATOR_H_
+#define GENIT_GENERATOR_H_
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && \
+    defined(__has_include)
+#if __has_include(<coroutine>)
+#define GENIT_HAVE_COROUTINES 1
+#endif
+#endif
+
+#ifdef GENIT_HAVE_COROUTINES
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "genit/iterator_facade.h"
+
+namespace genit {
+
+// Thread-local free lists of coroutine frames, by size class. Frames larger
+// than kMaxPooledSize come from the global allocator.
+class GeneratorFramePool {
+ public:
+  static constexpr std::size_t kGranularity = 64;
+  static constexpr std::size_t kMaxPooledSize = 1024;
+  // The maximum number of free frames kept per size class and thread.
+  static constexpr int kMaxFreeFrames = 256;
+
+  static void* Allocate(std::size_t size) {
+    const std::size_t size_class = SizeClass(size);
+    if (size_class >= kNumClasses) {
+      return ::operator new(size);
+    }
+    FreeList& list = LocalFreeLists().lists[size_class];
+    if (list.head != nullptr) {
+      FreeFrame* frame = list.head;
+      list.head = frame->next;
+      --list.size;
+      return frame;
+    }
+    return ::operator new((size_class + 1) * kGranularity);
+  }
+
+  // size must be the size passed to Allocate. The frame may have been
+  // allocated by another thread.
+  static void Deallocate(void* ptr, std::size_t size) {
+    const std::size_t size_class = SizeClass(size);
+    if (size_class >= kNumClasses) {
+      ::operator delete(ptr);
+      return;
+    }
+    FreeList& list = LocalFreeLists().lists[size_class];
+    if (list.size == kMaxFreeFrames) {
+      ::operator delete(ptr);
+      return;
+    }
+    list.head = ::new (ptr) FreeFrame{list.head};
+    ++list.size;
+  }
+
+ private:
+  static constexpr std::size_t kNumClasses = kMaxPooledSize / kGranularity;
+
+  struct FreeFrame {
+    FreeFrame* next;
+  };
+  struct FreeList {
+    FreeFrame* head = nullptr;
+    int size = 0;
+  };
+  struct FreeLists {
+    ~FreeLists() {
+      for (FreeList& list : lists) {
+        while (list.head != nullptr) {
+          ::operator delete(std::exchange(list.head, list.head->next));
+        }
+      }
+    }
+    FreeList lists[kNumClasses];
+  };
+
+  static std::size_t SizeClass(std::size_t size) {
+    return (size - 1) / kGranularity;
+  }
+  static FreeLists& LocalFreeLists() {
+    thread_local FreeLists free_lists;
+    return free_lists;
+  }
+};
+
+template <typename T>
+class Generator;
+
+// Wraps a generator to yield all its elements from another one (see the top
+// of the file).
+template <typename T>
+struct GeneratorElementsOf {
+  Generator<T> generator;
+};
+
+template <typename T>
+GeneratorElementsOf<T> ElementsOf(Generator<T> generator) {
+  return GeneratorElementsOf<T>{std::move(generator)};
+}
+
+// Iterates over the elements of a Generator.
+template <typename T>
+class GeneratorIterator
+    : public IteratorFacade<GeneratorIterator<T>, const T&,
+                            std::input_iterator_tag> {
+ public:
+  using Handle = std::coroutine_handle<typename Generator<T>::promise_type>;
+
+  GeneratorIterator() = default;
+  explicit GeneratorIterator(Handle root) : root_(root) {}
+
+ private:
+  friend class IteratorFacadePrivateAccess<GeneratorIterator>;
+
+  const T& Dereference() const { return root_.promise().value(); }
+  void Increment() { root_.promise().Resume(); }
+  bool IsEqual(const GeneratorIterator& rhs) const {
+    return Done() == rhs.Done();
+  }
+  bool Done() const { return !root_ || root_.done(); }
+
+  Handle root_;
+};
+
+// A coroutine producing elements of type T (see the top of the file).
+template <typename T>
+class Generator {
+ public:
+  class promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+  using iterator = GeneratorIterator<T>;
+  using value_type = T;
+
+  class promise_type {
+   public:
+    Generator get_return_object() noexcept {
+      return Generator(Handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    // Resumes the parent, if any, when the coroutine ends.
+    struct FinalAwaiter {
+      bool await_ready() const noexcept { return false; }
+      std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+        promise_type& promise = handle.promise();
+        if (promise.parent_) {
+          promise.root_->leaf_ = promise.parent_;
+          return promise.parent_;
+        }
+        return std::noop_coroutine();
+      }
+      void await_resume() const noexcept {}
+    };
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    // The yielded value outlives the suspension: it is either a local of the
+    // coroutine, or a temporary of the full co_yield expression.
+    std::suspend_always yield_value(const T& value) noexcept {
+      root_->value_ = std::addressof(value);
+      return {};
+    }
+    std::suspend_always yield_value(T&& value) noexcept {
+      root_->value_ = std::addressof(value);
+      return {};
+    }
+
+    // Starts the nested generator, which yields until it ends and resumes
+    // this one.
+    struct NestedAwaiter {
+      bool await_ready() const noexcept { return !nested.handle_; }
+      std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+        promise_type& parent = handle.promise();
+        promise_type& child = nested.handle_.promise();
+        child.root_ = parent.root_;
+        child.parent_ = handle;
+        parent.root_->leaf_ = nested.handle_;
+        return nested.handle_;
+      }
+      void await_resume() {
+        if (!nested.handle_) {
+          return;
+        }
+        promise_type& root = *nested.handle_.promise().root_;
+        if (root.exception_) {
+          std::rethrow_exception(std::exchange(root.exception_, nullptr));
+        }
+      }
+
+      Generator nested;
+    };
+    NestedAwaiter yield_value(GeneratorElementsOf<T> elements) noexcept {
+      return NestedAwaiter{std::move(elements.generator)};
+    }
+
+    void return_void() const noexcept {}
+    void unhandled_exception() noexcept {
+      root_->exception_ = std::current_exception();
+    }
+
+    // Generators cannot co_await.
+    template <typename U>
+    std::suspend_never await_transform(U&&) = delete;
+
+    static void* operator new(std::size_t size) {
+      return GeneratorFramePool::Allocate(size);
+    }
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+      GeneratorFramePool::Deallocate(ptr, size);
+    }
+
+    // Root only: resumes the innermost generator, until its next element or
+    // the end.
+    void Resume() {
+      leaf_.resume();
+      if (exception_) {
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+      }
+    }
+    const T& value() const { return *value_; }
+
+   private:
+    friend class Generator;
+
+    // The outermost generator, which the iterator resumes, and the enclosing
+    // one (null for the root).
+    promise_type* root_ = this;
+    Handle parent_;
+    // Root only: the innermost running generator, the last yielded element,
+    // and the pending exception.
+    Handle leaf_ = Handle::from_promise(*this);
+    const T* value_ = nullptr;
+    std::exception_ptr exception_;
+    bool started_ = false;
+  };
+
+  Generator() = default;
+  Generator(Generator&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  Generator& operator=(Generator&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  ~Generator() { Reset(); }
+
+  // Runs the coroutine until its first element, on the first call. A
+  // generator can only be iterated once.
+  iterator begin() const {
+    if (handle_ && !handle_.promise().started_) {
+      handle_.promise().started_ = true;
+      handle_.promise().Resume();
+    }
+    return iterator(handle_);
+  }
+  iterator end() const { return iterator(); }
+
+ private:
+  explicit Generator(Handle handle) : handle_(handle) {}
+
+  // Destroys the frame, and those of the nested generators it owns.
+  void Reset() {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  Handle handle_;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_HAVE_COROUTINES
+
+#endif  // GENIT_GENERATOR_H_
@@ -0,0 +1,228 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares Generator with equivalent hand-written IteratorFacade iterators:
+// decoding LEB128 varints (a flat stateful producer), and walking a binary
+// tree in order (a recursive producer, with one nested generator per node,
+// against an iterator with an explicit stack). Also measures the creation of
+// short generators, whose frames come from the pool.
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/generator.h"
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+
+#ifdef GENIT_HAVE_COROUTINES
+
+namespace genit {
+namespace {
+
+constexpr int kNumValues = 1 << 16;
+
+std::vector<uint8_t> EncodeVarints() {
+  std::vector<uint8_t> bytes;
+  for (uint64_t i = 0; i < kNumValues; ++i) {
+    uint64_t value = i * i * 2654435761u >> (i % 48);
+    while (value >= 0x80) {
+      bytes.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+  }
+  return bytes;
+}
+
+Generator<uint64_t> DecodeVarints(const uint8_t* first, const uint8_t* last) {
+  while (first != last) {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = *first++;
+      value |= uint64_t{byte & 0x7fu} << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    co_yield value;
+  }
+}
+
+class VarintIterator
+    : public IteratorFacade<VarintIterator, const uint64_t&,
+                            std::forward_iterator_tag> {
+ public:
+  VarintIterator() = default;
+  explicit VarintIterator(const uint8_t* ptr) : next_(ptr) { Decode(); }
+
+ private:
+  friend class IteratorFacadePrivateAccess<VarintIterator>;
+
+  const uint64_t& Dereference() const { return value_; }
+  void Increment() { Decode(); }
+  bool IsEqual(const VarintIterator& rhs) const { return ptr_ == rhs.ptr_; }
+
+  void Decode() {
+    ptr_ = next_;
+    value_ = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = *next_++;
+      value_ |= uint64_t{byte & 0x7fu} << shift;
+      shift += 7;
+    } while (byte & 0x80);
+  }
+
+  // The start of the current varint, and of the next one.
+  const uint8_t* ptr_ = nullptr;
+  const uint8_t* next_ = nullptr;
+  uint64_t value_ = 0;
+};
+
+void BM_VarintsGenerator(benchmark::State& state) {
+  const auto bytes = EncodeVarints();
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (uint64_t value :
+         DecodeVarints(bytes.data(), bytes.data() + bytes.size())) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_VarintsIteratorFacade(benchmark::State& state) {
+  auto bytes = EncodeVarints();
+  const std::size_t size = bytes.size();
+  // The end iterator decodes a sentinel varint past the end.
+  bytes.push_back(0);
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (uint64_t value :
+         MakeIteratorRange(VarintIterator(bytes.data()),
+                           VarintIterator(bytes.data() + size))) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+struct Node {
+  int value;
+  std::unique_ptr<Node> left;
+  std::unique_ptr<Node> right;
+};
+
+std::unique_ptr<Node> MakeTree(int first, int last) {
+  if (first == last) {
+    return nullptr;
+  }
+  const int mid = first + (last - first) / 2;
+  return std::unique_ptr<Node>(
+      new Node{mid, MakeTree(first, mid), MakeTree(mid + 1, last)});
+}
+
+Generator<int> InOrder(const Node* node) {
+  if (node->left != nullptr) {
+    co_yield ElementsOf(InOrder(node->left.get()));
+  }
+  co_yield node->value;
+  if (node->right != nullptr) {
+    co_yield ElementsOf(InOrder(node->right.get()));
+  }
+}
+
+// In-order iterator with an explicit stack of the ancestors to visit.
+class InOrderIterator
+    : public IteratorFacade<InOrderIterator, const int&,
+                            std::forward_iterator_tag> {
+ public:
+  InOrderIterator() = default;
+  explicit InOrderIterator(const Node* root) { PushLeftSpine(root); }
+
+ private:
+  friend class IteratorFacadePrivateAccess<InOrderIterator>;
+
+  const int& Dereference() const { return stack_.back()->value; }
+  void Increment() {
+    const Node* node = stack_.back();
+    stack_.pop_back();
+    PushLeftSpine(node->right.get());
+  }
+  bool IsEqual(const InOrderIterator& rhs) const {
+    return stack_.empty() == rhs.stack_.empty();
+  }
+
+  void PushLeftSpine(const Node* node) {
+    for (; node != nullptr; node = node->left.get()) {
+      stack_.push_back(node);
+    }
+  }
+
+  std::vector<const Node*> stack_;
+};
+
+void BM_TreeGenerator(benchmark::State& state) {
+  const auto tree = MakeTree(0, kNumValues);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int value : InOrder(tree.get())) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_TreeIteratorFacade(benchmark::State& state) {
+  const auto tree = MakeTree(0, kNumValues);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int value : MakeIteratorRange(InOrderIterator(tree.get()),
+                                       InOrderIterator())) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+Generator<int> Single(int value) { co_yield value; }
+
+void BM_CreateGenerator(benchmark::State& state) {
+  int i = 0;
+  for (auto _ : state) {
+    for (int value : Single(i++)) {
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_VarintsGenerator);
+BENCHMARK(BM_VarintsIteratorFacade);
+BENCHMARK(BM_TreeGenerator);
+BENCHMARK(BM_TreeIteratorFacade);
+BENCHMARK(BM_CreateGenerator);
+
+}  // namespace
+}  // namespace genit
+
+#endif  // GENIT_HAVE_COROUTINES
@@ -0,0 +1,222 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/generator.h"
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/filter_iterator.h"
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+#ifdef GENIT_HAVE_COROUTINES
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+Generator<int> Fibonacci(int n) {
+  int a = 0;
+  int b = 1;
+  for (int i = 0; i < n; ++i) {
+    co_yield a;
+    a = std::exchange(b, a + b);
+  }
+}
+
+template <typename Range>
+std::vector<std::decay_t<decltype(*std::begin(std::declval<Range&>()))>>
+ToVector(Range&& range) {
+  std::vector<std::decay_t<decltype(*std::begin(range))>> values;
+  for (auto&& value : range) {
+    values.push_back(value);
+  }
+  return values;
+}
+
+TEST(GeneratorTest, YieldsValues) {
+  EXPECT_THAT(ToVector(Fibonacci(8)), ElementsAre(0, 1, 1, 2, 3, 5, 8, 13));
+  EXPECT_THAT(ToVector(Fibonacci(0)), IsEmpty());
+  using It = Generator<int>::iterator;
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::input_iterator_tag>));
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::reference,
+                              const int&>));
+}
+
+Generator<std::string> Words() {
+  std::string word = "lvalue";
+  co_yield word;
+  co_yield std::string("temporary");
+  co_yield "converted";
+}
+
+TEST(GeneratorTest, YieldsLvaluesAndTemporaries) {
+  EXPECT_THAT(ToVector(Words()),
+              ElementsAre("lvalue", "temporary", "converted"));
+}
+
+TEST(GeneratorTest, ComposesWithAdapters) {
+  const auto even_squares = TransformRange(
+      FilterRange(Fibonacci(10), [](int x) { return x % 2 == 0; }),
+      [](int x) { return x * x; });
+  EXPECT_THAT(ToVector(even_squares), ElementsAre(0, 4, 64, 1156));
+}
+
+TEST(GeneratorTest, IsMoveOnly) {
+  Generator<int> a = Fibonacci(3);
+  Generator<int> b = std::move(a);
+  EXPECT_TRUE(a.begin() == a.end());
+  a = std::move(b);
+  EXPECT_THAT(ToVector(a), ElementsAre(0, 1, 1));
+  EXPECT_FALSE(std::is_copy_constructible_v<Generator<int>>);
+}
+
+struct Node {
+  int value;
+  std::unique_ptr<Node> left;
+  std::unique_ptr<Node> right;
+};
+
+std::unique_ptr<Node> MakeTree(int first, int last) {
+  if (first == last) {
+    return nullptr;
+  }
+  const int mid = first + (last - first) / 2;
+  return std::unique_ptr<Node>(
+      new Node{mid, MakeTree(first, mid), MakeTree(mid + 1, last)});
+}
+
+Generator<int> InOrder(const Node* node) {
+  if (node == nullptr) {
+    co_return;
+  }
+  co_yield ElementsOf(InOrder(node->left.get()));
+  co_yield node->value;
+  co_yield ElementsOf(InOrder(node->right.get()));
+}
+
+TEST(GeneratorTest, YieldsNestedGenerators) {
+  const auto tree = MakeTree(0, 100);
+  const std::vector<int> values = ToVector(InOrder(tree.get()));
+  ASSERT_EQ(values.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+Generator<int> Countdown(int n) {
+  if (n == 0) {
+    co_return;
+  }
+  co_yield n;
+  co_yield ElementsOf(Countdown(n - 1));
+}
+
+TEST(GeneratorTest, DeepNesting) {
+  // Each element is one resumption of the innermost generator, and each
+  // generator ends with a transfer to its parent.
+  int expected = 10000;
+  for (int value : Countdown(10000)) {
+    ASSERT_EQ(value, expected--);
+  }
+  EXPECT_EQ(expected, 0);
+}
+
+TEST(GeneratorTest, DestroysUnfinishedNestedGenerators) {
+  const auto tree = MakeTree(0, 100);
+  int count = 0;
+  for (int value : InOrder(tree.get())) {
+    if (value == 42) {
+      break;
+    }
+    ++count;
+  }
+  EXPECT_EQ(count, 42);
+}
+
+Generator<int> Throwing(int n) {
+  for (int i = 0; i < n; ++i) {
+    co_yield i;
+  }
+  throw std::runtime_error("decoding error");
+}
+
+TEST(GeneratorTest, PropagatesExceptions) {
+  std::vector<int> values;
+  EXPECT_THROW(
+      {
+        for (int value : Throwing(3)) {
+          values.push_back(value);
+        }
+      },
+      std::runtime_error);
+  EXPECT_THAT(values, ElementsAre(0, 1, 2));
+}
+
+Generator<int> Recovering() {
+  bool failed = false;
+  try {
+    co_yield ElementsOf(Throwing(2));
+  } catch (const std::runtime_error&) {
+    failed = true;
+  }
+  if (failed) {
+    co_yield -1;
+  }
+  co_yield ElementsOf(Throwing(1));
+}
+
+TEST(GeneratorTest, PropagatesExceptionsThroughNestedGenerators) {
+  std::vector<int> values;
+  EXPECT_THROW(
+      {
+        for (int value : Recovering()) {
+          values.push_back(value);
+        }
+      },
+      std::runtime_error);
+  EXPECT_THAT(values, ElementsAre(0, 1, -1, 0));
+}
+
+TEST(GeneratorFramePoolTest, RecyclesFrames) {
+  void* a = GeneratorFramePool::Allocate(100);
+  GeneratorFramePool::Deallocate(a, 100);
+  // Same size class.
+  void* b = GeneratorFramePool::Allocate(120);
+  EXPECT_EQ(a, b);
+  GeneratorFramePool::Deallocate(b, 120);
+  void* large = GeneratorFramePool::Allocate(4096);
+  GeneratorFramePool::Deallocate(large, 4096);
+}
+
+#else  // GENIT_HAVE_COROUTINES
+
+TEST(GeneratorTest, RequiresCoroutines) {
+  GTEST_SKIP() << "Generator requires C++20 coroutines.";
+}
+
+#endif  // GENIT_HAVE_COROUTINES
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides IncrementalFilteredRange, a filtered view over an
+// append-only source (e.g., a std::vector, std::deque, ChunkedVector or
+// AppendOnlyLog that is only ever appended to), which remembers the matches
+// it has found. Refresh() evaluates the predicate on the elements appended
+// since the previous call only, so filtering a growing history every frame
+// costs O(new elements) instead of O(all elements) with FilterRange:
+//
+//   auto hits = IncrementalFilterRange(history, IsHit);
+//   while (...) {  // Every frame:
+//     history.push_back(...);
+//     hits.Refresh();
+//     for (const Event& e : hits) { ... }
+//     const Event& latest = hits[hits.size() - 1];
+//   }
+//
+// The matches are stored as indices in the source, so the source may
+// reallocate its elements, and the view is a random-access range with an
+// O(1) size(). Its iterators stay valid across refreshes.
+//
+// The source must outlive the view and support size() and operator[]. Its
+// elements must not change after they were scanned. The view itself is not
+// thread-safe, but the source may be appended by another thread if it
+// supports it (e.g., an AppendOnlyLog): Refresh() then scans the elements
+// published when it is called.
+
+#ifndef GENIT_INCREMENTAL_FILTER_RANGE_H_
+#define GENIT_INCREMENTAL_FILTER_RANGE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+template <typename Source, typename Predicate>
+class IncrementalFilteredRange {
+ public:
+  using reference = decltype(std::declval<const Source&>()[0]);
+  using value_type = std::decay_t<reference>;
+  using size_type = std::size_t;
+
+  // Random-access iterator over the matches found so far.
+  class Iterator : public IteratorFacade<Iterator, reference,
+                                         std::random_access_iterator_tag> {
+   public:
+    Iterator() = default;
+    Iterator(const IncrementalFilteredRange* range, std::size_t index)
+        : range_(range), index_(index) {}
+
+   private:
+    friend class IteratorFacadePrivateAccess<Iterator>;
+
+    // Implementation of the IteratorFacade requirements:
+    reference Dereference() const { return (*range_)[index_]; }
+    void Increment() { ++index_; }
+    void Decrement() { --index_; }
+    bool IsEqual(const Iterator& rhs) const { return index_ == rhs.index_; }
+    int DistanceTo(const Iterator& rhs) const {
+      return static_cast<int>(rhs.index_) - static_cast<int>(index_);
+    }
+    void Advance(int n) { index_ += n; }
+
+    const IncrementalFilteredRange* range_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  // Scans the elements of the source present at construction.
+  template <typename OtherPredicate>
+  IncrementalFilteredRange(const Source& source, OtherPredicate&& pred)
+      : source_(&source), pred_(std::forward<OtherPredicate>(pred)) {
+    Refresh();
+  }
+
+  // Not copyable or movable: the iterators refer to the view by address.
+  IncrementalFilteredRange(const IncrementalFilteredRange&) = delete;
+  IncrementalFilteredRange& operator=(const IncrementalFilteredRange&) =
+      delete;
+
+  // Evaluates the predicate on the elements appended to the source since the
+  // previous call, and returns the number of new matches.
+  std::size_t Refresh() {
+    const std::size_t n = source_->size();
+    assert(n >= num_scanned_ && "the source must only be appended to");
+    const std::size_t num_matches = matches_.size();
+    for (std::size_t i = num_scanned_; i < n; ++i) {
+      if (pred_((*source_)[i])) {
+        matches_.push_back(i);
+      }
+    }
+    num_scanned_ = n;
+    return matches_.size() - num_matches;
+  }
+
+  // The number of matches found so far, and the i-th one.
+  std::size_t size() const { return matches_.size(); }
+  bool empty() const { return matches_.empty(); }
+  reference operator[](std::size_t i) const {
+    return (*source_)[matches_[i]];
+  }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, matches_.size()); }
+
+  // The indices of the matches in the source, in increasing order.
+  PtrRange<const std::size_t> indices() const {
+    return PtrRange<const std::size_t>(matches_.data(),
+                                       matches_.data() + matches_.size());
+  }
+
+  // The number of elements of the source scanned so far.
+  std::size_t num_scanned() const { return num_scanned_; }
+
+ private:
+  const Source* source_;
+  Predicate pred_;
+  std::size_t num_scanned_ = 0;
+  std::vector<std::size_t> matches_;
+};
+
+// Returns an IncrementalFilteredRange of the source, which must be an lvalue
+// that outlives the view.
+template <typename Source, typename Predicate>
+auto IncrementalFilterRange(const Source& source, Predicate&& pred) {
+  return IncrementalFilteredRange<Source, std::decay_t<Predicate>>(
+      source, std::forward<Predicate>(pred));
+}
+template <typename Source, typename Predicate>
+void IncrementalFilterRange(const Source&& source, Predicate&& pred) = delete;
+
+}  // namespace genit
+
+#endif  // GENIT_INCREMENTAL_FILTER_RANGE_H_
@@ -0,0 +1,73 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Simulates frames that each append kFrameSize values to a history, and then
+// count the matches of a predicate over the whole history, by rescanning it
+// with a FilterRange, and with an IncrementalFilteredRange. Reports the time
+// per frame for a number of frames given as the argument.
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/filter_iterator.h"
+#include "genit/incremental_filter_range.h"
+
+namespace genit {
+namespace {
+
+constexpr int kFrameSize = 1024;
+
+bool IsHit(uint32_t x) { return (x & 15) == 0; }
+
+void AppendFrame(int frame, std::vector<uint32_t>* history) {
+  for (int i = 0; i < kFrameSize; ++i) {
+    history->push_back(static_cast<uint32_t>(frame * kFrameSize + i) *
+                       2654435761u);
+  }
+}
+
+void BM_RescanFilterRange(benchmark::State& state) {
+  const int num_frames = state.range(0);
+  for (auto _ : state) {
+    std::vector<uint32_t> history;
+    for (int frame = 0; frame < num_frames; ++frame) {
+      AppendFrame(frame, &history);
+      const auto hits = FilterRange(history, IsHit);
+      benchmark::DoNotOptimize(std::distance(hits.begin(), hits.end()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_frames);
+}
+
+void BM_IncrementalFilterRange(benchmark::State& state) {
+  const int num_frames = state.range(0);
+  for (auto _ : state) {
+    std::vector<uint32_t> history;
+    auto hits = IncrementalFilterRange(history, IsHit);
+    for (int frame = 0; frame < num_frames; ++frame) {
+      AppendFrame(frame, &history);
+      hits.Refresh();
+      benchmark::DoNotOptimize(hits.size());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_frames);
+}
+
+BENCHMARK(BM_RescanFilterRange)->Arg(16)->Arg(256);
+BENCHMARK(BM_IncrementalFilterRange)->Arg(16)->Arg(256);
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,121 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/incremental_filter_range.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "genit/append_only_log.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+bool IsEven(int x) { return x % 2 == 0; }
+
+TEST(IncrementalFilterRangeTest, ScansNewElementsOnly) {
+  std::vector<int> history = {1, 2, 3, 4};
+  int num_calls = 0;
+  auto evens = IncrementalFilterRange(history, [&num_calls](int x) {
+    ++num_calls;
+    return IsEven(x);
+  });
+  EXPECT_EQ(num_calls, 4);
+  EXPECT_THAT(evens, ElementsAre(2, 4));
+
+  // Reallocates the history.
+  for (int i = 5; i <= 100; ++i) {
+    history.push_back(i);
+  }
+  EXPECT_EQ(evens.Refresh(), 48);
+  EXPECT_EQ(num_calls, 100);
+  EXPECT_EQ(evens.num_scanned(), 100);
+  ASSERT_EQ(evens.size(), 50);
+  EXPECT_EQ(evens[49], 100);
+
+  EXPECT_EQ(evens.Refresh(), 0);
+  EXPECT_EQ(num_calls, 100);
+}
+
+TEST(IncrementalFilterRangeTest, IsRandomAccess) {
+  std::deque<int> history = {1, 2, 3, 4, 5, 6};
+  auto evens = IncrementalFilterRange(history, IsEven);
+  using It = decltype(evens.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::reference,
+                              const int&>));
+  EXPECT_EQ(evens.end() - evens.begin(), 3);
+  EXPECT_EQ(evens.begin()[2], 6);
+  EXPECT_TRUE(std::binary_search(evens.begin(), evens.end(), 4));
+  EXPECT_THAT(evens.indices(), ElementsAre(1, 3, 5));
+}
+
+TEST(IncrementalFilterRangeTest, IteratorsStayValid) {
+  std::vector<std::string> history = {"a", "bb"};
+  auto long_words = IncrementalFilterRange(
+      history, [](const std::string& s) { return s.size() > 1; });
+  const auto first = long_words.begin();
+  const auto last = long_words.end();
+  history.push_back("ccc");
+  history.push_back("d");
+  long_words.Refresh();
+  EXPECT_EQ(*first, "bb");
+  EXPECT_EQ(last - first, 1);
+  EXPECT_EQ(long_words.end() - first, 2);
+  EXPECT_EQ(*last, "ccc");
+}
+
+TEST(IncrementalFilterRangeTest, Empty) {
+  std::vector<int> history;
+  auto evens = IncrementalFilterRange(history, IsEven);
+  EXPECT_TRUE(evens.empty());
+  EXPECT_THAT(evens, IsEmpty());
+  history.push_back(1);
+  EXPECT_EQ(evens.Refresh(), 0);
+  EXPECT_TRUE(evens.empty());
+}
+
+TEST(IncrementalFilterRangeTest, ConcurrentAppendOnlyLog) {
+  constexpr int kNumValues = 100000;
+  AppendOnlyLog<int> log;
+  std::thread writer([&log] {
+    for (int i = 0; i < kNumValues; ++i) {
+      log.push_back(i);
+    }
+  });
+  auto evens = IncrementalFilterRange(log, IsEven);
+  while (evens.num_scanned() < kNumValues) {
+    evens.Refresh();
+    // The matches are the even values of the scanned prefix.
+    ASSERT_EQ(evens.size(), (evens.num_scanned() + 1) / 2);
+  }
+  writer.join();
+  for (int i = 0; i < kNumValues / 2; ++i) {
+    ASSERT_EQ(evens[i], 2 * i);
+  }
+}
+
+}  // namespace
+}  // namespace genit
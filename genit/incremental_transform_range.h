@@ -0,0 +1,157 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides IncrementalTransformedRange, which stores the
+// results of a function over a random-access source, and recomputes only the
+// results of the elements marked as changed. Unlike TransformRange, which
+// calls the function on every access, it suits expensive functions over
+// inputs that mostly do not change between frames:
+//
+//   auto poses = IncrementalTransformRange(joints, ForwardKinematics);
+//   while (...) {  // Every frame:
+//     joints[i].angle = ...;
+//     poses.MarkDirty(i);
+//     poses.Refresh();
+//     for (const Pose& pose : poses) { ... }
+//   }
+//
+// Changes are tracked in a bitset with one bit per block of kBlockSize
+// elements (1 by default), and Refresh() recomputes the dirty blocks. Larger
+// blocks make the bitset smaller, but recompute the unchanged elements of
+// the dirty blocks: they only pay off for large sources whose changes are
+// clustered in runs of about kBlockSize elements. With an expensive function
+// and scattered changes, single-element blocks recompute the least.
+//
+// Elements appended to (or removed from) the source since the previous
+// Refresh() are computed (or removed) without being marked. The results are
+// only updated by Refresh(): accessing them in between returns the results
+// of the previous one.
+//
+// The source must outlive the range and support size() and operator[].
+
+#ifndef GENIT_INCREMENTAL_TRANSFORM_RANGE_H_
+#define GENIT_INCREMENTAL_TRANSFORM_RANGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+template <typename Source, typename UnaryFunc, std::size_t kBlockSize = 1>
+class IncrementalTransformedRange {
+  static_assert(kBlockSize > 0, "kBlockSize must be positive");
+
+ public:
+  using value_type = std::decay_t<decltype(std::declval<const UnaryFunc&>()(
+      std::declval<const Source&>()[0]))>;
+  using reference = const value_type&;
+  using size_type = std::size_t;
+  using iterator = typename std::vector<value_type>::const_iterator;
+  using const_iterator = iterator;
+
+  // Computes the results of the elements of the source present at
+  // construction.
+  template <typename OtherFunc>
+  IncrementalTransformedRange(const Source& source, OtherFunc&& f)
+      : source_(&source), f_(std::forward<OtherFunc>(f)) {
+    Refresh();
+  }
+
+  // Marks the element at index i of the source as changed.
+  void MarkDirty(std::size_t i) { MarkBlockDirty(i / kBlockSize); }
+  // Marks the elements in [first, last) as changed.
+  void MarkDirty(std::size_t first, std::size_t last) {
+    if (first < last) {
+      for (std::size_t block = first / kBlockSize;
+           block <= (last - 1) / kBlockSize; ++block) {
+        MarkBlockDirty(block);
+      }
+    }
+  }
+  void MarkAllDirty() { MarkDirty(0, results_.size()); }
+
+  // Recomputes the results of the dirty blocks and of the elements appended
+  // to the source, and returns the number of results computed.
+  std::size_t Refresh() {
+    const std::size_t n = source_->size();
+    const std::size_t num_kept = std::min(n, results_.size());
+    std::size_t num_computed = n - num_kept;
+    for (std::size_t w = 0; w < dirty_.size(); ++w) {
+      for (uint64_t word = std::exchange(dirty_[w], 0); word != 0;
+           word &= word - 1) {
+        const std::size_t first = (w * 64 + __builtin_ctzll(word)) * kBlockSize;
+        const std::size_t last = std::min(first + kBlockSize, num_kept);
+        for (std::size_t i = first; i < last; ++i) {
+          results_[i] = f_((*source_)[i]);
+        }
+        num_computed += last > first ? last - first : 0;
+      }
+    }
+    results_.erase(results_.begin() + num_kept, results_.end());
+    results_.reserve(n);
+    for (std::size_t i = num_kept; i < n; ++i) {
+      results_.push_back(f_((*source_)[i]));
+    }
+    return num_computed;
+  }
+
+  // The results as of the last Refresh().
+  std::size_t size() const { return results_.size(); }
+  bool empty() const { return results_.empty(); }
+  reference operator[](std::size_t i) const { return results_[i]; }
+  iterator begin() const { return results_.begin(); }
+  iterator end() const { return results_.end(); }
+  PtrRange<const value_type> results() const {
+    return PtrRange<const value_type>(results_.data(),
+                                      results_.data() + results_.size());
+  }
+
+ private:
+  void MarkBlockDirty(std::size_t block) {
+    const std::size_t w = block / 64;
+    if (w >= dirty_.size()) {
+      dirty_.resize(w + 1);
+    }
+    dirty_[w] |= uint64_t{1} << (block % 64);
+  }
+
+  const Source* source_;
+  UnaryFunc f_;
+  std::vector<value_type> results_;
+  // One bit per block of kBlockSize elements.
+  std::vector<uint64_t> dirty_;
+};
+
+// Returns an IncrementalTransformedRange of the source, which must be an
+// lvalue that outlives the range.
+template <std::size_t kBlockSize = 1, typename Source, typename UnaryFunc>
+auto IncrementalTransformRange(const Source& source, UnaryFunc&& f) {
+  return IncrementalTransformedRange<Source, std::decay_t<UnaryFunc>,
+                                     kBlockSize>(source,
+                                                 std::forward<UnaryFunc>(f));
+}
+template <std::size_t kBlockSize = 1, typename Source, typename UnaryFunc>
+void IncrementalTransformRange(const Source&& source, UnaryFunc&& f) = delete;
+
+}  // namespace genit
+
+#endif  // GENIT_INCREMENTAL_TRANSFORM_RANGE_H_
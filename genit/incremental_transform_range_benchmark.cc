@@ -0,0 +1,137 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Simulates frames that each change a fraction (the argument, per thousand) of
+// the joint angles of a chain, and then use the rotation matrix of every
+// joint. Compares recomputing all the matrices with a TransformRange, and
+// maintaining them with IncrementalTransformRange for several block sizes.
+// The changed joints are either scattered uniformly, or clustered in runs of
+// 16 consecutive joints.
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/incremental_transform_range.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumJoints = 4096;
+constexpr int kNumFrames = 64;
+constexpr int kRunLength = 16;
+
+struct Angles {
+  double roll, pitch, yaw;
+};
+
+struct Rotation {
+  double m[3][3];
+};
+
+Rotation ToRotation(const Angles& a) {
+  const double cr = std::cos(a.roll), sr = std::sin(a.roll);
+  const double cp = std::cos(a.pitch), sp = std::sin(a.pitch);
+  const double cy = std::cos(a.yaw), sy = std::sin(a.yaw);
+  return Rotation{{{cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+                   {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+                   {-sp, cp * sr, cp * cr}}};
+}
+
+// The indices of the joints changed in each frame.
+std::vector<std::vector<int>> MakeChanges(int per_thousand, bool clustered) {
+  std::mt19937 rng(42);
+  std::vector<std::vector<int>> changes(kNumFrames);
+  const int num_changes = kNumJoints * per_thousand / 1000;
+  for (auto& frame : changes) {
+    if (clustered) {
+      std::uniform_int_distribution<int> run(0, kNumJoints / kRunLength - 1);
+      for (int i = 0; i < num_changes; i += kRunLength) {
+        const int first = run(rng) * kRunLength;
+        for (int j = 0; j < kRunLength && i + j < num_changes; ++j) {
+          frame.push_back(first + j);
+        }
+      }
+    } else {
+      std::uniform_int_distribution<int> joint(0, kNumJoints - 1);
+      for (int i = 0; i < num_changes; ++i) {
+        frame.push_back(joint(rng));
+      }
+    }
+  }
+  return changes;
+}
+
+double Use(const Rotation& r) { return r.m[0][0] + r.m[2][1]; }
+
+void BM_TransformRange(benchmark::State& state) {
+  const auto changes = MakeChanges(state.range(0), state.range(1));
+  std::vector<Angles> joints(kNumJoints, Angles{0.1, 0.2, 0.3});
+  const auto rotations = TransformRange(joints, ToRotation);
+  for (auto _ : state) {
+    for (const auto& frame : changes) {
+      for (int i : frame) {
+        joints[i].yaw += 0.01;
+      }
+      double sum = 0;
+      for (const Rotation& r : rotations) {
+        sum += Use(r);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumFrames);
+}
+
+template <std::size_t kBlockSize>
+void BM_IncrementalTransformRange(benchmark::State& state) {
+  const auto changes = MakeChanges(state.range(0), state.range(1));
+  std::vector<Angles> joints(kNumJoints, Angles{0.1, 0.2, 0.3});
+  auto rotations = IncrementalTransformRange<kBlockSize>(joints, ToRotation);
+  for (auto _ : state) {
+    for (const auto& frame : changes) {
+      for (int i : frame) {
+        joints[i].yaw += 0.01;
+        rotations.MarkDirty(i);
+      }
+      rotations.Refresh();
+      double sum = 0;
+      for (const Rotation& r : rotations) {
+        sum += Use(r);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumFrames);
+}
+
+void ChangeRates(benchmark::internal::Benchmark* b) {
+  for (int clustered : {0, 1}) {
+    for (int per_thousand : {10, 100, 1000}) {
+      b->Args({per_thousand, clustered});
+    }
+  }
+  b->ArgNames({"per_thousand", "clustered"});
+}
+
+BENCHMARK(BM_TransformRange)->Apply(ChangeRates);
+BENCHMARK_TEMPLATE(BM_IncrementalTransformRange, 1)->Apply(ChangeRates);
+BENCHMARK_TEMPLATE(BM_IncrementalTransformRange, 16)->Apply(ChangeRates);
+BENCHMARK_TEMPLATE(BM_IncrementalTransformRange, 64)->Apply(ChangeRates);
+
+}  // namespace
+}  // namespace genit
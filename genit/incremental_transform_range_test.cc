@@ -0,0 +1,120 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/incremental_transform_range.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(IncrementalTransformRangeTest, RecomputesDirtyBlocks) {
+  std::vector<int> inputs(10);
+  for (int i = 0; i < 10; ++i) {
+    inputs[i] = i;
+  }
+  int num_calls = 0;
+  auto squares = IncrementalTransformRange<4>(inputs, [&num_calls](int x) {
+    ++num_calls;
+    return x * x;
+  });
+  EXPECT_EQ(num_calls, 10);
+  EXPECT_THAT(squares, ElementsAre(0, 1, 4, 9, 16, 25, 36, 49, 64, 81));
+
+  // Not marked: not recomputed.
+  inputs[0] = 10;
+  inputs[5] = 11;
+  EXPECT_EQ(squares.Refresh(), 0);
+  EXPECT_EQ(squares[0], 0);
+
+  // Recomputes the block [4, 8) of element 5.
+  num_calls = 0;
+  squares.MarkDirty(5);
+  squares.MarkDirty(6);
+  EXPECT_EQ(squares.Refresh(), 4);
+  EXPECT_EQ(num_calls, 4);
+  EXPECT_THAT(squares, ElementsAre(0, 1, 4, 9, 16, 121, 36, 49, 64, 81));
+
+  // The last block is partial.
+  num_calls = 0;
+  squares.MarkDirty(0);
+  squares.MarkDirty(9);
+  EXPECT_EQ(squares.Refresh(), 6);
+  EXPECT_EQ(num_calls, 6);
+  EXPECT_EQ(squares[0], 100);
+}
+
+TEST(IncrementalTransformRangeTest, MarksRanges) {
+  std::deque<std::string> inputs = {"a", "b", "c", "d", "e"};
+  auto upper = IncrementalTransformRange<2>(inputs, [](const std::string& s) {
+    return std::string(1, s[0] - 'a' + 'A');
+  });
+  for (auto& s : inputs) {
+    s = "z";
+  }
+  upper.MarkDirty(1, 3);
+  EXPECT_EQ(upper.Refresh(), 4);
+  EXPECT_THAT(upper, ElementsAre("Z", "Z", "Z", "Z", "E"));
+  upper.MarkDirty(2, 2);
+  EXPECT_EQ(upper.Refresh(), 0);
+  upper.MarkAllDirty();
+  EXPECT_EQ(upper.Refresh(), 5);
+  EXPECT_THAT(upper.results(), ElementsAre("Z", "Z", "Z", "Z", "Z"));
+}
+
+TEST(IncrementalTransformRangeTest, FollowsSourceSize) {
+  std::vector<int> inputs = {1, 2, 3};
+  auto doubled = IncrementalTransformRange<1>(inputs,
+                                              [](int x) { return 2 * x; });
+  inputs.push_back(4);
+  inputs.push_back(5);
+  EXPECT_EQ(doubled.Refresh(), 2);
+  EXPECT_THAT(doubled, ElementsAre(2, 4, 6, 8, 10));
+
+  // Dirty blocks past the new end are ignored.
+  inputs.resize(2);
+  inputs[1] = 7;
+  doubled.MarkDirty(1);
+  doubled.MarkDirty(4);
+  EXPECT_EQ(doubled.Refresh(), 1);
+  EXPECT_THAT(doubled, ElementsAre(2, 14));
+
+  inputs.clear();
+  doubled.Refresh();
+  EXPECT_THAT(doubled, IsEmpty());
+}
+
+TEST(IncrementalTransformRangeTest, ManyBlocks) {
+  std::vector<int> inputs(1000, 1);
+  auto negated = IncrementalTransformRange<1>(inputs, [](int x) { return -x; });
+  for (int i = 0; i < 1000; i += 7) {
+    inputs[i] = 2;
+    negated.MarkDirty(i);
+  }
+  EXPECT_EQ(negated.Refresh(), 143);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(negated[i], i % 7 == 0 ? -2 : -1) << i;
+  }
+}
+
+}  // namespace
+}  // namespace genit
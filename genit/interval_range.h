@@ -0,0 +1,398 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides ranges over sequences of half-open intervals
+// [begin, end), given as pair-like elements (std::pair, std::tuple, or
+// anything that supports std::get<0> and std::get<1>):
+//
+//  - CoalesceIntervals merges overlapping (or touching) intervals of a range
+//    sorted by begin, lazily and in a single pass.
+//  - SweepRange produces the begin and end events of the intervals of several
+//    ranges (each sorted by begin) in merged order, as a sweep-line would.
+//
+// Records that are not pair-like can be adapted with projections, which can
+// be any callable, including pointers to data members:
+//
+//   struct Task {
+//     double start;
+//     double finish;
+//   };
+//   std::vector<Task> tasks = ...;  // Sorted by start.
+//   for (auto [begin, end] :
+//        CoalesceIntervals(tasks, &Task::start, &Task::finish)) {
+//     // Busy from begin to end.
+//   }
+//
+//   int active = 0;
+//   for (const auto& event : SweepRange(IntervalsOf(tasks, &Task::start,
+//                                                   &Task::finish),
+//                                       IntervalsOf(queries, ...))) {
+//     ...
+//   }
+
+#ifndef GENIT_INTERVAL_RANGE_H_
+#define GENIT_INTERVAL_RANGE_H_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/utility/utility.h"
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+
+namespace interval_range_detail {
+
+struct BeginTag {};
+struct EndTag {};
+
+// The coordinate type of the intervals of a range of pair-like elements.
+template <typename Range>
+using IntervalCoordinateType = std::common_type_t<
+    std::decay_t<decltype(std::get<0>(
+        std::declval<RangeReferenceType<Range>>()))>,
+    std::decay_t<decltype(std::get<1>(
+        std::declval<RangeReferenceType<Range>>()))>>;
+
+// Functor that projects a record onto an interval.
+template <typename BeginProj, typename EndProj>
+struct ProjectInterval {
+  template <typename T>
+  auto operator()(T&& value) const {
+    using Coordinate = std::common_type_t<
+        std::decay_t<std::invoke_result_t<const BeginProj&, T&>>,
+        std::decay_t<std::invoke_result_t<const EndProj&, T&>>>;
+    return std::pair<Coordinate, Coordinate>(std::invoke(begin_proj, value),
+                                             std::invoke(end_proj, value));
+  }
+
+  BeginProj begin_proj;
+  EndProj end_proj;
+};
+
+}  // namespace interval_range_detail
+
+// Creates a range of std::pair intervals from a range of records, using a
+// projection for the begin and for the end of each interval. Projections can
+// be any callable, including pointers to data members.
+template <typename Range, typename BeginProj, typename EndProj>
+auto IntervalsOf(Range&& range, BeginProj&& begin_proj, EndProj&& end_proj) {
+  return TransformRange(
+      std::forward<Range>(range),
+      interval_range_detail::ProjectInterval<std::decay_t<BeginProj>,
+                                             std::decay_t<EndProj>>{
+          std::forward<BeginProj>(begin_proj),
+          std::forward<EndProj>(end_proj)});
+}
+
+// Forward-decl.
+template <typename BaseRange>
+class CoalescedRange;
+
+// Iterator over the merged intervals of a CoalescedRange.
+template <typename BaseRange>
+class CoalesceIterator
+    : public IteratorFacade<
+          CoalesceIterator<BaseRange>,
+          std::pair<interval_range_detail::IntervalCoordinateType<BaseRange>,
+                    interval_range_detail::IntervalCoordinateType<BaseRange>>,
+          zip_iterator_detail::LeastPermissive<
+              std::forward_iterator_tag,
+              zip_iterator_detail::ReduceToStdIterCategory<
+                  typename std::iterator_traits<
+                      RangeIteratorType<BaseRange>>::iterator_category>>> {
+ public:
+  using Coordinate = interval_range_detail::IntervalCoordinateType<BaseRange>;
+  using Interval = std::pair<Coordinate, Coordinate>;
+
+  CoalesceIterator(RangeIteratorType<BaseRange> it,
+                   const CoalescedRange<BaseRange>* parent)
+      : next_(std::move(it)), parent_(parent) {
+    Increment();
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<CoalesceIterator>;
+
+  Interval Dereference() const { return current_; }
+  void Increment() {
+    const auto last = parent_->BaseEnd();
+    at_end_ = (next_ == last);
+    if (at_end_) {
+      return;
+    }
+    const auto& first = *next_;
+    current_ = Interval(std::get<0>(first), std::get<1>(first));
+    while (++next_ != last) {
+      const auto& interval = *next_;
+      const Coordinate begin = std::get<0>(interval);
+      assert(!(begin < current_.first) &&
+             "CoalesceIntervals requires intervals sorted by begin.");
+      if (current_.second < begin) {
+        break;
+      }
+      const Coordinate end = std::get<1>(interval);
+      if (current_.second < end) {
+        current_.second = end;
+      }
+    }
+  }
+  bool IsEqual(const CoalesceIterator& rhs) const {
+    return at_end_ == rhs.at_end_ && next_ == rhs.next_;
+  }
+
+  // The first base element that is not merged into current_ yet.
+  RangeIteratorType<BaseRange> next_;
+  const CoalescedRange<BaseRange>* parent_ = nullptr;
+  Interval current_;
+  bool at_end_ = false;
+};
+
+// A range of the merged intervals of a range of pair-like intervals sorted by
+// begin. Overlapping and touching intervals are merged.
+template <typename BaseRange>
+class CoalescedRange
+    : public AliasRangeFacade<CoalescedRange<BaseRange>, BaseRange,
+                              CoalesceIterator<BaseRange>> {
+ public:
+  using CoalesceIter = CoalesceIterator<BaseRange>;
+  using AliasRangeFacade<CoalescedRange<BaseRange>, BaseRange,
+                         CoalesceIter>::AliasRangeFacade;
+
+ private:
+  friend class AliasRangeFacadePrivateAccess<CoalescedRange<BaseRange>>;
+  friend class CoalesceIterator<BaseRange>;
+
+  auto Begin(const BaseRange& base_range) const {
+    using std::begin;
+    return CoalesceIter(begin(base_range), this);
+  }
+  auto End(const BaseRange& base_range) const {
+    using std::end;
+    return CoalesceIter(end(base_range), this);
+  }
+
+  auto BaseEnd() const {
+    using std::end;
+    return end(this->base_range_);
+  }
+};
+
+// Creates a lazy range of the merged intervals of a range of pair-like
+// intervals [begin, end) sorted by begin.
+template <typename Range>
+auto CoalesceIntervals(Range&& range) {
+  return CoalescedRange<decltype(MoveOrAliasRange(std::forward<Range>(range)))>(
+      MoveOrAliasRange(std::forward<Range>(range)));
+}
+
+// Creates a lazy range of the merged intervals of a range of records sorted by
+// begin, using projections to get the begin and end of each record.
+template <typename Range, typename BeginProj, typename EndProj>
+auto CoalesceIntervals(Range&& range, BeginProj&& begin_proj,
+                       EndProj&& end_proj) {
+  return CoalesceIntervals(IntervalsOf(std::forward<Range>(range),
+                                       std::forward<BeginProj>(begin_proj),
+                                       std::forward<EndProj>(end_proj)));
+}
+
+// The kind of a sweep event. End events sort before begin events at the same
+// position, since intervals are half-open.
+enum class SweepEventKind { kEnd, kBegin };
+
+// An event produced by SweepRange.
+template <typename Coordinate>
+struct SweepEvent {
+  Coordinate position;
+  SweepEventKind kind;
+  // Index of the range (in the SweepRange arguments) of the interval.
+  int source;
+  // Index of the interval within its range.
+  int index;
+};
+
+// Iterator over the events of a SweptRange. This is a single-pass iterator
+// since it owns the queue of pending end events.
+template <typename... Ranges>
+class SweepIterator
+    : public IteratorFacade<
+          SweepIterator<Ranges...>,
+          const SweepEvent<std::common_type_t<
+              interval_range_detail::IntervalCoordinateType<Ranges>...>>&,
+          std::input_iterator_tag> {
+ public:
+  using Coordinate = std::common_type_t<
+      interval_range_detail::IntervalCoordinateType<Ranges>...>;
+  using Event = SweepEvent<Coordinate>;
+  static constexpr std::size_t kNumberOfRanges = sizeof...(Ranges);
+  using IndexSeq = absl::make_index_sequence<kNumberOfRanges>;
+
+  SweepIterator(interval_range_detail::BeginTag,
+                const std::tuple<Ranges...>* ranges)
+      : ranges_(ranges),
+        its_(std::apply(
+            [](const Ranges&... rs) {
+              using std::begin;
+              return std::make_tuple(begin(rs)...);
+            },
+            *ranges)) {
+    UpdateNextBegins(IndexSeq());
+    Increment();
+  }
+  SweepIterator(interval_range_detail::EndTag,
+                const std::tuple<Ranges...>* ranges)
+      : ranges_(ranges),
+        its_(std::apply(
+            [](const Ranges&... rs) {
+              using std::end;
+              return std::make_tuple(end(rs)...);
+            },
+            *ranges)),
+        at_end_(true) {}
+
+ private:
+  friend class IteratorFacadePrivateAccess<SweepIterator>;
+
+  // Orders the pending end events such that the earliest is on top.
+  struct Later {
+    bool operator()(const Event& lhs, const Event& rhs) const {
+      return std::tie(rhs.position, rhs.source, rhs.index) <
+             std::tie(lhs.position, lhs.source, lhs.index);
+    }
+  };
+
+  template <std::size_t Id>
+  bool UpdateNextBegin() {
+    using std::end;
+    auto& it = std::get<Id>(its_);
+    has_next_begin_[Id] = (it != end(std::get<Id>(*ranges_)));
+    if (has_next_begin_[Id]) {
+      next_begin_[Id] = std::get<0>(*it);
+    }
+    return true;
+  }
+  template <std::size_t... Ids>
+  void UpdateNextBegins(absl::index_sequence<Ids...>) {
+    (UpdateNextBegin<Ids>() && ...);
+  }
+
+  // Emits the begin event of the next interval of range Id.
+  template <std::size_t Id>
+  bool EmitBegin() {
+    auto& it = std::get<Id>(its_);
+    const int index = counts_[Id]++;
+    const int source = static_cast<int>(Id);
+    current_ = Event{next_begin_[Id], SweepEventKind::kBegin, source, index};
+    const Coordinate end = std::get<1>(*it);
+    pending_ends_.push(Event{end, SweepEventKind::kEnd, source, index});
+    ++it;
+    return UpdateNextBegin<Id>();
+  }
+  template <std::size_t... Ids>
+  void EmitBegin(int source, absl::index_sequence<Ids...>) {
+    (void)((static_cast<int>(Ids) == source && EmitBegin<Ids>()) || ...);
+  }
+
+  const Event& Dereference() const { return current_; }
+  void Increment() {
+    int source = -1;
+    for (int i = 0; i < static_cast<int>(kNumberOfRanges); ++i) {
+      if (has_next_begin_[i] &&
+          (source < 0 || next_begin_[i] < next_begin_[source])) {
+        source = i;
+      }
+    }
+    ++num_events_;
+    if (!pending_ends_.empty() &&
+        (source < 0 ||
+         !(next_begin_[source] < pending_ends_.top().position))) {
+      current_ = pending_ends_.top();
+      pending_ends_.pop();
+    } else if (source >= 0) {
+      EmitBegin(source, IndexSeq());
+    } else {
+      at_end_ = true;
+    }
+  }
+  bool IsEqual(const SweepIterator& rhs) const {
+    return at_end_ == rhs.at_end_ &&
+           (at_end_ || num_events_ == rhs.num_events_);
+  }
+
+  const std::tuple<Ranges...>* ranges_;
+  std::tuple<RangeIteratorType<Ranges>...> its_;
+  std::array<Coordinate, kNumberOfRanges> next_begin_ = {};
+  std::array<bool, kNumberOfRanges> has_next_begin_ = {};
+  std::array<int, kNumberOfRanges> counts_ = {};
+  std::priority_queue<Event, std::vector<Event>, Later> pending_ends_;
+  Event current_ = {};
+  int num_events_ = 0;
+  bool at_end_ = false;
+};
+
+// A range of the begin and end events of the intervals of several ranges
+// (see SweepRange).
+template <typename... Ranges>
+class SweptRange
+    : public AliasRangeFacade<SweptRange<Ranges...>, std::tuple<Ranges...>,
+                              SweepIterator<Ranges...>> {
+ public:
+  using BaseRange = std::tuple<Ranges...>;
+  using SweepIter = SweepIterator<Ranges...>;
+  using BaseFacade =
+      AliasRangeFacade<SweptRange<Ranges...>, BaseRange, SweepIter>;
+
+  template <typename... OtherRanges>
+  explicit SweptRange(OtherRanges&&... ranges)
+      : BaseFacade(BaseRange(std::forward<OtherRanges>(ranges)...)) {}
+
+ private:
+  friend class AliasRangeFacadePrivateAccess<SweptRange<Ranges...>>;
+
+  auto Begin(const BaseRange& base_range) const {
+    return SweepIter(interval_range_detail::BeginTag{}, &base_range);
+  }
+  auto End(const BaseRange& base_range) const {
+    return SweepIter(interval_range_detail::EndTag{}, &base_range);
+  }
+};
+
+// Creates a single-pass range of the begin and end events (see SweepEvent) of
+// the intervals of several ranges of pair-like intervals [begin, end), each
+// sorted by begin. Events are produced in order of position. At the same
+// position, end events come before begin events, and ties are broken by the
+// index of the range, then by the index of the interval.
+// Use IntervalsOf to project ranges of records onto intervals.
+template <typename... Ranges>
+auto SweepRange(Ranges&&... ranges) {
+  return SweptRange<decltype(MoveOrAliasRange(std::forward<Ranges>(
+      ranges)))...>(MoveOrAliasRange(std::forward<Ranges>(ranges))...);
+}
+
+}  // namespace genit
+
+#endif  // GENIT_INTERVAL_RANGE_H_
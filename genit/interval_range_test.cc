@@ -0,0 +1,149 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/interval_range.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+struct Task {
+  double start;
+  double finish;
+  int id;
+};
+
+TEST(CoalesceIntervalsTest, EmptyRange) {
+  std::vector<std::pair<int, int>> intervals;
+  EXPECT_TRUE(CoalesceIntervals(intervals).empty());
+}
+
+TEST(CoalesceIntervalsTest, MergesOverlappingAndTouchingIntervals) {
+  std::vector<std::pair<int, int>> intervals = {
+      {0, 2}, {1, 3}, {3, 4}, {6, 7}, {6, 10}, {7, 8}, {12, 13}};
+  EXPECT_THAT(CoalesceIntervals(intervals),
+              ElementsAre(Pair(0, 4), Pair(6, 10), Pair(12, 13)));
+}
+
+TEST(CoalesceIntervalsTest, SingleInterval) {
+  std::list<std::tuple<int, int>> intervals = {{3, 5}};
+  EXPECT_THAT(CoalesceIntervals(intervals), ElementsAre(Pair(3, 5)));
+}
+
+TEST(CoalesceIntervalsTest, ForwardIterator) {
+  std::vector<std::pair<int, int>> intervals = {{0, 2}, {1, 3}, {5, 6}};
+  const auto range = CoalesceIntervals(intervals);
+  using It = decltype(range.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::forward_iterator_tag>));
+  auto it = range.begin();
+  const auto first = it++;
+  EXPECT_EQ(*first, std::pair(0, 3));
+  EXPECT_EQ(*it, std::pair(5, 6));
+  EXPECT_EQ(range.size(), 2);
+}
+
+TEST(CoalesceIntervalsTest, Projections) {
+  std::vector<Task> tasks = {
+      {0.0, 1.5, 0}, {1.0, 2.0, 1}, {2.5, 3.0, 2}, {2.75, 4.0, 3}};
+  EXPECT_THAT(CoalesceIntervals(tasks, &Task::start, &Task::finish),
+              ElementsAre(Pair(0.0, 2.0), Pair(2.5, 4.0)));
+  EXPECT_THAT(CoalesceIntervals(tasks, &Task::start,
+                                [](const Task& t) { return t.start + 0.1; }),
+              ElementsAre(Pair(0.0, 0.1), Pair(1.0, 1.1), Pair(2.5, 2.6),
+                          Pair(2.75, 2.85)));
+}
+
+TEST(CoalesceIntervalsTest, ProjectsEachIntervalOnce) {
+  std::vector<Task> tasks = {
+      {0.0, 1.5, 0}, {1.0, 2.0, 1}, {2.5, 3.0, 2}, {2.75, 4.0, 3}};
+  int num_calls = 0;
+  const auto coalesced = CoalesceIntervals(
+      tasks, &Task::start, [&num_calls](const Task& t) {
+        ++num_calls;
+        return t.finish;
+      });
+  EXPECT_THAT(coalesced, ElementsAre(Pair(0.0, 2.0), Pair(2.5, 4.0)));
+  // Task 2 ends the first interval, and starts the second one.
+  EXPECT_EQ(num_calls, 5);
+}
+
+TEST(CoalesceIntervalsTest, RvalueRange) {
+  EXPECT_THAT(CoalesceIntervals(std::vector<std::pair<int, int>>{
+                  {0, 1}, {1, 2}, {4, 5}}),
+              ElementsAre(Pair(0, 2), Pair(4, 5)));
+}
+
+MATCHER_P4(IsEvent, position, kind, source, index, "") {
+  return arg.position == position && arg.kind == kind &&
+         arg.source == source && arg.index == index;
+}
+
+TEST(SweepRangeTest, EmptyRanges) {
+  std::vector<std::pair<int, int>> empty;
+  EXPECT_TRUE(SweepRange(empty, empty).empty());
+}
+
+TEST(SweepRangeTest, SingleRange) {
+  std::vector<std::pair<int, int>> intervals = {{0, 5}, {1, 2}, {3, 4}};
+  constexpr auto kBegin = SweepEventKind::kBegin;
+  constexpr auto kEnd = SweepEventKind::kEnd;
+  EXPECT_THAT(SweepRange(intervals),
+              ElementsAre(IsEvent(0, kBegin, 0, 0), IsEvent(1, kBegin, 0, 1),
+                          IsEvent(2, kEnd, 0, 1), IsEvent(3, kBegin, 0, 2),
+                          IsEvent(4, kEnd, 0, 2), IsEvent(5, kEnd, 0, 0)));
+}
+
+TEST(SweepRangeTest, MergesSeveralRanges) {
+  std::vector<Task> tasks = {{0.0, 2.0, 7}, {3.0, 4.0, 8}};
+  std::list<std::pair<int, int>> queries = {{1, 3}, {2, 5}};
+  constexpr auto kBegin = SweepEventKind::kBegin;
+  constexpr auto kEnd = SweepEventKind::kEnd;
+  EXPECT_THAT(
+      SweepRange(IntervalsOf(tasks, &Task::start, &Task::finish), queries),
+      ElementsAre(IsEvent(0.0, kBegin, 0, 0), IsEvent(1.0, kBegin, 1, 0),
+                  // End events come first at the same position.
+                  IsEvent(2.0, kEnd, 0, 0), IsEvent(2.0, kBegin, 1, 1),
+                  IsEvent(3.0, kEnd, 1, 0), IsEvent(3.0, kBegin, 0, 1),
+                  IsEvent(4.0, kEnd, 0, 1), IsEvent(5.0, kEnd, 1, 1)));
+}
+
+TEST(SweepRangeTest, CountsMaximumOverlap) {
+  std::vector<std::pair<int, int>> a = {{0, 10}, {2, 4}, {8, 9}};
+  std::vector<std::pair<int, int>> b = {{3, 8}, {9, 12}};
+  int active = 0;
+  int max_active = 0;
+  for (const auto& event : SweepRange(a, b)) {
+    active += (event.kind == SweepEventKind::kBegin) ? 1 : -1;
+    max_active = std::max(max_active, active);
+  }
+  EXPECT_EQ(active, 0);
+  EXPECT_EQ(max_active, 3);
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides checkpoints of iterator positions, to resume a
+// long scan where it left off, e.g., after the process was preempted:
+//
+//   auto records = FilterRange(ConcatenateRanges(log1, log2), IsValid);
+//   auto it = records.begin();
+//   ...
+//   Store(SavePosition(records, it).Serialize());
+//
+// and, in the restarted process, over the same data:
+//
+//   IteratorPosition position;
+//   auto it = records.begin();
+//   if (IteratorPosition::Deserialize(Load(), &position) &&
+//       RestorePosition(records, position, &it)) {
+//     // it refers to the element it referred to when saved.
+//   }
+//
+// A position is a short sequence of integers, which the iterator adapters
+// define recursively from the positions of their base iterators:
+//  - by default, the index of the iterator in its range,
+//  - for a ConcatIterator, the segment and the position in the segment,
+//  - for a NestedIterator, the position in each of the nested ranges,
+//  - for a FilterIterator, the position of its base iterator.
+// Restoring a position is then O(1) for random access base iterators
+// (instead of scanning from the beginning, e.g., evaluating the predicate of
+// a filter for all the skipped elements), and linear in the restored indices
+// otherwise.
+//
+// Iterators define their positions with two functions (found by ADL, e.g., as
+// friends):
+//
+//   void AppendNativePosition(const Iter& it, IteratorPosition* position);
+//   bool ReadNativePosition(const Iter& last, IteratorPositionReader* reader,
+//                           Iter* it);
+//
+// where 'last' is the end of the range, from which the iterator finds its
+// range. ReadNativePosition returns false if the position is not valid for
+// the range, e.g., if it was saved for different data. Unlike the defaults,
+// these do not call begin() on the range, which is not O(1) for some
+// adapters (e.g., a filtered range).
+
+#ifndef GENIT_ITERATOR_POSITION_H_
+#define GENIT_ITERATOR_POSITION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+// The position of an iterator in a range, see the top of the file.
+class IteratorPosition {
+ public:
+  IteratorPosition() = default;
+  explicit IteratorPosition(std::vector<int64_t> components)
+      : components_(std::move(components)) {}
+
+  const std::vector<int64_t>& components() const { return components_; }
+  void Append(int64_t component) { components_.push_back(component); }
+
+  // Encodes the components as LEB128 varints.
+  std::string Serialize() const {
+    std::string bytes;
+    for (const int64_t component : components_) {
+      uint64_t value = static_cast<uint64_t>(component);
+      while (value >= 0x80) {
+        bytes.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+      }
+      bytes.push_back(static_cast<char>(value));
+    }
+    return bytes;
+  }
+
+  // Decodes bytes returned by Serialize. Returns false if they are truncated
+  // or malformed.
+  static bool Deserialize(std::string_view bytes, IteratorPosition* position) {
+    std::vector<int64_t> components;
+    std::size_t i = 0;
+    while (i < bytes.size()) {
+      uint64_t value = 0;
+      int shift = 0;
+      uint8_t byte;
+      do {
+        if (i == bytes.size() || shift > 63) {
+          return false;
+        }
+        byte = static_cast<uint8_t>(bytes[i++]);
+        value |= uint64_t{byte & 0x7fu} << shift;
+        shift += 7;
+      } while (byte & 0x80);
+      components.push_back(static_cast<int64_t>(value));
+    }
+    position->components_ = std::move(components);
+    return true;
+  }
+
+  friend bool operator==(const IteratorPosition& lhs,
+                         const IteratorPosition& rhs) {
+    return lhs.components_ == rhs.components_;
+  }
+  friend bool operator!=(const IteratorPosition& lhs,
+                         const IteratorPosition& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  std::vector<int64_t> components_;
+};
+
+// Reads the components of an IteratorPosition in order.
+class IteratorPositionReader {
+ public:
+  explicit IteratorPositionReader(const IteratorPosition& position)
+      : components_(&position.components()) {}
+
+  // Returns false if all the components were read.
+  bool Read(int64_t* component) {
+    if (next_ == components_->size()) {
+      return false;
+    }
+    *component = (*components_)[next_++];
+    return true;
+  }
+
+  bool done() const { return next_ == components_->size(); }
+
+ private:
+  const std::vector<int64_t>* components_;
+  std::size_t next_ = 0;
+};
+
+namespace iterator_position_detail {
+
+template <typename Iter, typename = void>
+struct HasNativePosition : std::false_type {};
+
+template <typename Iter>
+struct HasNativePosition<Iter, std::void_t<decltype(AppendNativePosition(
+                                   std::declval<const Iter&>(),
+                                   std::declval<IteratorPosition*>()))>>
+    : std::true_type {};
+
+}  // namespace iterator_position_detail
+
+// Appends the position of 'it' in the range.
+template <typename Range, typename Iter>
+void AppendPosition(Range&& range, const Iter& it,
+                    IteratorPosition* position) {
+  if constexpr (iterator_position_detail::HasNativePosition<Iter>::value) {
+    AppendNativePosition(it, position);
+  } else {
+    using std::begin;
+    position->Append(std::distance(Iter(begin(range)), it));
+  }
+}
+
+// Sets 'it' to the position appended by AppendPosition for the range.
+// Returns false, and leaves 'it' unchanged, if the position is not in the
+// range.
+template <typename Range, typename Iter>
+bool ReadPosition(Range&& range, IteratorPositionReader* reader,
+                  Iter* it) {
+  using std::end;
+  if constexpr (iterator_position_detail::HasNativePosition<Iter>::value) {
+    return ReadNativePosition(Iter(end(range)), reader, it);
+  } else {
+    using std::begin;
+    int64_t index;
+    if (!reader->Read(&index) || index < 0) {
+      return false;
+    }
+    Iter pos = begin(range);
+    const Iter last = end(range);
+    using Category = typename std::iterator_traits<Iter>::iterator_category;
+    if constexpr (std::is_convertible_v<Category,
+                                        std::random_access_iterator_tag>) {
+      if (index > last - pos) {
+        return false;
+      }
+      pos += index;
+    } else {
+      for (; index > 0; --index) {
+        if (pos == last) {
+          return false;
+        }
+        ++pos;
+      }
+    }
+    *it = std::move(pos);
+    return true;
+  }
+}
+
+// Returns the position of 'it' in the range.
+template <typename Range>
+IteratorPosition SavePosition(Range&& range,
+                              const RangeIteratorType<Range>& it) {
+  IteratorPosition position;
+  AppendPosition(range, it, &position);
+  return position;
+}
+
+// Sets 'it' to a position returned by SavePosition for the same range (or
+// one with the same structure and data). Returns false, and leaves 'it'
+// unchanged, if the position is not valid for the range.
+template <typename Range>
+bool RestorePosition(Range&& range, const IteratorPosition& position,
+                     RangeIteratorType<Range>* it) {
+  IteratorPositionReader reader(position);
+  RangeIteratorType<Range> restored = *it;
+  if (!ReadPosition(range, &reader, &restored) || !reader.done()) {
+    return false;
+  }
+  *it = std::move(restored);
+  return true;
+}
+
+}  // namespace genit
+
+#endif  // GENIT_ITERATOR_POSITION_H_
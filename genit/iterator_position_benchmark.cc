@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares resuming a filtered scan over concatenated segments half-way
+// through, by skipping the scanned elements from the beginning, and by
+// restoring a saved position.
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/concat_range.h"
+#include "genit/filter_iterator.h"
+#include "genit/iterator_position.h"
+
+namespace genit {
+namespace {
+
+constexpr int kSegmentSize = 1 << 18;
+
+std::vector<int> MakeSegment(int first) {
+  std::vector<int> values(kSegmentSize);
+  for (int i = 0; i < kSegmentSize; ++i) {
+    values[i] = static_cast<int>(static_cast<uint32_t>(first + i) *
+                                 2654435761u);
+  }
+  return values;
+}
+
+bool IsValid(int x) { return (x & 7) != 0; }
+
+void BM_ResumeBySkipping(benchmark::State& state) {
+  const auto s1 = MakeSegment(0);
+  const auto s2 = MakeSegment(kSegmentSize);
+  const auto records = FilterRange(ConcatenateRanges(s1, s2), IsValid);
+  const auto num_scanned = std::distance(records.begin(), records.end()) / 2;
+  for (auto _ : state) {
+    auto it = std::next(records.begin(), num_scanned);
+    benchmark::DoNotOptimize(*it);
+  }
+}
+
+void BM_ResumeByPosition(benchmark::State& state) {
+  const auto s1 = MakeSegment(0);
+  const auto s2 = MakeSegment(kSegmentSize);
+  const auto records = FilterRange(ConcatenateRanges(s1, s2), IsValid);
+  const auto num_scanned = std::distance(records.begin(), records.end()) / 2;
+  const std::string checkpoint =
+      SavePosition(records, std::next(records.begin(), num_scanned))
+          .Serialize();
+  for (auto _ : state) {
+    IteratorPosition position;
+    auto it = records.end();
+    if (!IteratorPosition::Deserialize(checkpoint, &position) ||
+        !RestorePosition(records, position, &it)) {
+      state.SkipWithError("invalid position");
+    }
+    benchmark::DoNotOptimize(*it);
+  }
+}
+
+BENCHMARK(BM_ResumeBySkipping);
+BENCHMARK(BM_ResumeByPosition);
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,258 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/iterator_position.h"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "genit/concat_range.h"
+#include "genit/filter_iterator.h"
+#include "genit/iterator_range.h"
+#include "genit/nested_range.h"
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Saves and restores every position of the range, including the end.
+template <typename Range>
+void ExpectAllPositionsRestore(Range& range) {
+  int index = 0;
+  for (auto it = range.begin();; ++it, ++index) {
+    const IteratorPosition position = SavePosition(range, it);
+    IteratorPosition deserialized;
+    ASSERT_TRUE(
+        IteratorPosition::Deserialize(position.Serialize(), &deserialized));
+    auto restored = range.begin();
+    ASSERT_TRUE(RestorePosition(range, deserialized, &restored)) << index;
+    EXPECT_TRUE(restored == it) << index;
+    EXPECT_EQ(std::distance(range.begin(), restored), index);
+    if (it == range.end()) {
+      break;
+    }
+  }
+}
+
+TEST(IteratorPositionTest, SerializesComponents) {
+  const IteratorPosition position(
+      {0, 1, 127, 128, 300, std::numeric_limits<int64_t>::max(), -1});
+  const std::string bytes = position.Serialize();
+  EXPECT_EQ(bytes.substr(0, 5), std::string("\x00\x01\x7f\x80\x01", 5));
+  IteratorPosition deserialized;
+  ASSERT_TRUE(IteratorPosition::Deserialize(bytes, &deserialized));
+  EXPECT_EQ(deserialized, position);
+
+  // Truncated varint.
+  EXPECT_FALSE(IteratorPosition::Deserialize("\x01\x80", &deserialized));
+  // Too long for 64 bits.
+  EXPECT_FALSE(IteratorPosition::Deserialize(std::string(11, '\x80') + '\x01',
+                                             &deserialized));
+  EXPECT_EQ(deserialized, position);
+}
+
+TEST(IteratorPositionTest, RandomAccessIndex) {
+  std::vector<int> values = {1, 2, 3, 4, 5};
+  auto it = values.begin() + 3;
+  const IteratorPosition position = SavePosition(values, it);
+  EXPECT_THAT(position.components(), ElementsAre(3));
+
+  auto restored = values.begin();
+  ASSERT_TRUE(RestorePosition(values, position, &restored));
+  EXPECT_EQ(restored, it);
+
+  auto squares = TransformRange(values, [](int x) { return x * x; });
+  ExpectAllPositionsRestore(squares);
+}
+
+TEST(IteratorPositionTest, ForwardIndex) {
+  std::list<int> values = {1, 2, 3};
+  ExpectAllPositionsRestore(values);
+}
+
+TEST(IteratorPositionTest, RejectsInvalidPositions) {
+  std::vector<int> values = {1, 2, 3};
+  std::list<int> list = {1, 2, 3};
+  auto it = values.begin() + 1;
+  auto list_it = list.begin();
+  for (const auto& components : std::vector<std::vector<int64_t>>{
+           {}, {-1}, {4}, {1, 0}}) {
+    EXPECT_FALSE(
+        RestorePosition(values, IteratorPosition(components), &it));
+    EXPECT_FALSE(
+        RestorePosition(list, IteratorPosition(components), &list_it));
+  }
+  // Unchanged.
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(*list_it, 1);
+}
+
+TEST(IteratorPositionTest, ConcatSegmentAndOffset) {
+  std::vector<int> v1 = {1, 2};
+  std::vector<int> v2;
+  std::vector<int> v3 = {3, 4, 5};
+  auto range = ConcatenateRanges(v1, v2, v3);
+  auto it = std::next(range.begin(), 3);
+  const IteratorPosition position = SavePosition(range, it);
+  EXPECT_THAT(position.components(), ElementsAre(2, 1));
+
+  auto restored = range.begin();
+  ASSERT_TRUE(RestorePosition(range, position, &restored));
+  EXPECT_EQ(*restored, 4);
+
+  // The end of a segment is the beginning of the next non-empty one.
+  restored = range.begin();
+  ASSERT_TRUE(RestorePosition(range, IteratorPosition({0, 2}), &restored));
+  EXPECT_EQ(*restored, 3);
+  EXPECT_TRUE(restored == std::next(range.begin(), 2));
+
+  EXPECT_FALSE(RestorePosition(range, IteratorPosition({3, 0}), &restored));
+  EXPECT_FALSE(RestorePosition(range, IteratorPosition({0, 3}), &restored));
+  EXPECT_FALSE(RestorePosition(range, IteratorPosition({1}), &restored));
+
+  ExpectAllPositionsRestore(range);
+}
+
+TEST(IteratorPositionTest, ConcatDifferentIterators) {
+  std::vector<int> v1 = {1, 2};
+  std::list<int> v2;
+  std::list<int> v3 = {3, 4, 5};
+  auto range = ConcatenateRanges(v1, v2, v3);
+  auto it = std::next(range.begin(), 3);
+  const IteratorPosition position = SavePosition(range, it);
+  EXPECT_THAT(position.components(), ElementsAre(2, 1));
+
+  auto restored = range.begin();
+  ASSERT_TRUE(RestorePosition(range, position, &restored));
+  EXPECT_EQ(*restored, 4);
+  EXPECT_FALSE(RestorePosition(range, IteratorPosition({2, 4}), &restored));
+
+  ExpectAllPositionsRestore(range);
+}
+
+TEST(IteratorPositionTest, FilterBasePosition) {
+  std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8};
+  int num_calls = 0;
+  auto range = FilterRange(values, [&num_calls](int x) {
+    ++num_calls;
+    return x % 3 == 0;
+  });
+  auto it = std::next(range.begin());
+  EXPECT_EQ(*it, 6);
+  const IteratorPosition position = SavePosition(range, it);
+  EXPECT_THAT(position.components(), ElementsAre(5));
+
+  // The predicate is only evaluated for the restored element.
+  num_calls = 0;
+  auto restored = range.end();
+  ASSERT_TRUE(RestorePosition(range, position, &restored));
+  EXPECT_EQ(num_calls, 1);
+  EXPECT_TRUE(restored == it);
+
+  ExpectAllPositionsRestore(range);
+}
+
+TEST(IteratorPositionTest, FilterOverConcat) {
+  std::vector<int> v1 = {1, 2, 3};
+  std::vector<int> v2 = {4, 5, 6};
+  auto range =
+      FilterRange(ConcatenateRanges(v1, v2), [](int x) { return x % 2 == 0; });
+  const IteratorPosition position =
+      SavePosition(range, std::next(range.begin(), 2));
+  EXPECT_THAT(position.components(), ElementsAre(1, 2));
+  auto restored = range.begin();
+  ASSERT_TRUE(RestorePosition(range, position, &restored));
+  EXPECT_EQ(*restored, 6);
+
+  ExpectAllPositionsRestore(range);
+}
+
+TEST(IteratorPositionTest, NestedLevelIndices) {
+  std::vector<int> xs = {1, 2, 3};
+  std::list<char> ys = {'a', 'b'};
+  auto range = NestRanges(xs, ys);
+  auto it = std::next(range.begin(), 3);
+  const IteratorPosition position = SavePosition(range, it);
+  EXPECT_THAT(position.components(), ElementsAre(1, 1));
+
+  auto restored = range.begin();
+  ASSERT_TRUE(RestorePosition(range, position, &restored));
+  EXPECT_EQ(*restored, std::make_tuple(2, 'b'));
+
+  EXPECT_THAT(SavePosition(range, range.end()).components(),
+              ElementsAre(3, 0));
+  // Only the outermost iterator reaches the end of its range.
+  EXPECT_FALSE(RestorePosition(range, IteratorPosition({1, 2}), &restored));
+
+  ExpectAllPositionsRestore(range);
+}
+
+TEST(IteratorPositionTest, NestedOverFilter) {
+  std::vector<int> xs = {1, 2, 3, 4, 5};
+  std::list<int> ys = {7, 8};
+  auto evens = FilterRange(xs, [](int x) { return x % 2 == 0; });
+  auto range = NestRanges(evens, ys);
+  const IteratorPosition position =
+      SavePosition(range, std::next(range.begin(), 3));
+  // (4, 8): index 3 in xs, then 1 in ys.
+  EXPECT_THAT(position.components(), ElementsAre(3, 1));
+
+  ExpectAllPositionsRestore(range);
+}
+
+TEST(IteratorPositionTest, ResumesScan) {
+  std::vector<int> log1(100), log2(50);
+  for (int i = 0; i < 100; ++i) log1[i] = i;
+  for (int i = 0; i < 50; ++i) log2[i] = 100 + i;
+  const auto is_valid = [](int x) { return x % 7 != 0; };
+
+  std::vector<int> scanned;
+  std::string checkpoint;
+  {
+    auto records = FilterRange(ConcatenateRanges(log1, log2), is_valid);
+    auto it = records.begin();
+    for (int i = 0; i < 60; ++i, ++it) {
+      scanned.push_back(*it);
+    }
+    checkpoint = SavePosition(records, it).Serialize();
+  }
+
+  // Preempted: resume on a new range over the same data.
+  auto records = FilterRange(ConcatenateRanges(log1, log2), is_valid);
+  IteratorPosition position;
+  auto it = records.begin();
+  ASSERT_TRUE(IteratorPosition::Deserialize(checkpoint, &position));
+  ASSERT_TRUE(RestorePosition(records, position, &it));
+  for (; it != records.end(); ++it) {
+    scanned.push_back(*it);
+  }
+
+  std::vector<int> expected;
+  for (int x : records) {
+    expected.push_back(x);
+  }
+  EXPECT_EQ(scanned, expected);
+}
+
+}  // namespace
+}  // namespace genit
@@ -18,11 +18,17 @@
 #define GENIT_ITERATOR_RANGE_H_
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
+#if __cplusplus >= 202002L
+#include <span>
+#endif  // __cplusplus >= 202002L
+
 #include "genit/iterator_facade.h"
 
 namespace genit {
@@ -170,6 +176,57 @@ class IteratorRange {
 template <typename T>
 using PtrRange = IteratorRange<T*>;
 
+// The static extent of a range is its number of elements when it is known at
+// compile time, and kDynamicExtent otherwise. It is known for std::array, C
+// arrays, std::span with a static extent, and ranges that declare it as a
+// static constexpr std::size_t kExtent member. The range adapters propagate
+// it (e.g., TransformRange, ZipRange, AdjacentElementsRange), so that
+// algorithms can fully unroll small fixed-size loops (see algorithms.h).
+inline constexpr std::size_t kDynamicExtent =
+    std::numeric_limits<std::size_t>::max();
+
+namespace iterator_range_detail {
+
+template <typename Range, typename = void>
+struct StaticExtentImpl
+    : std::integral_constant<std::size_t, kDynamicExtent> {};
+
+template <typename Range>
+struct StaticExtentImpl<Range, std::void_t<decltype(Range::kExtent)>>
+    : std::integral_constant<std::size_t, Range::kExtent> {};
+
+template <typename T, std::size_t N>
+struct StaticExtentImpl<std::array<T, N>>
+    : std::integral_constant<std::size_t, N> {};
+
+template <typename T, std::size_t N>
+struct StaticExtentImpl<T[N]> : std::integral_constant<std::size_t, N> {};
+
+#if __cplusplus >= 202002L
+template <typename T, std::size_t N>
+struct StaticExtentImpl<std::span<T, N>>
+    : std::integral_constant<std::size_t, N == std::dynamic_extent
+                                              ? kDynamicExtent
+                                              : N> {};
+#endif  // __cplusplus >= 202002L
+
+}  // namespace iterator_range_detail
+
+template <typename Range>
+inline constexpr std::size_t kStaticExtent =
+    iterator_range_detail::StaticExtentImpl<
+        std::remove_cv_t<std::remove_reference_t<Range>>>::value;
+
+// An IteratorRange over N elements, with N known at compile time. This is how
+// an lvalue range with a static extent is aliased (see MoveOrAliasRange).
+template <typename IteratorT, std::size_t N>
+class StaticExtentRange : public IteratorRange<IteratorT> {
+ public:
+  static constexpr std::size_t kExtent = N;
+
+  using IteratorRange<IteratorT>::IteratorRange;
+};
+
 template <typename Range>
 using RangeIteratorType =
     std::decay_t<decltype(iterator_range_detail::GetRangeBegin(
@@ -317,7 +374,7 @@ class AliasRangeFacade {
 
   // Return the element in the "at" position of this range.
   reference operator[](difference_type at) const {
-    return *std::advance(begin(), at);
+    return *std::next(begin(), at);
   }
 
  protected:
@@ -373,33 +430,91 @@ inline RangeDecayType<Range> MoveOrAliasRange(const Range&& r) {
 }
 template <typename Range>
 inline auto MoveOrAliasRange(Range& r) {
-  return MakeIteratorRange(r);
+  if constexpr (kStaticExtent<Range> != kDynamicExtent) {
+    return StaticExtentRange<RangeIteratorType<Range&>, kStaticExtent<Range>>(
+        r);
+  } else {
+    return MakeIteratorRange(r);
+  }
 }
 template <typename Range>
 inline auto MoveOrAliasRange(const Range& r) {
-  return MakeIteratorRange(r);
+  if constexpr (kStaticExtent<Range> != kDynamicExtent) {
+    return StaticExtentRange<RangeIteratorType<const Range&>,
+                             kStaticExtent<Range>>(r);
+  } else {
+    return MakeIteratorRange(r);
+  }
+}
+
+namespace iterator_range_detail {
+
+template <typename Iter, typename = void>
+struct HasNativeReverseIterator : std::false_type {};
+
+template <typename Iter>
+struct HasNativeReverseIterator<
+    Iter, std::void_t<decltype(MakeNativeReverseIterator(
+              std::declval<const Iter&>(), std::declval<const Iter&>()))>>
+    : std::true_type {};
+
+}  // namespace iterator_range_detail
+
+// Customization point for reverse iteration.
+//
+// MakeReverseIterator(it, first) returns an iterator that iterates backwards
+// from the position 'it' in a range starting at 'first', i.e., it refers to
+// the element before 'it', like std::reverse_iterator(it). Reverse iterators
+// made from the same 'first' can be compared with each other.
+//
+// std::reverse_iterator dereferences a copy of its base iterator after
+// decrementing it, which is expensive for adapters with non-trivial
+// decrements (e.g., a FilterIterator evaluates its predicate once more for
+// each element). Such iterators can instead provide a native reverse iterator
+// by defining a function (found by ADL, e.g., as a friend):
+//
+//   NativeReverseIter MakeNativeReverseIterator(const Iter& it,
+//                                               const Iter& first);
+//
+// Otherwise, std::reverse_iterator<Iter> is used.
+template <typename Iter>
+auto MakeReverseIterator(const Iter& it, const Iter& first) {
+  if constexpr (iterator_range_detail::HasNativeReverseIterator<Iter>::value) {
+    return MakeNativeReverseIterator(it, first);
+  } else {
+    return std::reverse_iterator<Iter>(it);
+  }
 }
 
+// The type of the reverse iterator of Iter, see MakeReverseIterator.
+template <typename Iter>
+using ReverseIteratorType = decltype(MakeReverseIterator(
+    std::declval<const Iter&>(), std::declval<const Iter&>()));
+
 // ReversedRange wraps a range and reverses the iterators.
 template <typename BaseRange>
-class ReversedRange : public AliasRangeFacade<
-                          ReversedRange<BaseRange>, BaseRange,
-                          std::reverse_iterator<RangeIteratorType<BaseRange>>> {
+class ReversedRange
+    : public AliasRangeFacade<
+          ReversedRange<BaseRange>, BaseRange,
+          ReverseIteratorType<RangeIteratorType<BaseRange>>> {
  public:
-  using RevIter = std::reverse_iterator<RangeIteratorType<BaseRange>>;
+  using RevIter = ReverseIteratorType<RangeIteratorType<BaseRange>>;
   using AliasRangeFacade<ReversedRange<BaseRange>, BaseRange,
                          RevIter>::AliasRangeFacade;
+  static constexpr std::size_t kExtent = kStaticExtent<BaseRange>;
 
  private:
   friend class AliasRangeFacadePrivateAccess<ReversedRange<BaseRange>>;
 
   auto Begin(const BaseRange& base_range) const {
+    using std::begin;
     using std::end;
-    return RevIter(end(base_range));
+    return MakeReverseIterator(end(base_range), begin(base_range));
   }
   auto End(const BaseRange& base_range) const {
     using std::begin;
-    return RevIter(begin(base_range));
+    const auto first = begin(base_range);
+    return MakeReverseIterator(first, first);
   }
 };
 
@@ -25,6 +25,7 @@
 
 #include "absl/utility/utility.h"
 #include "genit/iterator_facade.h"
+#include "genit/iterator_position.h"
 #include "genit/iterator_range.h"
 #include "genit/zip_iterator.h"
 
@@ -49,6 +50,9 @@ namespace genit {
 //   ...
 // }
 //
+// The position of a nested iterator (see iterator_position.h) is the position
+// of its iterator in each of the ranges.
+//
 
 namespace nested_range_detail {
 
@@ -183,9 +187,60 @@ class NestedIterator
   }
   void Decrement() { Decrement(IndexSeq()); }
 
+  template <size_t... Ids>
+  void AppendLevelPositions(absl::index_sequence<Ids...>,
+                            IteratorPosition* position) const {
+    (AppendPosition(std::get<Ids>(*ranges_), std::get<Ids>(it_tuple_),
+                    position),
+     ...);
+  }
+
+  template <size_t Id>
+  bool ReadLevelPosition(IteratorPositionReader* reader) {
+    using std::begin;
+    using std::end;
+    const auto& range = std::get<Id>(*ranges_);
+    auto& it = std::get<Id>(it_tuple_);
+    if (!ReadPosition(range, reader, &it)) {
+      return false;
+    }
+    // Only the outermost iterator reaches the end of its range.
+    return Id == 0 || it != end(range) || it == begin(range);
+  }
+  template <size_t... Ids>
+  bool ReadLevelPositions(absl::index_sequence<Ids...>,
+                          IteratorPositionReader* reader) {
+    using std::end;
+    if (!(ReadLevelPosition<Ids>(reader) && ...)) {
+      return false;
+    }
+    if (std::get<0>(it_tuple_) == end(std::get<0>(*ranges_))) {
+      MakeEnd(IndexSeq());
+    }
+    return true;
+  }
+
+  // See iterator_position.h.
+  friend void AppendNativePosition(const NestedIterator& it,
+                                   IteratorPosition* position) {
+    it.AppendLevelPositions(IndexSeq(), position);
+  }
+  friend bool ReadNativePosition(const NestedIterator& last,
+                                 IteratorPositionReader* reader,
+                                 NestedIterator* it) {
+    NestedIterator restored = last;
+    if (!restored.ReadLevelPositions(IndexSeq(), reader)) {
+      return false;
+    }
+    *it = std::move(restored);
+    return true;
+  }
+
+  using IterTuple =
+      std::tuple<RangeIteratorType<FirstRange>, RangeIteratorType<Ranges>...>;
+
   const std::tuple<FirstRange, Ranges...>* ranges_;
-  std::tuple<RangeIteratorType<FirstRange>, RangeIteratorType<Ranges>...>
-      it_tuple_;
+  IterTuple it_tuple_;
 };
 
 template <typename FirstRange, typename... Ranges>
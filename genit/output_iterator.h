@@ -0,0 +1,251 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides adapters for the write side of algorithms:
+// output iterators that transform or filter the values written through them
+// before writing them to another output iterator, and a back-inserter that
+// appends to a container in batches. For example:
+//
+//   std::vector<float> meters;
+//   std::copy(depth_mm.begin(), depth_mm.end(),
+//             FilterOutputIterator(
+//                 TransformOutputIterator(std::back_inserter(meters),
+//                                         [](int mm) { return mm * 0.001f; }),
+//                 [](int mm) { return mm > 0; }));
+//
+// writes the valid depths in meters without an intermediate buffer.
+//
+// BatchingBackInserter accumulates values in a local buffer of kBatchSize
+// elements, and appends them to the container with a single insert per
+// batch, such that the capacity checks and growth happen once per batch:
+//
+//   BatchingBackInserter<std::vector<Record>> sink(records);
+//   std::copy(first, last, sink.iterator());
+//   sink.Flush();  // Or let the destructor flush.
+//
+// Output iterators are copied by value through algorithms, so the buffer
+// lives in the (non-copyable) sink, and its iterators only refer to it.
+
+#ifndef GENIT_OUTPUT_ITERATOR_H_
+#define GENIT_OUTPUT_ITERATOR_H_
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace genit {
+
+// Base class of output iterators. Derived must provide an assignment from
+// the values written through it (*it = value). Dereferencing and incrementing
+// return the iterator itself.
+template <typename Derived>
+class OutputIteratorFacade {
+ public:
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+
+  Derived& operator*() { return static_cast<Derived&>(*this); }
+  Derived& operator++() { return static_cast<Derived&>(*this); }
+  Derived& operator++(int) { return static_cast<Derived&>(*this); }
+};
+
+namespace output_iterator_detail {
+
+// Holds a function object, and is copy-assignable even when the function
+// object is not (e.g., a lambda), as output iterators must be.
+template <typename Fn>
+class AssignableFunction {
+ public:
+  explicit AssignableFunction(Fn fn) : fn_(std::move(fn)) {}
+
+  AssignableFunction(const AssignableFunction&) = default;
+  AssignableFunction(AssignableFunction&&) = default;
+  AssignableFunction& operator=(const AssignableFunction& other) {
+    if (this != &other) {
+      fn_.emplace(*other.fn_);
+    }
+    return *this;
+  }
+  AssignableFunction& operator=(AssignableFunction&& other) {
+    if (this != &other) {
+      fn_.emplace(std::move(*other.fn_));
+    }
+    return *this;
+  }
+
+  template <typename... Args>
+  decltype(auto) operator()(Args&&... args) const {
+    return (*fn_)(std::forward<Args>(args)...);
+  }
+
+ private:
+  std::optional<Fn> fn_;
+};
+
+template <typename T, typename Iter>
+inline constexpr bool kIsNotSelf = !std::is_same_v<std::decay_t<T>, Iter>;
+
+}  // namespace output_iterator_detail
+
+// Writes f(value) to the underlying output iterator for each value written
+// through it.
+template <typename OutputIter, typename UnaryFunc>
+class TransformOutputIterator
+    : public OutputIteratorFacade<
+          TransformOutputIterator<OutputIter, UnaryFunc>> {
+ public:
+  TransformOutputIterator(OutputIter out, UnaryFunc f)
+      : out_(std::move(out)), f_(std::move(f)) {}
+
+  template <typename T,
+            std::enable_if_t<output_iterator_detail::kIsNotSelf<
+                                 T, TransformOutputIterator>,
+                             int> = 0>
+  TransformOutputIterator& operator=(T&& value) {
+    *out_ = f_(std::forward<T>(value));
+    ++out_;
+    return *this;
+  }
+
+  // Returns the underlying iterator, past the values written so far.
+  const OutputIter& base() const { return out_; }
+
+ private:
+  OutputIter out_;
+  output_iterator_detail::AssignableFunction<UnaryFunc> f_;
+};
+
+template <typename OutputIter, typename UnaryFunc>
+TransformOutputIterator(OutputIter, UnaryFunc)
+    -> TransformOutputIterator<OutputIter, UnaryFunc>;
+
+// Deduction function for older compilers.
+template <typename OutputIter, typename UnaryFunc>
+auto MakeTransformOutputIterator(OutputIter out, UnaryFunc f) {
+  return TransformOutputIterator<OutputIter, UnaryFunc>(std::move(out),
+                                                        std::move(f));
+}
+
+// Writes the values written through it that satisfy pred to the underlying
+// output iterator, and drops the others.
+template <typename OutputIter, typename Predicate>
+class FilterOutputIterator
+    : public OutputIteratorFacade<FilterOutputIterator<OutputIter, Predicate>> {
+ public:
+  FilterOutputIterator(OutputIter out, Predicate pred)
+      : out_(std::move(out)), pred_(std::move(pred)) {}
+
+  template <typename T,
+            std::enable_if_t<
+                output_iterator_detail::kIsNotSelf<T, FilterOutputIterator>,
+                int> = 0>
+  FilterOutputIterator& operator=(T&& value) {
+    if (pred_(std::as_const(value))) {
+      *out_ = std::forward<T>(value);
+      ++out_;
+    }
+    return *this;
+  }
+
+  // Returns the underlying iterator, past the values written so far.
+  const OutputIter& base() const { return out_; }
+
+ private:
+  OutputIter out_;
+  output_iterator_detail::AssignableFunction<Predicate> pred_;
+};
+
+template <typename OutputIter, typename Predicate>
+FilterOutputIterator(OutputIter, Predicate)
+    -> FilterOutputIterator<OutputIter, Predicate>;
+
+// Deduction function for older compilers.
+template <typename OutputIter, typename Predicate>
+auto MakeFilterOutputIterator(OutputIter out, Predicate pred) {
+  return FilterOutputIterator<OutputIter, Predicate>(std::move(out),
+                                                     std::move(pred));
+}
+
+// Appends values to a container (with insert at the end, e.g., a
+// std::vector, std::deque or std::string) in batches of kBatchSize values.
+// The values are only in the container after Flush(), which the destructor
+// calls. The value type must be default-constructible.
+template <typename Container, std::size_t kBatchSize = 64>
+class BatchingBackInserter {
+ public:
+  using value_type = typename Container::value_type;
+
+  // An output iterator appending to the sink.
+  class Iterator : public OutputIteratorFacade<Iterator> {
+   public:
+    explicit Iterator(BatchingBackInserter* sink) : sink_(sink) {}
+
+    template <typename T,
+              std::enable_if_t<output_iterator_detail::kIsNotSelf<T, Iterator>,
+                               int> = 0>
+    Iterator& operator=(T&& value) {
+      sink_->push_back(std::forward<T>(value));
+      return *this;
+    }
+
+   private:
+    BatchingBackInserter* sink_;
+  };
+
+  explicit BatchingBackInserter(Container& container)
+      : container_(&container) {}
+  ~BatchingBackInserter() { Flush(); }
+
+  // Not copyable or movable: the iterators refer to the sink by address.
+  BatchingBackInserter(const BatchingBackInserter&) = delete;
+  BatchingBackInserter& operator=(const BatchingBackInserter&) = delete;
+
+  Iterator iterator() { return Iterator(this); }
+
+  void push_back(const value_type& value) {
+    buffer_[size_] = value;
+    if (++size_ == kBatchSize) {
+      Flush();
+    }
+  }
+  void push_back(value_type&& value) {
+    buffer_[size_] = std::move(value);
+    if (++size_ == kBatchSize) {
+      Flush();
+    }
+  }
+
+  // Appends the buffered values to the container.
+  void Flush() {
+    container_->insert(container_->end(), std::make_move_iterator(buffer_),
+                       std::make_move_iterator(buffer_ + size_));
+    size_ = 0;
+  }
+
+ private:
+  Container* container_;
+  std::size_t size_ = 0;
+  value_type buffer_[kBatchSize];
+};
+
+}  // namespace genit
+
+#endif  // GENIT_OUTPUT_ITERATOR_H_
@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares filtering and transforming values into a new container with an
+// intermediate buffer (std::copy_if then std::transform), with output
+// iterator adapters over std::back_inserter, and with output iterator
+// adapters over a BatchingBackInserter, for a std::vector and a std::deque.
+// The containers are reused, to measure the appends rather than the
+// allocations.
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/output_iterator.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumValues = 1 << 20;
+
+std::vector<int> MakeValues() {
+  std::vector<int> values(kNumValues);
+  for (int i = 0; i < kNumValues; ++i) {
+    values[i] = static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+  }
+  return values;
+}
+
+bool Keep(int x) { return (x & 3) != 0; }
+int64_t Scale(int x) { return int64_t{x} * 3; }
+
+template <typename Container>
+void BM_IntermediateBuffer(benchmark::State& state) {
+  const auto values = MakeValues();
+  std::vector<int> kept;
+  Container out;
+  for (auto _ : state) {
+    kept.clear();
+    out.clear();
+    std::copy_if(values.begin(), values.end(), std::back_inserter(kept),
+                 Keep);
+    std::transform(kept.begin(), kept.end(), std::back_inserter(out), Scale);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+template <typename Container>
+void BM_BackInserter(benchmark::State& state) {
+  const auto values = MakeValues();
+  Container out;
+  for (auto _ : state) {
+    out.clear();
+    std::copy(values.begin(), values.end(),
+              FilterOutputIterator(
+                  TransformOutputIterator(std::back_inserter(out), Scale),
+                  Keep));
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+template <typename Container>
+void BM_BatchingBackInserter(benchmark::State& state) {
+  const auto values = MakeValues();
+  Container out;
+  for (auto _ : state) {
+    out.clear();
+    {
+      BatchingBackInserter<Container> sink(out);
+      std::copy(values.begin(), values.end(),
+                FilterOutputIterator(
+                    TransformOutputIterator(sink.iterator(), Scale), Keep));
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+BENCHMARK_TEMPLATE(BM_IntermediateBuffer, std::vector<int64_t>);
+BENCHMARK_TEMPLATE(BM_BackInserter, std::vector<int64_t>);
+BENCHMARK_TEMPLATE(BM_BatchingBackInserter, std::vector<int64_t>);
+BENCHMARK_TEMPLATE(BM_IntermediateBuffer, std::deque<int64_t>);
+BENCHMARK_TEMPLATE(BM_BackInserter, std::deque<int64_t>);
+BENCHMARK_TEMPLATE(BM_BatchingBackInserter, std::deque<int64_t>);
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,153 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/output_iterator.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+using ::testing::IsEmpty;
+using ::testing::Pointee;
+
+TEST(TransformOutputIteratorTest, TransformsWrittenValues) {
+  const std::vector<int> values = {1, 2, 3};
+  std::vector<std::string> out;
+  std::copy(values.begin(), values.end(),
+            TransformOutputIterator(std::back_inserter(out), [](int x) {
+              return std::string(x, 'a');
+            }));
+  EXPECT_THAT(out, ElementsAre("a", "aa", "aaa"));
+}
+
+TEST(TransformOutputIteratorTest, WritesToPointers) {
+  const std::vector<int> values = {1, 2, 3};
+  double out[3];
+  const auto it = std::copy(values.begin(), values.end(),
+                            MakeTransformOutputIterator(
+                                out, [](int x) { return x * 0.5; }));
+  EXPECT_EQ(it.base(), out + 3);
+  EXPECT_THAT(out, ElementsAre(0.5, 1.0, 1.5));
+}
+
+TEST(TransformOutputIteratorTest, IsAnAssignableOutputIterator) {
+  std::vector<int> out;
+  auto it = TransformOutputIterator(std::back_inserter(out),
+                                    [](int x) { return x + 1; });
+  using It = decltype(it);
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::output_iterator_tag>));
+  EXPECT_TRUE(std::is_copy_assignable_v<It>);
+  auto copy = it;
+  it = copy;
+  *it++ = 1;
+  *++it = 2;
+  EXPECT_THAT(out, ElementsAre(2, 3));
+}
+
+TEST(FilterOutputIteratorTest, DropsRejectedValues) {
+  const std::vector<int> values = {1, 2, 3, 4, 5, 6};
+  std::vector<int> out;
+  std::copy(values.begin(), values.end(),
+            FilterOutputIterator(std::back_inserter(out),
+                                 [](int x) { return x % 2 == 0; }));
+  EXPECT_THAT(out, ElementsAre(2, 4, 6));
+}
+
+TEST(FilterOutputIteratorTest, MovesAcceptedValues) {
+  std::vector<std::unique_ptr<int>> values;
+  values.push_back(std::make_unique<int>(1));
+  values.push_back(nullptr);
+  values.push_back(std::make_unique<int>(3));
+  std::vector<std::unique_ptr<int>> out;
+  std::move(values.begin(), values.end(),
+            FilterOutputIterator(
+                std::back_inserter(out),
+                [](const std::unique_ptr<int>& p) { return p != nullptr; }));
+  EXPECT_THAT(out, ElementsAre(Pointee(1), Pointee(3)));
+}
+
+TEST(OutputIteratorTest, Composes) {
+  const std::vector<int> depth_mm = {0, 1500, -1, 250};
+  std::vector<float> meters;
+  std::transform(
+      depth_mm.begin(), depth_mm.end(),
+      FilterOutputIterator(
+          TransformOutputIterator(std::back_inserter(meters),
+                                  [](int mm) { return mm * 0.001f; }),
+          [](int mm) { return mm > 0; }),
+      [](int mm) { return mm * 2; });
+  EXPECT_THAT(meters, ElementsAre(FloatEq(3.0f), FloatEq(0.5f)));
+}
+
+TEST(BatchingBackInserterTest, AppendsInBatches) {
+  std::vector<int> out = {-1};
+  {
+    BatchingBackInserter<std::vector<int>, 4> sink(out);
+    for (int i = 0; i < 6; ++i) {
+      sink.push_back(i);
+    }
+    // One full batch was appended.
+    EXPECT_THAT(out, ElementsAre(-1, 0, 1, 2, 3));
+    sink.Flush();
+    EXPECT_THAT(out, ElementsAre(-1, 0, 1, 2, 3, 4, 5));
+    sink.push_back(6);
+  }
+  // The destructor flushed.
+  EXPECT_THAT(out, ElementsAre(-1, 0, 1, 2, 3, 4, 5, 6));
+}
+
+TEST(BatchingBackInserterTest, WorksWithAlgorithms) {
+  std::vector<int> values(1000);
+  for (int i = 0; i < 1000; ++i) {
+    values[i] = i;
+  }
+  std::deque<int> out;
+  {
+    BatchingBackInserter<std::deque<int>> sink(out);
+    std::copy_if(values.begin(), values.end(), sink.iterator(),
+                 [](int x) { return x % 3 == 0; });
+  }
+  ASSERT_EQ(out.size(), 334);
+  EXPECT_EQ(out[100], 300);
+
+  std::string text;
+  BatchingBackInserter<std::string, 8> sink(text);
+  const std::string word = "batching back-inserter";
+  std::copy(word.begin(), word.end(), std::back_inserter(sink));
+  sink.Flush();
+  EXPECT_EQ(text, word);
+}
+
+TEST(BatchingBackInserterTest, FlushesNothing) {
+  std::vector<int> out;
+  BatchingBackInserter<std::vector<int>> sink(out);
+  sink.Flush();
+  EXPECT_THAT(out, IsEmpty());
+}
+
+}  // namespace
+}  // namespace genit
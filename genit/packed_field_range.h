@@ -0,0 +1,448 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides views of the fields of packed binary records
+// (wire or log formats), at arbitrary byte offsets and strides, in little or
+// big endian byte order:
+//
+//   // Frames of 13 bytes: a big-endian uint32_t timestamp at offset 0, a
+//   // uint8_t status at offset 4 and a big-endian float at offset 5, ...
+//   const auto timestamps = PackedFieldRange<uint32_t, ByteOrder::kBigEndian>(
+//       buffer.data(), num_frames, /*record_size=*/13, /*field_offset=*/0);
+//   const auto values = PackedFieldRange<float, ByteOrder::kBigEndian>(
+//       buffer.data(), num_frames, 13, 5);
+//   for (float value : values) { ... }
+//
+// Unlike StrideIterator, which dereferences a T* and requires the fields to
+// be aligned (misaligned accesses are undefined behavior, and trap on some
+// targets), the fields are read with memcpy, which compiles to a single
+// unaligned load, followed by a byte swap if the byte order differs from the
+// native one. The elements are values (the views are read-only).
+//
+// DecodeInto(out) decodes all fields at once. Contiguous arrays of swapped
+// values are decoded with byte shuffles (SSSE3 or AVX2, picked at runtime,
+// see cpu_dispatch.h), 16 or 32 bytes at a time, and contiguous arrays in the
+// native byte order with memcpy. Fields of 2 to 8 bytes at strides of up to
+// 15 bytes (e.g., of packed sensor frames) are gathered from a few 16-byte
+// loads per 16 bytes of output, with one shuffle per load that picks (and
+// swaps) the bytes of the fields it holds. Larger strides, and 1-byte
+// fields, are read one field at a time.
+//
+// T must be an arithmetic type (integer or floating-point).
+
+#ifndef GENIT_PACKED_FIELD_RANGE_H_
+#define GENIT_PACKED_FIELD_RANGE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "genit/cpu_dispatch.h"
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace genit {
+
+enum class ByteOrder { kLittleEndian, kBigEndian };
+
+inline constexpr ByteOrder kNativeByteOrder =
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ByteOrder::kBigEndian;
+#else
+    ByteOrder::kLittleEndian;
+#endif
+
+namespace packed_field_range_detail {
+
+template <std::size_t kSize>
+struct UnsignedOfSizeImpl;
+template <>
+struct UnsignedOfSizeImpl<1> {
+  using type = uint8_t;
+};
+template <>
+struct UnsignedOfSizeImpl<2> {
+  using type = uint16_t;
+};
+template <>
+struct UnsignedOfSizeImpl<4> {
+  using type = uint32_t;
+};
+template <>
+struct UnsignedOfSizeImpl<8> {
+  using type = uint64_t;
+};
+template <typename T>
+using UnsignedOfSize = typename UnsignedOfSizeImpl<sizeof(T)>::type;
+
+inline uint8_t ByteSwapBits(uint8_t bits) { return bits; }
+inline uint16_t ByteSwapBits(uint16_t bits) { return __builtin_bswap16(bits); }
+inline uint32_t ByteSwapBits(uint32_t bits) { return __builtin_bswap32(bits); }
+inline uint64_t ByteSwapBits(uint64_t bits) { return __builtin_bswap64(bits); }
+
+}  // namespace packed_field_range_detail
+
+// Reads a T stored at ptr (at any alignment) in the given byte order.
+template <typename T, ByteOrder kOrder = kNativeByteOrder>
+T LoadUnaligned(const void* ptr) {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type.");
+  if constexpr (kOrder == kNativeByteOrder) {
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    return value;
+  } else {
+    packed_field_range_detail::UnsignedOfSize<T> bits;
+    std::memcpy(&bits, ptr, sizeof(T));
+    bits = packed_field_range_detail::ByteSwapBits(bits);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+}
+
+// Writes value to ptr (at any alignment) in the given byte order.
+template <typename T, ByteOrder kOrder = kNativeByteOrder>
+void StoreUnaligned(void* ptr, T value) {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type.");
+  if constexpr (kOrder == kNativeByteOrder) {
+    std::memcpy(ptr, &value, sizeof(T));
+  } else {
+    packed_field_range_detail::UnsignedOfSize<T> bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    bits = packed_field_range_detail::ByteSwapBits(bits);
+    std::memcpy(ptr, &bits, sizeof(T));
+  }
+}
+
+namespace packed_field_range_detail {
+
+using SwapBytesFn = void (*)(const unsigned char*, std::size_t,
+                             unsigned char*);
+
+// Reverses the bytes of each of the n kSize-byte values of in, and writes
+// them to out.
+template <std::size_t kSize>
+void SwapBytesScalar(const unsigned char* in, std::size_t n,
+                     unsigned char* out) {
+  using Bits = UnsignedOfSizeImpl<kSize>;
+  for (std::size_t i = 0; i < n; ++i) {
+    typename Bits::type bits;
+    std::memcpy(&bits, in + i * kSize, kSize);
+    bits = ByteSwapBits(bits);
+    std::memcpy(out + i * kSize, &bits, kSize);
+  }
+}
+
+using GatherFieldsFn = void (*)(const unsigned char*, std::size_t,
+                                std::ptrdiff_t, unsigned char*);
+
+// Writes the kSize-byte fields of n records at the given stride in to out,
+// reversing the bytes of each field if kSwap.
+template <std::size_t kSize, bool kSwap>
+void GatherFieldsScalar(const unsigned char* in, std::size_t n,
+                        std::ptrdiff_t stride, unsigned char* out) {
+  using Bits = UnsignedOfSizeImpl<kSize>;
+  for (std::size_t i = 0; i < n; ++i) {
+    typename Bits::type bits;
+    std::memcpy(&bits, in + static_cast<std::ptrdiff_t>(i) * stride, kSize);
+    if constexpr (kSwap) {
+      bits = ByteSwapBits(bits);
+    }
+    std::memcpy(out + i * kSize, &bits, kSize);
+  }
+}
+
+// The largest stride of the fields gathered with byte shuffles. At 16 bytes,
+// each load holds a single field, and the shuffles do not beat scalar loads.
+inline constexpr std::ptrdiff_t kMaxGatherStride = 15;
+
+#ifdef GENIT_HAVE_X86_DISPATCH
+
+// Byte shuffle reversing each kSize-byte group of a 16-byte lane.
+template <std::size_t kSize>
+__attribute__((target("sse4.2"))) inline __m128i SwapBytesMask() {
+  alignas(16) char mask[16];
+  for (int i = 0; i < 16; ++i) {
+    mask[i] = static_cast<char>(i - i % kSize + kSize - 1 - i % kSize);
+  }
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+template <std::size_t kSize>
+__attribute__((target("sse4.2"))) void SwapBytesSse42(const unsigned char* in,
+                                                      std::size_t n,
+                                                      unsigned char* out) {
+  const __m128i mask = SwapBytesMask<kSize>();
+  const std::size_t num_bytes = n * kSize;
+  std::size_t i = 0;
+  for (; i + 16 <= num_bytes; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_shuffle_epi8(v, mask));
+  }
+  SwapBytesScalar<kSize>(in + i, (num_bytes - i) / kSize, out + i);
+}
+
+template <std::size_t kSize>
+__attribute__((target("avx2"))) void SwapBytesAvx2(const unsigned char* in,
+                                                   std::size_t n,
+                                                   unsigned char* out) {
+  // The groups do not cross the 16-byte lanes of vpshufb.
+  const __m256i mask = _mm256_broadcastsi128_si256(SwapBytesMask<kSize>());
+  const std::size_t num_bytes = n * kSize;
+  std::size_t i = 0;
+  for (; i + 32 <= num_bytes; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        _mm256_shuffle_epi8(v, mask));
+  }
+  SwapBytesScalar<kSize>(in + i, (num_bytes - i) / kSize, out + i);
+}
+
+template <std::size_t kSize>
+inline const CpuDispatchedFunction<SwapBytesFn> kSwapBytes(
+    SwapBytesScalar<kSize>, SwapBytesSse42<kSize>, SwapBytesAvx2<kSize>);
+
+// Byte shuffles gathering the fields of kPerLane consecutive records, which
+// span at most kPerLane 16-byte loads, into the 16 bytes of a lane: mask l
+// picks the bytes of the l-th load (reversing each field if kSwap), and
+// zeroes the others, so that the shuffled loads are combined with OR.
+template <std::size_t kSize, bool kSwap>
+struct GatherMasks {
+  static constexpr int kPerLane = 16 / kSize;
+
+  explicit GatherMasks(std::ptrdiff_t stride)
+      : num_loads(static_cast<int>(((kPerLane - 1) * stride + kSize + 15) /
+                                   16)) {
+    std::memset(masks, 0x80, sizeof(masks));
+    for (int i = 0; i < 16; ++i) {
+      const int byte = i % kSize;
+      const std::ptrdiff_t pos =
+          i / kSize * stride + (kSwap ? kSize - 1 - byte : byte);
+      masks[pos / 16][i] = static_cast<char>(pos % 16);
+    }
+  }
+
+  int num_loads;
+  alignas(16) char masks[kPerLane][16];
+};
+
+template <std::size_t kSize, bool kSwap>
+__attribute__((target("sse4.2"))) void GatherFieldsSse42(
+    const unsigned char* in, std::size_t n, std::ptrdiff_t stride,
+    unsigned char* out) {
+  using Masks = GatherMasks<kSize, kSwap>;
+  const Masks gather(stride);
+  __m128i masks[Masks::kPerLane];
+  for (int l = 0; l < gather.num_loads; ++l) {
+    masks[l] =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(gather.masks[l]));
+  }
+  // Loads must not read past the last field.
+  const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(n - 1) * stride +
+                              kSize - 16 * gather.num_loads;
+  std::size_t i = 0;
+  for (; static_cast<std::ptrdiff_t>(i) * stride <= last;
+       i += Masks::kPerLane) {
+    const unsigned char* p = in + static_cast<std::ptrdiff_t>(i) * stride;
+    __m128i v = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), masks[0]);
+    for (int l = 1; l < gather.num_loads; ++l) {
+      v = _mm_or_si128(
+          v, _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                  p + 16 * l)),
+                              masks[l]));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * kSize), v);
+  }
+  GatherFieldsScalar<kSize, kSwap>(in + static_cast<std::ptrdiff_t>(i) * stride,
+                                   n - i, stride, out + i * kSize);
+}
+
+template <std::size_t kSize, bool kSwap>
+__attribute__((target("avx2"))) void GatherFieldsAvx2(const unsigned char* in,
+                                                      std::size_t n,
+                                                      std::ptrdiff_t stride,
+                                                      unsigned char* out) {
+  using Masks = GatherMasks<kSize, kSwap>;
+  const Masks gather(stride);
+  __m256i masks[Masks::kPerLane];
+  for (int l = 0; l < gather.num_loads; ++l) {
+    masks[l] = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(gather.masks[l])));
+  }
+  // The upper lane gathers the next kPerLane records.
+  const std::ptrdiff_t upper = Masks::kPerLane * stride;
+  const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(n - 1) * stride +
+                              kSize - 16 * gather.num_loads - upper;
+  std::size_t i = 0;
+  for (; static_cast<std::ptrdiff_t>(i) * stride <= last;
+       i += 2 * Masks::kPerLane) {
+    const unsigned char* p = in + static_cast<std::ptrdiff_t>(i) * stride;
+    __m256i v = _mm256_setzero_si256();
+    for (int l = 0; l < gather.num_loads; ++l) {
+      const __m256i loads = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * l))),
+          _mm_loadu_si128(
+              reinterpret_cast<const __m128i*>(p + upper + 16 * l)),
+          1);
+      v = _mm256_or_si256(v, _mm256_shuffle_epi8(loads, masks[l]));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * kSize), v);
+  }
+  GatherFieldsSse42<kSize, kSwap>(in + static_cast<std::ptrdiff_t>(i) * stride,
+                                  n - i, stride, out + i * kSize);
+}
+
+template <std::size_t kSize, bool kSwap>
+inline const CpuDispatchedFunction<GatherFieldsFn> kGatherFields(
+    GatherFieldsScalar<kSize, kSwap>, GatherFieldsSse42<kSize, kSwap>,
+    GatherFieldsAvx2<kSize, kSwap>);
+
+#else  // GENIT_HAVE_X86_DISPATCH
+
+template <std::size_t kSize>
+inline const CpuDispatchedFunction<SwapBytesFn> kSwapBytes(
+    SwapBytesScalar<kSize>);
+
+template <std::size_t kSize, bool kSwap>
+inline const CpuDispatchedFunction<GatherFieldsFn> kGatherFields(
+    GatherFieldsScalar<kSize, kSwap>);
+
+#endif  // GENIT_HAVE_X86_DISPATCH
+
+// Decodes n fields of type T at the given stride. out must not overlap data.
+template <typename T, ByteOrder kOrder>
+void Decode(const unsigned char* data, std::size_t n, std::ptrdiff_t stride,
+            T* out) {
+  if (stride != static_cast<std::ptrdiff_t>(sizeof(T))) {
+    if constexpr (sizeof(T) > 1) {
+      if (stride > static_cast<std::ptrdiff_t>(sizeof(T)) &&
+          stride <= kMaxGatherStride) {
+        kGatherFields<sizeof(T), kOrder != kNativeByteOrder>(
+            data, n, stride, reinterpret_cast<unsigned char*>(out));
+        return;
+      }
+    }
+    // One unaligned load (and byte swap) per field.
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = LoadUnaligned<T, kOrder>(data + i * stride);
+    }
+  } else if constexpr (kOrder == kNativeByteOrder || sizeof(T) == 1) {
+    std::memcpy(out, data, n * sizeof(T));
+  } else {
+    kSwapBytes<sizeof(T)>(data, n, reinterpret_cast<unsigned char*>(out));
+  }
+}
+
+}  // namespace packed_field_range_detail
+
+// Iterates over fields of type T, stored in the given byte order at a fixed
+// stride (in bytes) and any alignment.
+template <typename T, ByteOrder kOrder = kNativeByteOrder>
+class PackedFieldIterator
+    : public IteratorFacade<PackedFieldIterator<T, kOrder>, T,
+                            std::random_access_iterator_tag> {
+ public:
+  PackedFieldIterator() = default;
+  PackedFieldIterator(const void* ptr, int stride)
+      : ptr_(static_cast<const unsigned char*>(ptr)), stride_(stride) {}
+
+  // Returns the address of the current field.
+  const unsigned char* ptr() const { return ptr_; }
+  int stride() const { return stride_; }
+
+ private:
+  friend class IteratorFacadePrivateAccess<PackedFieldIterator>;
+
+  T Dereference() const { return LoadUnaligned<T, kOrder>(ptr_); }
+  void Increment() { ptr_ += stride_; }
+  void Decrement() { ptr_ -= stride_; }
+  void Advance(int n) { ptr_ += static_cast<std::ptrdiff_t>(n) * stride_; }
+  int DistanceTo(const PackedFieldIterator& rhs) const {
+    return (rhs.ptr_ - ptr_) / stride_;
+  }
+  bool IsEqual(const PackedFieldIterator& rhs) const {
+    return ptr_ == rhs.ptr_;
+  }
+
+  const unsigned char* ptr_ = nullptr;
+  int stride_ = sizeof(T);
+};
+
+// A range of PackedFieldIterator, with a bulk decoding path.
+template <typename T, ByteOrder kOrder = kNativeByteOrder>
+class PackedFieldRangeT : public IteratorRange<PackedFieldIterator<T, kOrder>> {
+ public:
+  using IteratorRange<PackedFieldIterator<T, kOrder>>::IteratorRange;
+
+  // Writes the size() fields to out, with the batch kernel for the CPU.
+  void DecodeInto(T* out) const {
+    const std::size_t n = this->size();
+    if (n > 0) {
+      packed_field_range_detail::Decode<T, kOrder>(
+          this->begin().ptr(), n, this->begin().stride(), out);
+    }
+  }
+
+  // Writes the fields to the first size() elements of a contiguous range,
+  // e.g., a std::vector.
+  template <typename OutRange,
+            std::enable_if_t<!std::is_pointer_v<OutRange>, int> = 0>
+  void DecodeInto(OutRange& out) const {
+    assert(std::size(out) >= static_cast<std::size_t>(this->size()));
+    DecodeInto(std::data(out));
+  }
+
+  // Returns the fields.
+  std::vector<T> Decode() const {
+    std::vector<T> values(this->size());
+    DecodeInto(values.data());
+    return values;
+  }
+};
+
+// Returns a range over the fields of type T at byte offset field_offset of
+// num_records records of record_size bytes starting at data, stored in the
+// given byte order.
+template <typename T, ByteOrder kOrder = kNativeByteOrder>
+PackedFieldRangeT<T, kOrder> PackedFieldRange(const void* data,
+                                              std::size_t num_records,
+                                              int record_size,
+                                              int field_offset = 0) {
+  const unsigned char* first =
+      static_cast<const unsigned char*>(data) + field_offset;
+  return PackedFieldRangeT<T, kOrder>(
+      PackedFieldIterator<T, kOrder>(first, record_size),
+      PackedFieldIterator<T, kOrder>(
+          first + num_records * static_cast<std::size_t>(record_size),
+          record_size));
+}
+
+}  // namespace genit
+
+#endif  // GENIT_PACKED_FIELD_RANGE_H_
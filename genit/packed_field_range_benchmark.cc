@@ -0,0 +1,160 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares reading a big-endian float field of packed 13-byte frames by
+// copying each frame into an aligned struct, by iterating PackedFieldRange,
+// and with DecodeInto at each instruction set level, and decoding a
+// contiguous array of big-endian uint32_t by iterating PackedFieldRange and
+// with DecodeInto at each level.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/cpu_dispatch.h"
+#include "genit/packed_field_range.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumValues = 1 << 16;
+constexpr int kFrameSize = 13;
+
+struct Frame {
+  uint32_t id;
+  uint8_t status;
+  float value;
+};
+
+std::vector<unsigned char> MakeFrames() {
+  std::vector<unsigned char> buffer(kNumValues * kFrameSize);
+  for (int i = 0; i < kNumValues; ++i) {
+    unsigned char* frame = buffer.data() + i * kFrameSize;
+    StoreUnaligned<uint32_t, ByteOrder::kBigEndian>(frame, i);
+    frame[4] = static_cast<unsigned char>(i % 3);
+    StoreUnaligned<float, ByteOrder::kBigEndian>(frame + 5, i * 0.5f);
+  }
+  return buffer;
+}
+
+void BM_FramesCopyToStruct(benchmark::State& state) {
+  const auto buffer = MakeFrames();
+  std::vector<float> out(kNumValues);
+  for (auto _ : state) {
+    for (int i = 0; i < kNumValues; ++i) {
+      const unsigned char* frame = buffer.data() + i * kFrameSize;
+      Frame f;
+      f.id = LoadUnaligned<uint32_t, ByteOrder::kBigEndian>(frame);
+      f.status = frame[4];
+      f.value = LoadUnaligned<float, ByteOrder::kBigEndian>(frame + 5);
+      out[i] = f.value;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_FramesIterate(benchmark::State& state) {
+  const auto buffer = MakeFrames();
+  std::vector<float> out(kNumValues);
+  for (auto _ : state) {
+    const auto values = PackedFieldRange<float, ByteOrder::kBigEndian>(
+        buffer.data(), kNumValues, kFrameSize, 5);
+    float* dst = out.data();
+    for (float value : values) {
+      *dst++ = value;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+// The argument is the CpuLevel.
+void BM_FramesDecodeInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  const auto buffer = MakeFrames();
+  std::vector<float> out(kNumValues);
+  for (auto _ : state) {
+    PackedFieldRange<float, ByteOrder::kBigEndian>(buffer.data(), kNumValues,
+                                                   kFrameSize, 5)
+        .DecodeInto(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+std::vector<unsigned char> MakeBigEndianArray() {
+  std::vector<unsigned char> buffer(kNumValues * sizeof(uint32_t));
+  for (int i = 0; i < kNumValues; ++i) {
+    StoreUnaligned<uint32_t, ByteOrder::kBigEndian>(
+        buffer.data() + i * sizeof(uint32_t), i * 2654435761u);
+  }
+  return buffer;
+}
+
+void BM_ArrayIterate(benchmark::State& state) {
+  const auto buffer = MakeBigEndianArray();
+  std::vector<uint32_t> out(kNumValues);
+  for (auto _ : state) {
+    const auto values = PackedFieldRange<uint32_t, ByteOrder::kBigEndian>(
+        buffer.data(), kNumValues, sizeof(uint32_t));
+    uint32_t* dst = out.data();
+    for (uint32_t value : values) {
+      *dst++ = value;
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+// The argument is the CpuLevel.
+void BM_ArrayDecodeInto(benchmark::State& state) {
+  const CpuLevel level = static_cast<CpuLevel>(state.range(0));
+  if (level > DetectedCpuLevel()) {
+    state.SkipWithError("Level not supported by the CPU");
+    return;
+  }
+  ScopedCpuLevelOverride override(level);
+  const auto buffer = MakeBigEndianArray();
+  std::vector<uint32_t> out(kNumValues);
+  for (auto _ : state) {
+    PackedFieldRange<uint32_t, ByteOrder::kBigEndian>(
+        buffer.data(), kNumValues, sizeof(uint32_t))
+        .DecodeInto(out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetLabel(CpuLevelName(level));
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+BENCHMARK(BM_FramesCopyToStruct);
+BENCHMARK(BM_FramesIterate);
+BENCHMARK(BM_FramesDecodeInto)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(BM_ArrayIterate);
+BENCHMARK(BM_ArrayDecodeInto)->Arg(0)->Arg(1)->Arg(2);
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,204 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/packed_field_range.h"
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "genit/cpu_dispatch.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(LoadUnalignedTest, ReadsBothByteOrders) {
+  const unsigned char bytes[] = {0xff, 0x01, 0x02, 0x03, 0x04,
+                                 0x05, 0x06, 0x07, 0x08};
+  EXPECT_EQ((LoadUnaligned<uint32_t, ByteOrder::kBigEndian>(bytes + 1)),
+            0x01020304u);
+  EXPECT_EQ((LoadUnaligned<uint32_t, ByteOrder::kLittleEndian>(bytes + 1)),
+            0x04030201u);
+  EXPECT_EQ((LoadUnaligned<uint16_t, ByteOrder::kBigEndian>(bytes + 3)),
+            0x0304);
+  EXPECT_EQ((LoadUnaligned<int16_t, ByteOrder::kBigEndian>(bytes)), -255);
+  EXPECT_EQ((LoadUnaligned<uint64_t, ByteOrder::kBigEndian>(bytes + 1)),
+            0x0102030405060708u);
+  EXPECT_EQ((LoadUnaligned<uint8_t, ByteOrder::kBigEndian>(bytes)), 0xff);
+}
+
+TEST(LoadUnalignedTest, RoundTripsStores) {
+  unsigned char buffer[16];
+  StoreUnaligned<float, ByteOrder::kBigEndian>(buffer + 3, 1.5f);
+  // 1.5f is 0x3fc00000.
+  EXPECT_EQ(buffer[3], 0x3f);
+  EXPECT_EQ(buffer[4], 0xc0);
+  EXPECT_EQ((LoadUnaligned<float, ByteOrder::kBigEndian>(buffer + 3)), 1.5f);
+  StoreUnaligned<double, ByteOrder::kLittleEndian>(buffer + 5, -0.25);
+  EXPECT_EQ((LoadUnaligned<double, ByteOrder::kLittleEndian>(buffer + 5)),
+            -0.25);
+  StoreUnaligned<int64_t, ByteOrder::kBigEndian>(buffer + 1, -2);
+  EXPECT_EQ(buffer[1], 0xff);
+  EXPECT_EQ(buffer[8], 0xfe);
+  EXPECT_EQ((LoadUnaligned<int64_t, ByteOrder::kBigEndian>(buffer + 1)), -2);
+  StoreUnaligned(buffer + 7, int32_t{-7});
+  EXPECT_EQ(LoadUnaligned<int32_t>(buffer + 7), -7);
+}
+
+// Frames of 13 bytes: a big-endian uint32_t id, a uint8_t status and a
+// big-endian float value, then a little-endian int16_t offset and 2 bytes of
+// padding.
+constexpr int kFrameSize = 13;
+
+std::vector<unsigned char> MakeFrames(int num_frames) {
+  std::vector<unsigned char> buffer(num_frames * kFrameSize);
+  for (int i = 0; i < num_frames; ++i) {
+    unsigned char* frame = buffer.data() + i * kFrameSize;
+    StoreUnaligned<uint32_t, ByteOrder::kBigEndian>(frame, 1000 + i);
+    frame[4] = static_cast<unsigned char>(i % 3);
+    StoreUnaligned<float, ByteOrder::kBigEndian>(frame + 5, i * 0.5f);
+    StoreUnaligned<int16_t, ByteOrder::kLittleEndian>(frame + 9, -i);
+  }
+  return buffer;
+}
+
+TEST(PackedFieldRangeTest, ReadsFieldsOfPackedFrames) {
+  const auto buffer = MakeFrames(4);
+  EXPECT_THAT((PackedFieldRange<uint32_t, ByteOrder::kBigEndian>(
+                  buffer.data(), 4, kFrameSize)),
+              ElementsAre(1000, 1001, 1002, 1003));
+  EXPECT_THAT(PackedFieldRange<uint8_t>(buffer.data(), 4, kFrameSize, 4),
+              ElementsAre(0, 1, 2, 0));
+  EXPECT_THAT((PackedFieldRange<float, ByteOrder::kBigEndian>(
+                  buffer.data(), 4, kFrameSize, 5)),
+              ElementsAre(0.0f, 0.5f, 1.0f, 1.5f));
+  EXPECT_THAT((PackedFieldRange<int16_t, ByteOrder::kLittleEndian>(
+                  buffer.data(), 4, kFrameSize, 9)),
+              ElementsAre(0, -1, -2, -3));
+}
+
+TEST(PackedFieldRangeTest, RandomAccess) {
+  const auto buffer = MakeFrames(10);
+  const auto values = PackedFieldRange<float, ByteOrder::kBigEndian>(
+      buffer.data(), 10, kFrameSize, 5);
+  using It = decltype(values.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_EQ(values.size(), 10);
+  EXPECT_EQ(values[7], 3.5f);
+  EXPECT_EQ(*(values.end() - 1), 4.5f);
+  EXPECT_EQ(values.end() - values.begin(), 10);
+  auto it = values.begin();
+  it += 4;
+  EXPECT_EQ(*it, 2.0f);
+  --it;
+  EXPECT_EQ(*it, 1.5f);
+}
+
+TEST(PackedFieldRangeTest, EmptyRange) {
+  const auto values = PackedFieldRange<uint32_t>(nullptr, 0, 4);
+  EXPECT_TRUE(values.empty());
+  EXPECT_TRUE(values.Decode().empty());
+}
+
+TEST(PackedFieldRangeTest, DecodeIntoStridedFields) {
+  for (int num_frames : {1, 7, 33, 100}) {
+    const auto buffer = MakeFrames(num_frames);
+    const auto ids = PackedFieldRange<uint32_t, ByteOrder::kBigEndian>(
+        buffer.data(), num_frames, kFrameSize);
+    const auto offsets = PackedFieldRange<int16_t, ByteOrder::kLittleEndian>(
+        buffer.data(), num_frames, kFrameSize, 9);
+    EXPECT_EQ(ids.Decode(), std::vector<uint32_t>(ids.begin(), ids.end()));
+    std::vector<int16_t> out(num_frames);
+    offsets.DecodeInto(out);
+    EXPECT_EQ(out, std::vector<int16_t>(offsets.begin(), offsets.end()));
+  }
+}
+
+// Decodes a (misaligned) array of fields of each size and byte order at the
+// given stride at each level, and compares to the iteration. The buffer ends
+// with the last field.
+template <typename T, ByteOrder kOrder>
+void ExpectDecodeMatchesIteration(int stride = sizeof(T)) {
+  for (int n : {0, 1, 3, 8, 15, 16, 17, 31, 64, 101}) {
+    std::vector<unsigned char> buffer(n == 0 ? 1
+                                             : 1 + (n - 1) * stride +
+                                                   sizeof(T));
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+      buffer[i] = static_cast<unsigned char>(i * 37 + 11);
+    }
+    const auto values =
+        PackedFieldRange<T, kOrder>(buffer.data() + 1, n, stride);
+    const std::vector<T> expected(values.begin(), values.end());
+    for (CpuLevel level : SupportedCpuLevels()) {
+      ScopedCpuLevelOverride override(level);
+      std::vector<T> out(n);
+      values.DecodeInto(out);
+      EXPECT_EQ(out, expected)
+          << CpuLevelName(level) << " " << n << " " << stride;
+    }
+  }
+}
+
+TEST(PackedFieldRangeTest, DecodeIntoContiguousArrays) {
+  ExpectDecodeMatchesIteration<uint16_t, ByteOrder::kBigEndian>();
+  ExpectDecodeMatchesIteration<int16_t, ByteOrder::kLittleEndian>();
+  ExpectDecodeMatchesIteration<uint32_t, ByteOrder::kBigEndian>();
+  ExpectDecodeMatchesIteration<int32_t, ByteOrder::kLittleEndian>();
+  ExpectDecodeMatchesIteration<uint64_t, ByteOrder::kBigEndian>();
+  ExpectDecodeMatchesIteration<int64_t, ByteOrder::kLittleEndian>();
+  ExpectDecodeMatchesIteration<uint8_t, ByteOrder::kBigEndian>();
+}
+
+// Covers the strides gathered with byte shuffles, and the next ones.
+TEST(PackedFieldRangeTest, DecodeIntoStridedFieldsAtEachLevel) {
+  for (int stride = 3; stride <= 17; ++stride) {
+    ExpectDecodeMatchesIteration<uint16_t, ByteOrder::kBigEndian>(stride);
+    ExpectDecodeMatchesIteration<int16_t, ByteOrder::kLittleEndian>(stride);
+  }
+  for (int stride = 5; stride <= 17; ++stride) {
+    ExpectDecodeMatchesIteration<uint32_t, ByteOrder::kBigEndian>(stride);
+    ExpectDecodeMatchesIteration<int32_t, ByteOrder::kLittleEndian>(stride);
+  }
+  for (int stride = 9; stride <= 17; ++stride) {
+    ExpectDecodeMatchesIteration<uint64_t, ByteOrder::kBigEndian>(stride);
+    ExpectDecodeMatchesIteration<int64_t, ByteOrder::kLittleEndian>(stride);
+  }
+  ExpectDecodeMatchesIteration<uint8_t, ByteOrder::kBigEndian>(13);
+}
+
+TEST(PackedFieldRangeTest, DecodeIntoBigEndianFloats) {
+  std::vector<unsigned char> buffer(40 * sizeof(float));
+  for (int i = 0; i < 40; ++i) {
+    StoreUnaligned<float, ByteOrder::kBigEndian>(
+        buffer.data() + i * sizeof(float), i - 20.5f);
+  }
+  const auto values = PackedFieldRange<float, ByteOrder::kBigEndian>(
+      buffer.data(), 40, sizeof(float));
+  for (CpuLevel level : SupportedCpuLevels()) {
+    ScopedCpuLevelOverride override(level);
+    const std::vector<float> out = values.Decode();
+    for (int i = 0; i < 40; ++i) {
+      ASSERT_EQ(out[i], i - 20.5f) << CpuLevelName(level);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,547 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides Pipeline, which runs a chain of stages, each on
+// its own thread, connected by bounded single-producer single-consumer queues
+// of batches:
+//
+//   const PipelineStats stats =
+//       MakePipeline(records)  // Any range, read on the source thread.
+//           .Then([](const std::vector<Record>& batch) {
+//             return TransformRange(batch, Decode);
+//           }, "decode")
+//           .Then([](const std::vector<Sample>& batch) {
+//             return FilterRange(batch, IsValid);
+//           }, "filter")
+//           .ForEach([&](const Sample& sample) { total += sample.value; });
+//
+// Each stage is a function from a batch (a const std::vector<In>&) to a range
+// of outputs, typically a genit adapter over the batch, whose elements are
+// appended to the output batch of the stage. The last step (ForEach or
+// ForEachBatch) runs on the calling thread, and returns when all elements have
+// been consumed.
+//
+// Elements are handed from one stage to the next in batches of about
+// options.batch_size elements, so the synchronization cost (a few atomic
+// operations, and a mutex only when a queue is full or empty) is paid once
+// per batch. Small outputs (e.g., of a selective filter) are accumulated until
+// a batch is full. A full output queue blocks its producer (backpressure), so
+// memory use is bounded by the queue capacities.
+//
+// The first exception thrown by a stage (or by the consumer) cancels the
+// pipeline, and is rethrown by ForEach once all threads are joined. Cancel()
+// stops the pipeline from any thread: stages stop at their next batch, and
+// ForEach returns early with stats.cancelled set.
+//
+// ForEach returns per-stage statistics: items processed per second of work,
+// time spent waiting for input (starvation) or for room in the output queue
+// (backpressure), and the occupancy of the output queues.
+
+#ifndef GENIT_PIPELINE_H_
+#define GENIT_PIPELINE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+namespace pipeline_detail {
+
+using Clock = std::chrono::steady_clock;
+
+inline double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+}  // namespace pipeline_detail
+
+// A bounded queue with one producer thread and one consumer thread. Push and
+// Pop only use atomic loads and stores while the queue is neither full nor
+// empty, and block on a condition variable otherwise.
+template <typename T>
+class BoundedSpscQueue {
+ public:
+  explicit BoundedSpscQueue(std::size_t capacity)
+      : capacity_(capacity), slots_(capacity) {
+    assert(capacity > 0);
+  }
+
+  BoundedSpscQueue(const BoundedSpscQueue&) = delete;
+  BoundedSpscQueue& operator=(const BoundedSpscQueue&) = delete;
+
+  // Appends value, waiting while the queue is full. Returns false (without
+  // appending) if the queue is cancelled. Producer only.
+  bool Push(T value) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const auto has_room = [&] {
+      return tail - head_.load() < capacity_ || cancelled_.load();
+    };
+    if (!has_room()) {
+      const auto start = pipeline_detail::Clock::now();
+      Wait(has_room);
+      push_wait_seconds_ += pipeline_detail::SecondsSince(start);
+    }
+    if (cancelled_.load()) {
+      return false;
+    }
+    const std::size_t occupancy = tail + 1 - head_.load();
+    occupancy_sum_ += occupancy;
+    max_occupancy_ = std::max(max_occupancy_, occupancy);
+    ++num_pushes_;
+    slots_[tail % capacity_] = std::move(value);
+    tail_.store(tail + 1);
+    Notify();
+    return true;
+  }
+
+  // Moves the first element to out, waiting while the queue is empty. Returns
+  // false if the queue is cancelled, or closed and empty. Consumer only.
+  bool Pop(T& out) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const auto ready = [&] {
+      return tail_.load() != head || closed_.load() || cancelled_.load();
+    };
+    if (!ready()) {
+      const auto start = pipeline_detail::Clock::now();
+      Wait(ready);
+      pop_wait_seconds_ += pipeline_detail::SecondsSince(start);
+    }
+    if (cancelled_.load() || tail_.load() == head) {
+      return false;
+    }
+    out = std::move(slots_[head % capacity_]);
+    head_.store(head + 1);
+    Notify();
+    return true;
+  }
+
+  // Signals that no more elements will be pushed. Producer only.
+  void Close() {
+    closed_.store(true);
+    Notify();
+  }
+
+  // Wakes both threads, and makes all further calls fail. Any thread.
+  void Cancel() {
+    cancelled_.store(true);
+    std::lock_guard<std::mutex> lock(mutex_);
+    not_ready_.notify_all();
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+  // Statistics, to read once the producer (or the consumer) is done.
+  // The mean and max number of elements in the queue right after a push.
+  double MeanOccupancy() const {
+    return num_pushes_ == 0 ? 0.0
+                            : static_cast<double>(occupancy_sum_) /
+                                  static_cast<double>(num_pushes_);
+  }
+  std::size_t MaxOccupancy() const { return max_occupancy_; }
+  // Time spent in Push waiting for room, and in Pop waiting for elements.
+  double PushWaitSeconds() const { return push_wait_seconds_; }
+  double PopWaitSeconds() const { return pop_wait_seconds_; }
+
+ private:
+  // Blocks until ready() is true. The state changes are sequentially
+  // consistent stores followed by Notify(), so either ready() observes the
+  // change, or Notify() observes the waiter and signals it under the mutex.
+  template <typename Pred>
+  void Wait(const Pred& ready) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    num_waiters_.fetch_add(1);
+    not_ready_.wait(lock, ready);
+    num_waiters_.fetch_sub(1);
+  }
+  void Notify() {
+    if (num_waiters_.load() > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      not_ready_.notify_all();
+    }
+  }
+
+  const std::size_t capacity_;
+  std::vector<T> slots_;
+  // Indices of the next element to pop and to push (not wrapped), on separate
+  // cache lines.
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  alignas(64) std::atomic<bool> closed_{false};
+  std::atomic<bool> cancelled_{false};
+  std::atomic<int> num_waiters_{0};
+  std::mutex mutex_;
+  std::condition_variable not_ready_;
+
+  // Written by the producer.
+  std::size_t num_pushes_ = 0;
+  std::size_t occupancy_sum_ = 0;
+  std::size_t max_occupancy_ = 0;
+  double push_wait_seconds_ = 0;
+  // Written by the consumer.
+  double pop_wait_seconds_ = 0;
+};
+
+struct PipelineOptions {
+  // The number of elements handed from one stage to the next at once.
+  std::size_t batch_size = 1024;
+  // The number of batches each queue holds before blocking its producer.
+  std::size_t queue_capacity = 4;
+};
+
+struct PipelineStageStats {
+  std::string name;
+  // Elements read by the stage (from the source range for the source), and
+  // elements and batches written to its output queue.
+  std::size_t num_input_items = 0;
+  std::size_t num_output_items = 0;
+  std::size_t num_output_batches = 0;
+  // Time spent in the stage, excluding the waits on its queues.
+  double busy_seconds = 0;
+  // Time spent waiting for input (starvation), and for room in the output
+  // queue (backpressure).
+  double input_wait_seconds = 0;
+  double output_wait_seconds = 0;
+  // Batches in the output queue right after each push.
+  double mean_output_queue_occupancy = 0;
+  std::size_t max_output_queue_occupancy = 0;
+
+  // Returns the throughput of the stage alone, in input items per second of
+  // work.
+  double ItemsPerSecond() const {
+    return busy_seconds > 0 ? num_input_items / busy_seconds : 0.0;
+  }
+};
+
+struct PipelineStats {
+  // The source, the stages in order, and the consumer ("sink").
+  std::vector<PipelineStageStats> stages;
+  double wall_seconds = 0;
+  bool cancelled = false;
+
+  // Returns one line per stage.
+  std::string ToString() const {
+    std::string out;
+    char line[256];
+    for (const PipelineStageStats& stage : stages) {
+      std::snprintf(line, sizeof(line),
+                    "%-12s %10zu in %10zu out %12.0f items/s  busy %8.4fs  "
+                    "starved %8.4fs  blocked %8.4fs  queue %.2f (max %zu)\n",
+                    stage.name.c_str(), stage.num_input_items,
+                    stage.num_output_items, stage.ItemsPerSecond(),
+                    stage.busy_seconds, stage.input_wait_seconds,
+                    stage.output_wait_seconds,
+                    stage.mean_output_queue_occupancy,
+                    stage.max_output_queue_occupancy);
+      out += line;
+    }
+    return out;
+  }
+};
+
+namespace pipeline_detail {
+
+template <typename T>
+using Batch = std::vector<T>;
+
+template <typename T>
+using BatchQueue = BoundedSpscQueue<Batch<T>>;
+
+// The stages of a pipeline, which run when it is consumed.
+struct PipelineState {
+  explicit PipelineState(PipelineOptions options) : options(options) {}
+
+  void Cancel() {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled = true;
+    for (const auto& cancel_queue : cancel_queues) {
+      cancel_queue();
+    }
+  }
+
+  // Records the first error, and cancels the pipeline.
+  void Fail(std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (error == nullptr) {
+        error = std::move(e);
+      }
+    }
+    Cancel();
+  }
+
+  // Runs body, failing the pipeline if it throws.
+  template <typename Body>
+  void RunGuarded(const Body& body) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+    try {
+      body();
+    } catch (...) {
+      Fail(std::current_exception());
+    }
+#else
+    body();
+#endif
+  }
+
+  template <typename T>
+  std::shared_ptr<BatchQueue<T>> NewQueue() {
+    auto queue = std::make_shared<BatchQueue<T>>(options.queue_capacity);
+    cancel_queues.push_back([queue] { queue->Cancel(); });
+    return queue;
+  }
+
+  // Appends the elements of a stage output to the pending output batch, and
+  // pushes it when it is full. Returns false if the pipeline is cancelled.
+  template <typename T, typename Range>
+  bool Emit(Range&& range, Batch<T>& pending, BatchQueue<T>& queue,
+            PipelineStageStats& stats) {
+    if constexpr (std::is_same_v<std::decay_t<Range>, Batch<T>> &&
+                  !std::is_lvalue_reference_v<Range>) {
+      if (pending.empty()) {
+        pending = std::move(range);
+      } else {
+        pending.insert(pending.end(), range.begin(), range.end());
+      }
+    } else {
+      for (auto&& value : range) {
+        pending.push_back(std::forward<decltype(value)>(value));
+      }
+    }
+    return pending.size() < options.batch_size || Flush(pending, queue, stats);
+  }
+
+  template <typename T>
+  bool Flush(Batch<T>& pending, BatchQueue<T>& queue,
+             PipelineStageStats& stats) {
+    if (pending.empty()) {
+      return true;
+    }
+    stats.num_output_items += pending.size();
+    ++stats.num_output_batches;
+    const bool pushed = queue.Push(std::move(pending));
+    pending = Batch<T>();
+    pending.reserve(options.batch_size);
+    return pushed;
+  }
+
+  // Fills the statistics of a stage, which ran from start.
+  template <typename T>
+  static void FinishStats(Clock::time_point start, double input_wait_seconds,
+                          const BatchQueue<T>& output,
+                          PipelineStageStats& stats) {
+    stats.input_wait_seconds = input_wait_seconds;
+    stats.output_wait_seconds = output.PushWaitSeconds();
+    stats.busy_seconds = SecondsSince(start) - stats.input_wait_seconds -
+                         stats.output_wait_seconds;
+    stats.mean_output_queue_occupancy = output.MeanOccupancy();
+    stats.max_output_queue_occupancy = output.MaxOccupancy();
+  }
+
+  const PipelineOptions options;
+  // The body of each thread, and the statistics of its stage.
+  std::vector<std::function<void()>> stage_bodies;
+  std::deque<PipelineStageStats> stage_stats;
+
+  std::mutex mutex;
+  bool cancelled = false;
+  std::vector<std::function<void()>> cancel_queues;
+  std::exception_ptr error;
+};
+
+}  // namespace pipeline_detail
+
+// Forward-decl.
+template <typename T>
+class Pipeline;
+template <typename Range>
+auto MakePipeline(Range&& source, PipelineOptions options = {});
+
+// A chain of stages producing elements of type T, built by MakePipeline and
+// Then, and run by ForEach or ForEachBatch. See the top of the file.
+template <typename T>
+class Pipeline {
+ public:
+  using value_type = T;
+
+  // Adds a stage that calls fn(const std::vector<T>& batch) on each batch,
+  // and forwards the elements of the returned range (e.g., an adapter over
+  // the batch, or a std::vector) to the next stage.
+  template <typename Fn>
+  auto Then(Fn fn, std::string name = "") {
+    using Result = std::invoke_result_t<Fn&, const pipeline_detail::Batch<T>&>;
+    using Out = std::remove_cv_t<RangeValueType<Result>>;
+    assert(output_ != nullptr && "Pipeline already consumed");
+    PipelineStageStats& stats = state_->stage_stats.emplace_back();
+    stats.name = name.empty() ? "stage " + std::to_string(
+                                               state_->stage_stats.size() - 1)
+                              : std::move(name);
+    auto input = std::move(output_);
+    auto output = state_->template NewQueue<Out>();
+    auto shared_fn = std::make_shared<Fn>(std::move(fn));
+    state_->stage_bodies.push_back([state = state_.get(), &stats, input,
+                                    output, shared_fn] {
+      const auto start = pipeline_detail::Clock::now();
+      state->RunGuarded([&] {
+        pipeline_detail::Batch<T> batch;
+        pipeline_detail::Batch<Out> pending;
+        pending.reserve(state->options.batch_size);
+        while (input->Pop(batch)) {
+          stats.num_input_items += batch.size();
+          if (!state->Emit((*shared_fn)(std::as_const(batch)), pending,
+                           *output, stats)) {
+            return;
+          }
+        }
+        state->Flush(pending, *output, stats);
+      });
+      output->Close();
+      state->FinishStats(start, input->PopWaitSeconds(), *output, stats);
+    });
+    return Pipeline<Out>(state_, std::move(output));
+  }
+
+  // Runs the pipeline, and calls fn(const std::vector<T>& batch) on each
+  // output batch, on the calling thread. Returns when all the elements have
+  // been consumed, or the pipeline is cancelled.
+  template <typename Fn>
+  PipelineStats ForEachBatch(Fn fn) {
+    assert(output_ != nullptr && "Pipeline already consumed");
+    const auto input = std::move(output_);
+    const auto start = pipeline_detail::Clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(state_->stage_bodies.size());
+    for (const auto& body : state_->stage_bodies) {
+      threads.emplace_back(body);
+    }
+    PipelineStageStats sink_stats;
+    sink_stats.name = "sink";
+    state_->RunGuarded([&] {
+      pipeline_detail::Batch<T> batch;
+      while (input->Pop(batch)) {
+        sink_stats.num_input_items += batch.size();
+        fn(std::as_const(batch));
+      }
+    });
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    sink_stats.input_wait_seconds = input->PopWaitSeconds();
+    sink_stats.busy_seconds = pipeline_detail::SecondsSince(start) -
+                              sink_stats.input_wait_seconds;
+
+    PipelineStats stats;
+    stats.wall_seconds = pipeline_detail::SecondsSince(start);
+    stats.stages.assign(state_->stage_stats.begin(),
+                        state_->stage_stats.end());
+    stats.stages.push_back(std::move(sink_stats));
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      stats.cancelled = state_->cancelled;
+    }
+    if (state_->error != nullptr) {
+      std::rethrow_exception(state_->error);
+    }
+    return stats;
+  }
+
+  // Runs the pipeline, and calls fn(const T&) on each output element, on the
+  // calling thread.
+  template <typename Fn>
+  PipelineStats ForEach(Fn fn) {
+    return ForEachBatch([&fn](const pipeline_detail::Batch<T>& batch) {
+      for (const T& value : batch) {
+        fn(value);
+      }
+    });
+  }
+
+  // Stops all the stages at their next batch, and makes ForEach return.
+  // Thread-safe, and may be called from a stage or the consumer.
+  void Cancel() { state_->Cancel(); }
+
+ private:
+  template <typename U>
+  friend class Pipeline;
+  template <typename Range>
+  friend auto MakePipeline(Range&& source, PipelineOptions options);
+
+  Pipeline(std::shared_ptr<pipeline_detail::PipelineState> state,
+           std::shared_ptr<pipeline_detail::BatchQueue<T>> output)
+      : state_(std::move(state)), output_(std::move(output)) {}
+
+  std::shared_ptr<pipeline_detail::PipelineState> state_;
+  // The queue of the last stage, null once consumed.
+  std::shared_ptr<pipeline_detail::BatchQueue<T>> output_;
+};
+
+// Creates a pipeline whose source thread reads the elements of a range. Like
+// adapters, the range is moved if it is an rvalue, and aliased otherwise (it
+// must then outlive the call to ForEach).
+template <typename Range>
+auto MakePipeline(Range&& source, PipelineOptions options) {
+  using T = std::remove_cv_t<RangeValueType<Range>>;
+  assert(options.batch_size > 0 && options.queue_capacity > 0);
+  auto state = std::make_shared<pipeline_detail::PipelineState>(options);
+  PipelineStageStats& stats = state->stage_stats.emplace_back();
+  stats.name = "source";
+  auto output = state->template NewQueue<T>();
+  auto range = std::make_shared<decltype(MoveOrAliasRange(
+      std::forward<Range>(source)))>(
+      MoveOrAliasRange(std::forward<Range>(source)));
+  state->stage_bodies.push_back([state = state.get(), &stats, output, range] {
+    const auto start = pipeline_detail::Clock::now();
+    state->RunGuarded([&] {
+      pipeline_detail::Batch<T> pending;
+      pending.reserve(state->options.batch_size);
+      for (auto&& value : *range) {
+        pending.push_back(std::forward<decltype(value)>(value));
+        if (pending.size() == state->options.batch_size) {
+          stats.num_input_items += pending.size();
+          if (!state->Flush(pending, *output, stats)) {
+            return;
+          }
+        }
+      }
+      stats.num_input_items += pending.size();
+      state->Flush(pending, *output, stats);
+    });
+    output->Close();
+    state->FinishStats(start, 0.0, *output, stats);
+  });
+  return Pipeline<T>(std::move(state), std::move(output));
+}
+
+}  // namespace genit
+
+#endif  // GENIT_PIPELINE_H_
@@ -0,0 +1,102 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares a decode -> transform -> filter -> aggregate chain of adapters run
+// on one thread, and as a Pipeline with one thread per stage, for several
+// batch sizes. The per-stage throughputs (in input items per second of work)
+// and mean output queue occupancies of the last run are reported as counters.
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/filter_iterator.h"
+#include "genit/pipeline.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumRecords = 1 << 20;
+
+std::vector<uint32_t> MakeRecords() {
+  std::vector<uint32_t> records(kNumRecords);
+  for (int i = 0; i < kNumRecords; ++i) {
+    records[i] = static_cast<uint32_t>(i) * 2654435761u;
+  }
+  return records;
+}
+
+// Some work per element, for each stage.
+double Decode(uint32_t record) { return (record >> 8) * (1.0 / (1 << 24)); }
+double Feature(double x) { return std::sqrt(x) * std::log1p(x); }
+bool IsValid(double x) { return x > 0.25; }
+
+void BM_SingleThread(benchmark::State& state) {
+  const auto records = MakeRecords();
+  for (auto _ : state) {
+    double sum = 0;
+    for (double x : FilterRange(
+             TransformRange(TransformRange(records, Decode), Feature),
+             IsValid)) {
+      sum += x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRecords);
+}
+
+// The argument is the batch size.
+void BM_Pipeline(benchmark::State& state) {
+  const auto records = MakeRecords();
+  PipelineOptions options;
+  options.batch_size = state.range(0);
+  PipelineStats stats;
+  for (auto _ : state) {
+    double sum = 0;
+    stats = MakePipeline(records, options)
+                .Then(
+                    [](const std::vector<uint32_t>& batch) {
+                      return TransformRange(batch, Decode);
+                    },
+                    "decode")
+                .Then(
+                    [](const std::vector<double>& batch) {
+                      return TransformRange(batch, Feature);
+                    },
+                    "feature")
+                .Then(
+                    [](const std::vector<double>& batch) {
+                      return FilterRange(batch, IsValid);
+                    },
+                    "filter")
+                .ForEach([&sum](double x) { sum += x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumRecords);
+  for (const PipelineStageStats& stage : stats.stages) {
+    state.counters[stage.name + "_items/s"] = stage.ItemsPerSecond();
+    if (stage.num_output_batches > 0) {
+      state.counters[stage.name + "_queue"] =
+          stage.mean_output_queue_occupancy;
+    }
+  }
+}
+
+BENCHMARK(BM_SingleThread)->UseRealTime();
+BENCHMARK(BM_Pipeline)->Arg(16)->Arg(256)->Arg(4096)->UseRealTime();
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,239 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/pipeline.h"
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "genit/filter_iterator.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::Le;
+
+TEST(BoundedSpscQueueTest, TransfersInOrderAcrossThreads) {
+  BoundedSpscQueue<int> queue(2);
+  std::thread producer([&queue] {
+    for (int i = 0; i < 10000; ++i) {
+      ASSERT_TRUE(queue.Push(i));
+    }
+    queue.Close();
+  });
+  std::vector<int> values;
+  int value;
+  while (queue.Pop(value)) {
+    values.push_back(value);
+  }
+  producer.join();
+  ASSERT_EQ(values.size(), 10000);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+  EXPECT_LE(queue.MaxOccupancy(), 2);
+  EXPECT_GE(queue.MeanOccupancy(), 1.0);
+}
+
+TEST(BoundedSpscQueueTest, CloseDrainsRemainingElements) {
+  BoundedSpscQueue<int> queue(4);
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  queue.Close();
+  int value;
+  EXPECT_TRUE(queue.Pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.Pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(queue.Pop(value));
+}
+
+TEST(BoundedSpscQueueTest, CancelWakesBlockedProducer) {
+  BoundedSpscQueue<int> queue(1);
+  EXPECT_TRUE(queue.Push(1));
+  std::thread canceller([&queue] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.Cancel();
+  });
+  EXPECT_FALSE(queue.Push(2));
+  canceller.join();
+  int value;
+  EXPECT_FALSE(queue.Pop(value));
+  EXPECT_GT(queue.PushWaitSeconds(), 0.0);
+}
+
+TEST(PipelineTest, WrapsAdapters) {
+  std::vector<int> values(10000);
+  for (int i = 0; i < 10000; ++i) {
+    values[i] = i;
+  }
+  std::vector<int64_t> out;
+  const PipelineStats stats =
+      MakePipeline(values, {/*batch_size=*/64, /*queue_capacity=*/2})
+          .Then(
+              [](const std::vector<int>& batch) {
+                return TransformRange(
+                    batch, [](int x) { return int64_t{x} * x; });
+              },
+              "square")
+          .Then(
+              [](const std::vector<int64_t>& batch) {
+                return FilterRange(batch,
+                                   [](int64_t x) { return x % 3 == 1; });
+              },
+              "filter")
+          .ForEach([&out](int64_t x) { out.push_back(x); });
+
+  std::vector<int64_t> expected;
+  for (int x : values) {
+    if (int64_t{x} * x % 3 == 1) {
+      expected.push_back(int64_t{x} * x);
+    }
+  }
+  EXPECT_EQ(out, expected);
+  EXPECT_FALSE(stats.cancelled);
+  ASSERT_EQ(stats.stages.size(), 4);
+  EXPECT_THAT(stats.stages,
+              ElementsAre(Field(&PipelineStageStats::name, "source"),
+                          Field(&PipelineStageStats::name, "square"),
+                          Field(&PipelineStageStats::name, "filter"),
+                          Field(&PipelineStageStats::name, "sink")));
+  EXPECT_EQ(stats.stages[0].num_input_items, 10000);
+  EXPECT_EQ(stats.stages[0].num_output_items, 10000);
+  EXPECT_EQ(stats.stages[0].num_output_batches, (10000 + 63) / 64);
+  EXPECT_EQ(stats.stages[1].num_input_items, 10000);
+  EXPECT_EQ(stats.stages[2].num_input_items, 10000);
+  EXPECT_EQ(stats.stages[2].num_output_items, expected.size());
+  EXPECT_EQ(stats.stages[3].num_input_items, expected.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_THAT(stats.stages[i].max_output_queue_occupancy, Le(2));
+  }
+  EXPECT_FALSE(stats.ToString().empty());
+}
+
+TEST(PipelineTest, RebatchesSmallOutputs) {
+  std::vector<std::size_t> batch_sizes;
+  const PipelineStats stats =
+      MakePipeline(IndexRange(0, 1000), {/*batch_size=*/10})
+          .Then([](const std::vector<int>& batch) {
+            // One output per input batch.
+            return std::vector<int>{batch.front()};
+          })
+          .ForEachBatch([&](const std::vector<int>& batch) {
+            batch_sizes.push_back(batch.size());
+          });
+  EXPECT_THAT(batch_sizes, ElementsAre(10, 10, 10, 10, 10, 10, 10, 10, 10,
+                                       10));
+  EXPECT_EQ(stats.stages[1].name, "stage 1");
+  EXPECT_EQ(stats.stages[1].num_output_batches, 10);
+}
+
+TEST(PipelineTest, MovesRvalueSource) {
+  std::vector<std::string> out;
+  MakePipeline(std::vector<std::string>{"a", "b", "c"})
+      .Then([](const std::vector<std::string>& batch) {
+        return TransformRange(batch,
+                              [](const std::string& s) { return s + s; });
+      })
+      .ForEach([&out](const std::string& s) { out.push_back(s); });
+  EXPECT_THAT(out, ElementsAre("aa", "bb", "cc"));
+}
+
+TEST(PipelineTest, EmptySource) {
+  int count = 0;
+  const PipelineStats stats =
+      MakePipeline(std::vector<int>())
+          .Then([](const std::vector<int>& batch) { return batch; })
+          .ForEach([&count](int) { ++count; });
+  EXPECT_EQ(count, 0);
+  EXPECT_EQ(stats.stages[0].num_output_batches, 0);
+}
+
+TEST(PipelineTest, AppliesBackpressure) {
+  std::size_t count = 0;
+  const PipelineStats stats =
+      MakePipeline(IndexRange(0, 2000),
+                   {/*batch_size=*/100, /*queue_capacity=*/1})
+          .ForEachBatch([&count](const std::vector<int>& batch) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            count += batch.size();
+          });
+  EXPECT_EQ(count, 2000);
+  EXPECT_EQ(stats.stages[0].max_output_queue_occupancy, 1);
+  // The source waited for the slow consumer.
+  EXPECT_GT(stats.stages[0].output_wait_seconds, 0.0);
+}
+
+TEST(PipelineTest, PropagatesErrors) {
+  auto pipeline =
+      MakePipeline(IndexRange(0, 1 << 30), {/*batch_size=*/16})
+          .Then([](const std::vector<int>& batch) {
+            if (batch.front() >= 1000) {
+              throw std::runtime_error("bad record");
+            }
+            return batch;
+          });
+  EXPECT_THROW(pipeline.ForEach([](int) {}), std::runtime_error);
+}
+
+TEST(PipelineTest, PropagatesConsumerErrors) {
+  EXPECT_THROW(MakePipeline(IndexRange(0, 1 << 30)).ForEach([](int x) {
+    if (x == 5000) {
+      throw std::logic_error("bad value");
+    }
+  }),
+               std::logic_error);
+}
+
+TEST(PipelineTest, CancelsFromConsumer) {
+  auto pipeline =
+      MakePipeline(IndexRange(0, 1 << 30), {/*batch_size=*/16})
+          .Then([](const std::vector<int>& batch) {
+            return TransformRange(batch, [](int x) { return x + 1; });
+          });
+  int last = 0;
+  const PipelineStats stats = pipeline.ForEach([&](int x) {
+    last = x;
+    if (x == 100) {
+      pipeline.Cancel();
+    }
+  });
+  EXPECT_TRUE(stats.cancelled);
+  EXPECT_GE(last, 100);
+  EXPECT_LT(stats.stages[0].num_input_items, 1 << 30);
+}
+
+TEST(PipelineTest, CancelsFromAnotherThread) {
+  auto pipeline = MakePipeline(IndexRange(0, 1 << 30));
+  std::thread canceller([&pipeline] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pipeline.Cancel();
+  });
+  const PipelineStats stats = pipeline.ForEach([](int) {});
+  canceller.join();
+  EXPECT_TRUE(stats.cancelled);
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,306 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENIT_RANK_SELECT_H_
+#define GENIT_RANK_SELECT_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+namespace rank_select_detail {
+
+inline int PopCount(uint64_t word) { return __builtin_popcountll(word); }
+
+// Returns the position of the k-th (0-based) set bit of word. Requires
+// k < PopCount(word).
+inline int SelectInWord(uint64_t word, int k) {
+#if defined(__BMI2__)
+  return __builtin_ctzll(_pdep_u64(uint64_t{1} << k, word));
+#else
+  // Find the byte containing the bit, then clear the lower set bits.
+  int offset = 0;
+  for (int count = PopCount(word & 0xff); k >= count;
+       count = PopCount(word & 0xff)) {
+    k -= count;
+    word >>= 8;
+    offset += 8;
+  }
+  for (; k > 0; --k) {
+    word &= word - 1;
+  }
+  return offset + __builtin_ctzll(word);
+#endif
+}
+
+}  // namespace rank_select_detail
+
+// Forward-decl.
+class RankSelect;
+
+// Random-access iterator over the indices of the set bits of a RankSelect.
+// Incrementing scans for the next set bit, and advancing by more than one
+// element uses RankSelect::Select().
+class SetBitIterator
+    : public IteratorFacade<SetBitIterator, std::size_t,
+                            std::random_access_iterator_tag> {
+ public:
+  SetBitIterator() = default;
+  inline SetBitIterator(const RankSelect* parent, std::size_t rank);
+
+  // Returns the number of set bits before the current one.
+  std::size_t rank() const { return rank_; }
+
+ private:
+  friend class IteratorFacadePrivateAccess<SetBitIterator>;
+
+  std::size_t Dereference() const { return pos_; }
+  inline void Increment();
+  inline void Decrement();
+  bool IsEqual(const SetBitIterator& rhs) const { return rank_ == rhs.rank_; }
+  int DistanceTo(const SetBitIterator& rhs) const {
+    return static_cast<int>(rhs.rank_ - rank_);
+  }
+  inline void Advance(int n);
+
+  const RankSelect* parent_ = nullptr;
+  // Number of set bits before pos_.
+  std::size_t rank_ = 0;
+  // Index of the current set bit, or the number of bits for the end.
+  std::size_t pos_ = 0;
+};
+
+// A RankSelect is a succinct index over an array of uint64_t words, viewed as
+// a bit vector (bit i is bit i % 64 of word i / 64). It answers
+//  - Rank(i): the number of set bits before bit i, and
+//  - Select(k): the index of the k-th set bit,
+// in (nearly) constant time, e.g., to split the set bits of a large mask
+// evenly across threads, or to sample set bits at random:
+//
+//   const RankSelect index(mask_words, num_bits);
+//   const std::size_t n = index.CountSetBits();
+//   for (int t = 0; t < num_threads; ++t) {
+//     for (std::size_t bit : index.SetBitIndices(n * t / num_threads,
+//                                                n * (t + 1) / num_threads)) {
+//       ...
+//     }
+//   }
+//
+// The words are not copied, and must outlive the index (and must not be
+// modified while the index is used).
+//
+// Layout: the cumulative count of set bits is stored (as uint64_t) for every
+// superblock of 8192 bits, and relative to the superblock (as uint16_t) for
+// every block of 512 bits. This takes 1/128 + 1/32 < 4% of the size of the bit
+// vector. Rank() then needs at most 8 popcounts, and Select() does a binary
+// search over the superblocks, a scan over (at most 16) blocks, and at most 8
+// popcounts before selecting within a word.
+class RankSelect {
+ public:
+  static constexpr std::size_t kWordsPerBlock = 8;
+  static constexpr std::size_t kBlocksPerSuperblock = 16;
+  static constexpr std::size_t kWordsPerSuperblock =
+      kWordsPerBlock * kBlocksPerSuperblock;
+
+  RankSelect() = default;
+
+  // Builds the index over the first num_bits bits of words.
+  RankSelect(const uint64_t* words, std::size_t num_bits)
+      : words_(words), num_bits_(num_bits) {
+    const std::size_t num_words = NumWords();
+    superblock_ranks_.reserve(num_words / kWordsPerSuperblock + 1);
+    block_ranks_.reserve(num_words / kWordsPerBlock + 1);
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < num_words; ++w) {
+      if (w % kWordsPerSuperblock == 0) {
+        superblock_ranks_.push_back(count);
+      }
+      if (w % kWordsPerBlock == 0) {
+        block_ranks_.push_back(
+            static_cast<uint16_t>(count - superblock_ranks_.back()));
+      }
+      count += rank_select_detail::PopCount(Word(w));
+    }
+    num_set_bits_ = count;
+  }
+
+  // Builds the index over all bits of a contiguous range of words, e.g., a
+  // std::vector<uint64_t>.
+  template <typename WordRange>
+  explicit RankSelect(const WordRange& words)
+      : RankSelect(std::data(words), std::size(words) * 64) {}
+
+  // Returns the number of bits.
+  std::size_t size() const { return num_bits_; }
+
+  // Returns the number of set bits.
+  std::size_t CountSetBits() const { return num_set_bits_; }
+
+  // Returns whether bit i is set.
+  bool Test(std::size_t i) const {
+    assert(i < num_bits_);
+    return (words_[i / 64] >> (i % 64)) & 1;
+  }
+
+  // Returns the number of set bits in [0, i), for i <= size().
+  std::size_t Rank(std::size_t i) const {
+    assert(i <= num_bits_);
+    if (i == num_bits_) {
+      return num_set_bits_;
+    }
+    const std::size_t w = i / 64;
+    const std::size_t block = w / kWordsPerBlock;
+    std::size_t rank =
+        superblock_ranks_[w / kWordsPerSuperblock] + block_ranks_[block];
+    for (std::size_t j = block * kWordsPerBlock; j < w; ++j) {
+      rank += rank_select_detail::PopCount(Word(j));
+    }
+    if (i % 64 != 0) {
+      rank += rank_select_detail::PopCount(Word(w) &
+                                           ((uint64_t{1} << (i % 64)) - 1));
+    }
+    return rank;
+  }
+
+  // Returns the index of the k-th (0-based) set bit, for k < CountSetBits().
+  std::size_t Select(std::size_t k) const {
+    assert(k < num_set_bits_);
+    // Last superblock starting with at most k set bits before it.
+    const std::size_t superblock =
+        std::upper_bound(superblock_ranks_.begin(), superblock_ranks_.end(),
+                         k) -
+        superblock_ranks_.begin() - 1;
+    k -= superblock_ranks_[superblock];
+    // Last block in the superblock starting with at most k set bits before it.
+    std::size_t block = superblock * kBlocksPerSuperblock;
+    const std::size_t last_block =
+        std::min(block + kBlocksPerSuperblock, block_ranks_.size());
+    while (block + 1 < last_block && block_ranks_[block + 1] <= k) {
+      ++block;
+    }
+    k -= block_ranks_[block];
+    for (std::size_t w = block * kWordsPerBlock;; ++w) {
+      const uint64_t word = Word(w);
+      const std::size_t count = rank_select_detail::PopCount(word);
+      if (k < count) {
+        return w * 64 + rank_select_detail::SelectInWord(word, k);
+      }
+      k -= count;
+    }
+  }
+
+  // Returns a random-access range over the indices of the set bits, in
+  // increasing order.
+  IteratorRange<SetBitIterator> SetBitIndices() const {
+    return SetBitIndices(0, num_set_bits_);
+  }
+
+  // Returns a random-access range over the indices of the set bits with ranks
+  // in [first_rank, last_rank).
+  IteratorRange<SetBitIterator> SetBitIndices(std::size_t first_rank,
+                                              std::size_t last_rank) const {
+    assert(first_rank <= last_rank && last_rank <= num_set_bits_);
+    return IteratorRange<SetBitIterator>(SetBitIterator(this, first_rank),
+                                         SetBitIterator(this, last_rank));
+  }
+
+  // Returns the memory used by the index (not counting the words) in bytes.
+  std::size_t IndexSizeInBytes() const {
+    return superblock_ranks_.capacity() * sizeof(uint64_t) +
+           block_ranks_.capacity() * sizeof(uint16_t);
+  }
+
+ private:
+  friend class SetBitIterator;
+
+  std::size_t NumWords() const { return (num_bits_ + 63) / 64; }
+
+  // Returns the w-th word, without the bits past num_bits_.
+  uint64_t Word(std::size_t w) const {
+    const uint64_t word = words_[w];
+    if ((w + 1) * 64 > num_bits_ && num_bits_ % 64 != 0) {
+      return word & ((uint64_t{1} << (num_bits_ % 64)) - 1);
+    }
+    return word;
+  }
+
+  // Returns the index of the first set bit at or after i. Requires that there
+  // is one.
+  std::size_t NextSetBit(std::size_t i) const {
+    std::size_t w = i / 64;
+    uint64_t word = Word(w) & (~uint64_t{0} << (i % 64));
+    while (word == 0) {
+      word = Word(++w);
+    }
+    return w * 64 + __builtin_ctzll(word);
+  }
+
+  // Returns the index of the last set bit at or before i. Requires that there
+  // is one.
+  std::size_t PrevSetBit(std::size_t i) const {
+    std::size_t w = i / 64;
+    uint64_t word = Word(w) & (~uint64_t{0} >> (63 - i % 64));
+    while (word == 0) {
+      word = Word(--w);
+    }
+    return w * 64 + 63 - __builtin_clzll(word);
+  }
+
+  const uint64_t* words_ = nullptr;
+  std::size_t num_bits_ = 0;
+  std::size_t num_set_bits_ = 0;
+  std::vector<uint64_t> superblock_ranks_;
+  std::vector<uint16_t> block_ranks_;
+};
+
+SetBitIterator::SetBitIterator(const RankSelect* parent, std::size_t rank)
+    : parent_(parent),
+      rank_(rank),
+      pos_(rank < parent->CountSetBits() ? parent->Select(rank)
+                                         : parent->size()) {}
+
+void SetBitIterator::Increment() {
+  ++rank_;
+  pos_ = rank_ < parent_->CountSetBits() ? parent_->NextSetBit(pos_ + 1)
+                                         : parent_->size();
+}
+
+void SetBitIterator::Decrement() {
+  --rank_;
+  pos_ = parent_->PrevSetBit(pos_ - 1);
+}
+
+void SetBitIterator::Advance(int n) {
+  rank_ += n;
+  pos_ = rank_ < parent_->CountSetBits() ? parent_->Select(rank_)
+                                         : parent_->size();
+}
+
+}  // namespace genit
+
+#endif  // GENIT_RANK_SELECT_H_
@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures RankSelect queries and iteration over set bits for bit vectors of
+// 2^20 to 2^26 bits, compared to iterating the set bits of each word with
+// AllSetBitIndices.
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/bitset_iterator.h"
+#include "genit/rank_select.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumQueries = 1024;
+
+// About 1/4 of the bits are set.
+std::vector<uint64_t> MakeWords(std::size_t num_bits) {
+  std::mt19937_64 rng(num_bits);
+  std::vector<uint64_t> words(num_bits / 64);
+  for (uint64_t& word : words) {
+    word = rng() & rng();
+  }
+  return words;
+}
+
+std::vector<std::size_t> MakeQueries(std::size_t n) {
+  std::mt19937_64 rng(1);
+  std::vector<std::size_t> queries(kNumQueries);
+  for (std::size_t& query : queries) {
+    query = rng() % n;
+  }
+  return queries;
+}
+
+void BM_Build(benchmark::State& state) {
+  const auto words = MakeWords(state.range(0));
+  for (auto _ : state) {
+    RankSelect index(words);
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetBytesProcessed(state.iterations() * words.size() * 8);
+}
+
+void BM_Rank(benchmark::State& state) {
+  const auto words = MakeWords(state.range(0));
+  const RankSelect index(words);
+  const auto queries = MakeQueries(index.size());
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (std::size_t i : queries) {
+      sum += index.Rank(i);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+
+void BM_Select(benchmark::State& state) {
+  const auto words = MakeWords(state.range(0));
+  const RankSelect index(words);
+  const auto queries = MakeQueries(index.CountSetBits());
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (std::size_t k : queries) {
+      sum += index.Select(k);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumQueries);
+}
+
+void BM_IterateSetBitIndices(benchmark::State& state) {
+  const auto words = MakeWords(state.range(0));
+  const RankSelect index(words);
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (std::size_t i : index.SetBitIndices()) {
+      sum += i;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * index.CountSetBits());
+}
+
+void BM_IterateAllSetBitIndicesPerWord(benchmark::State& state) {
+  const auto words = MakeWords(state.range(0));
+  std::size_t num_set_bits = 0;
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    num_set_bits = 0;
+    for (std::size_t w = 0; w < words.size(); ++w) {
+      for (int i : AllSetBitIndices(words[w])) {
+        sum += w * 64 + i;
+        ++num_set_bits;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * num_set_bits);
+}
+
+BENCHMARK(BM_Build)->Range(1 << 20, 1 << 26);
+BENCHMARK(BM_Rank)->Range(1 << 20, 1 << 26);
+BENCHMARK(BM_Select)->Range(1 << 20, 1 << 26);
+BENCHMARK(BM_IterateSetBitIndices)->Range(1 << 20, 1 << 26);
+BENCHMARK(BM_IterateAllSetBitIndicesPerWord)->Range(1 << 20, 1 << 26);
+
+}  // namespace
+}  // namespace genit
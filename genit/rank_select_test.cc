@@ -0,0 +1,170 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/rank_select.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// Returns words with each bit set with the given probability.
+std::vector<uint64_t> RandomWords(std::size_t num_words, double density,
+                                  int seed) {
+  std::mt19937_64 rng(seed);
+  std::bernoulli_distribution bit(density);
+  std::vector<uint64_t> words(num_words, 0);
+  for (std::size_t i = 0; i < num_words * 64; ++i) {
+    if (bit(rng)) {
+      words[i / 64] |= uint64_t{1} << (i % 64);
+    }
+  }
+  return words;
+}
+
+std::vector<std::size_t> SetBitsByScan(const std::vector<uint64_t>& words,
+                                       std::size_t num_bits) {
+  std::vector<std::size_t> bits;
+  for (std::size_t i = 0; i < num_bits; ++i) {
+    if ((words[i / 64] >> (i % 64)) & 1) {
+      bits.push_back(i);
+    }
+  }
+  return bits;
+}
+
+TEST(RankSelectTest, SelectInWord) {
+  const uint64_t word = 0x8000'0000'0001'0112;
+  EXPECT_EQ(rank_select_detail::SelectInWord(word, 0), 1);
+  EXPECT_EQ(rank_select_detail::SelectInWord(word, 1), 4);
+  EXPECT_EQ(rank_select_detail::SelectInWord(word, 2), 8);
+  EXPECT_EQ(rank_select_detail::SelectInWord(word, 3), 16);
+  EXPECT_EQ(rank_select_detail::SelectInWord(word, 4), 63);
+}
+
+TEST(RankSelectTest, Empty) {
+  const RankSelect index;
+  EXPECT_EQ(index.size(), 0);
+  EXPECT_EQ(index.CountSetBits(), 0);
+  EXPECT_EQ(index.Rank(0), 0);
+  EXPECT_THAT(index.SetBitIndices(), IsEmpty());
+}
+
+TEST(RankSelectTest, SmallBitVector) {
+  const std::vector<uint64_t> words = {0b1010'0110, 0, uint64_t{1} << 63};
+  const RankSelect index(words);
+  EXPECT_EQ(index.size(), 192);
+  EXPECT_EQ(index.CountSetBits(), 5);
+  EXPECT_TRUE(index.Test(1));
+  EXPECT_FALSE(index.Test(0));
+  EXPECT_EQ(index.Rank(0), 0);
+  EXPECT_EQ(index.Rank(2), 1);
+  EXPECT_EQ(index.Rank(3), 2);
+  EXPECT_EQ(index.Rank(100), 4);
+  EXPECT_EQ(index.Rank(191), 4);
+  EXPECT_EQ(index.Rank(192), 5);
+  EXPECT_EQ(index.Select(3), 7);
+  EXPECT_EQ(index.Select(4), 191);
+  EXPECT_THAT(index.SetBitIndices(), ElementsAre(1, 2, 5, 7, 191));
+}
+
+TEST(RankSelectTest, IgnoresBitsPastSize) {
+  const std::vector<uint64_t> words = {~uint64_t{0}, ~uint64_t{0}};
+  const RankSelect index(words.data(), 70);
+  EXPECT_EQ(index.CountSetBits(), 70);
+  EXPECT_EQ(index.Rank(70), 70);
+  EXPECT_EQ(index.Select(69), 69);
+  EXPECT_EQ(index.SetBitIndices().size(), 70);
+}
+
+TEST(RankSelectTest, MatchesScan) {
+  for (const double density : {0.001, 0.05, 0.5, 0.99}) {
+    // Several superblocks, with a partial last word.
+    const std::vector<uint64_t> words = RandomWords(1000, density, 1);
+    const std::size_t num_bits = words.size() * 64 - 13;
+    const RankSelect index(words.data(), num_bits);
+    const std::vector<std::size_t> expected = SetBitsByScan(words, num_bits);
+    ASSERT_EQ(index.CountSetBits(), expected.size()) << density;
+    for (std::size_t k = 0; k < expected.size(); ++k) {
+      ASSERT_EQ(index.Select(k), expected[k]) << density << " " << k;
+    }
+    std::size_t rank = 0;
+    for (std::size_t i = 0; i <= num_bits; ++i) {
+      ASSERT_EQ(index.Rank(i), rank) << density << " " << i;
+      if (i < num_bits && index.Test(i)) {
+        ++rank;
+      }
+    }
+    const auto bits = index.SetBitIndices();
+    EXPECT_EQ(std::vector<std::size_t>(bits.begin(), bits.end()), expected);
+  }
+}
+
+TEST(RankSelectTest, SetBitIndicesIsRandomAccess) {
+  const std::vector<uint64_t> words = RandomWords(300, 0.1, 2);
+  const RankSelect index(words);
+  const std::vector<std::size_t> expected =
+      SetBitsByScan(words, words.size() * 64);
+  const auto bits = index.SetBitIndices();
+  using It = decltype(bits.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  ASSERT_EQ(bits.size(), expected.size());
+  for (std::size_t k = 0; k < expected.size(); k += 17) {
+    EXPECT_EQ(bits[k], expected[k]);
+    EXPECT_EQ((bits.begin() + k).rank(), k);
+  }
+  std::vector<std::size_t> reversed;
+  for (auto it = bits.end(); it != bits.begin();) {
+    reversed.push_back(*--it);
+  }
+  EXPECT_EQ(std::vector<std::size_t>(reversed.rbegin(), reversed.rend()),
+            expected);
+}
+
+TEST(RankSelectTest, SplitsSetBitsEvenly) {
+  const std::vector<uint64_t> words = RandomWords(500, 0.3, 3);
+  const RankSelect index(words);
+  const std::size_t n = index.CountSetBits();
+  constexpr int kNumParts = 7;
+  std::vector<std::size_t> all;
+  for (int part = 0; part < kNumParts; ++part) {
+    const auto bits =
+        index.SetBitIndices(n * part / kNumParts, n * (part + 1) / kNumParts);
+    EXPECT_NEAR(bits.size(), double(n) / kNumParts, 1.0);
+    all.insert(all.end(), bits.begin(), bits.end());
+  }
+  EXPECT_EQ(all, SetBitsByScan(words, words.size() * 64));
+}
+
+TEST(RankSelectTest, MemoryOverhead) {
+  const std::vector<uint64_t> words(1 << 16, 0x5555'5555'5555'5555);
+  const RankSelect index(words);
+  EXPECT_LT(index.IndexSizeInBytes(),
+            0.05 * words.size() * sizeof(uint64_t));
+}
+
+}  // namespace
+}  // namespace genit
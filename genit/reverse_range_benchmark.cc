@@ -0,0 +1,142 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares ReverseRange, which uses the native reverse iterators of filter,
+// concat and adjacent ranges, against wrapping their iterators in
+// std::reverse_iterator (the previous implementation of ReverseRange).
+// Forward iteration is included as a baseline.
+
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/adjacent_iterator.h"
+#include "genit/concat_range.h"
+#include "genit/filter_iterator.h"
+#include "genit/iterator_range.h"
+
+namespace genit {
+namespace {
+
+enum class Direction { kForward, kNativeReverse, kStdReverse };
+
+template <Direction D, typename Range, typename Fn>
+void ForEach(const Range& range, Fn fn) {
+  if constexpr (D == Direction::kForward) {
+    for (auto&& x : range) {
+      fn(x);
+    }
+  } else if constexpr (D == Direction::kNativeReverse) {
+    for (auto&& x : ReverseRange(range)) {
+      fn(x);
+    }
+  } else {
+    for (auto&& x : MakeIteratorRange(std::make_reverse_iterator(range.end()),
+                                      std::make_reverse_iterator(
+                                          range.begin()))) {
+      fn(x);
+    }
+  }
+}
+
+std::vector<int> MakeValues(int n) {
+  std::vector<int> values(n);
+  for (int i = 0; i < n; ++i) {
+    values[i] = (i * 37) % 101;
+  }
+  return values;
+}
+
+template <Direction D>
+void BM_Filter(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const auto range = FilterRange(values, [](int x) { return x % 3 != 0; });
+  for (auto _ : state) {
+    int sum = 0;
+    ForEach<D>(range, [&sum](int x) { sum += x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// With an opaque predicate, std::reverse_iterator evaluates it twice per
+// element.
+template <Direction D>
+void BM_FilterOpaquePredicate(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const std::function<bool(int)> pred = [](int x) { return x % 3 != 0; };
+  const auto range = FilterRange(values, pred);
+  for (auto _ : state) {
+    int sum = 0;
+    ForEach<D>(range, [&sum](int x) { sum += x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+template <Direction D>
+void BM_Concat(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const int n = values.size();
+  const std::vector<int> a(values.begin(), values.begin() + n / 4);
+  const std::vector<int> b(values.begin() + n / 4, values.begin() + n / 2);
+  const std::vector<int> c(values.begin() + n / 2, values.end());
+  const auto range = ConcatenateRanges(a, b, c);
+  for (auto _ : state) {
+    int sum = 0;
+    ForEach<D>(range, [&sum](int x) { sum += x; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// std::reverse_iterator<AdjacentIterator> is not compared, since decrementing
+// the end AdjacentIterator produces a window reaching past the end.
+template <Direction D>
+void BM_Adjacent(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const auto range = AdjacentElementsRange<3>(values);
+  for (auto _ : state) {
+    int sum = 0;
+    ForEach<D>(range,
+               [&sum](const auto& w) { sum += w[0] * w[2] - w[1]; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Filter, Direction::kForward)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Filter, Direction::kNativeReverse)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Filter, Direction::kStdReverse)->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_FilterOpaquePredicate, Direction::kForward)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_FilterOpaquePredicate, Direction::kNativeReverse)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_FilterOpaquePredicate, Direction::kStdReverse)
+    ->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_Concat, Direction::kForward)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Concat, Direction::kNativeReverse)
+    ->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Concat, Direction::kStdReverse)->Range(1 << 8, 1 << 16);
+
+BENCHMARK_TEMPLATE(BM_Adjacent, Direction::kForward)->Range(1 << 8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Adjacent, Direction::kNativeReverse)
+    ->Range(1 << 8, 1 << 16);
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,712 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENIT_ROARING_BITMAP_H_
+#define GENIT_ROARING_BITMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "genit/bit_kernels.h"
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+
+namespace genit {
+
+namespace roaring_bitmap_detail {
+
+// Number of 64-bit words of a bitmap container (2^16 bits).
+constexpr int kBitmapWords = 1024;
+// Largest cardinality of an array container: above it, a bitmap container is
+// smaller.
+constexpr int kMaxArraySize = 4096;
+
+// Sorted values.
+struct ArrayContainer {
+  std::vector<uint16_t> values;
+};
+
+struct BitmapContainer {
+  std::vector<uint64_t> words;
+  int cardinality = 0;
+};
+
+// The values in [first, last].
+struct Run {
+  uint16_t first;
+  uint16_t last;
+};
+
+// Sorted, disjoint and non-adjacent runs.
+struct RunContainer {
+  std::vector<Run> runs;
+};
+
+// The low 16 bits of the values of a 2^16 chunk. Containers are never empty.
+using Container = std::variant<ArrayContainer, BitmapContainer, RunContainer>;
+
+inline int Cardinality(const Container& c) {
+  if (const auto* array = std::get_if<ArrayContainer>(&c)) {
+    return array->values.size();
+  } else if (const auto* bitmap = std::get_if<BitmapContainer>(&c)) {
+    return bitmap->cardinality;
+  }
+  int cardinality = 0;
+  for (const Run& run : std::get<RunContainer>(c).runs) {
+    cardinality += run.last - run.first + 1;
+  }
+  return cardinality;
+}
+
+inline bool Contains(const Container& c, uint16_t value) {
+  if (const auto* array = std::get_if<ArrayContainer>(&c)) {
+    return std::binary_search(array->values.begin(), array->values.end(),
+                              value);
+  } else if (const auto* bitmap = std::get_if<BitmapContainer>(&c)) {
+    return (bitmap->words[value / 64] >> (value % 64)) & 1;
+  }
+  const auto& runs = std::get<RunContainer>(c).runs;
+  // First run starting after value.
+  const auto it = std::upper_bound(
+      runs.begin(), runs.end(), value,
+      [](uint16_t v, const Run& run) { return v < run.first; });
+  return it != runs.begin() && value <= std::prev(it)->last;
+}
+
+// Sets the bits in [first, last] of words.
+inline void SetBits(int first, int last, uint64_t* words) {
+  const int first_word = first / 64;
+  const int last_word = last / 64;
+  const uint64_t first_mask = ~uint64_t{0} << (first % 64);
+  const uint64_t last_mask = ~uint64_t{0} >> (63 - last % 64);
+  if (first_word == last_word) {
+    words[first_word] |= first_mask & last_mask;
+    return;
+  }
+  words[first_word] |= first_mask;
+  std::fill(words + first_word + 1, words + last_word, ~uint64_t{0});
+  words[last_word] |= last_mask;
+}
+
+// Sets the bits of the values of c in words.
+inline void OrInto(const Container& c, uint64_t* words) {
+  if (const auto* array = std::get_if<ArrayContainer>(&c)) {
+    for (uint16_t value : array->values) {
+      words[value / 64] |= uint64_t{1} << (value % 64);
+    }
+  } else if (const auto* bitmap = std::get_if<BitmapContainer>(&c)) {
+    for (int i = 0; i < kBitmapWords; ++i) {
+      words[i] |= bitmap->words[i];
+    }
+  } else {
+    for (const Run& run : std::get<RunContainer>(c).runs) {
+      SetBits(run.first, run.last, words);
+    }
+  }
+}
+
+// Returns the words of c, which are stored in scratch unless c is a bitmap
+// container.
+inline const uint64_t* WordsOf(const Container& c,
+                               std::vector<uint64_t>& scratch) {
+  if (const auto* bitmap = std::get_if<BitmapContainer>(&c)) {
+    return bitmap->words.data();
+  }
+  scratch.assign(kBitmapWords, 0);
+  OrInto(c, scratch.data());
+  return scratch.data();
+}
+
+// Returns an array or a bitmap container holding the set bits of words, or an
+// empty array container.
+inline Container FromWords(std::vector<uint64_t> words) {
+  const int cardinality = CountSetBitsInWords(words.data(), words.size());
+  if (cardinality > kMaxArraySize) {
+    return BitmapContainer{std::move(words), cardinality};
+  }
+  ArrayContainer array;
+  array.values.reserve(cardinality);
+  for (int i = 0; i < kBitmapWords; ++i) {
+    for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+      array.values.push_back(i * 64 + __builtin_ctzll(word));
+    }
+  }
+  return array;
+}
+
+// Returns an array container, or a bitmap container if values has more than
+// kMaxArraySize elements.
+inline Container FromValues(std::vector<uint16_t> values) {
+  if (values.size() <= kMaxArraySize) {
+    return ArrayContainer{std::move(values)};
+  }
+  BitmapContainer bitmap{std::vector<uint64_t>(kBitmapWords, 0),
+                         static_cast<int>(values.size())};
+  OrInto(ArrayContainer{std::move(values)}, bitmap.words.data());
+  return bitmap;
+}
+
+// Keeps the values of array for which pred(value) is true.
+template <typename Pred>
+Container FilterArray(const ArrayContainer& array, Pred pred) {
+  ArrayContainer result;
+  std::copy_if(array.values.begin(), array.values.end(),
+               std::back_inserter(result.values), pred);
+  return result;
+}
+
+// Returns an array or a bitmap container holding the set bits of
+// op(a[i], b[i]), or an empty array container. Counts the set bits first, so
+// that small results are written directly to an array.
+template <typename Op>
+Container CombineWords(const uint64_t* a, const uint64_t* b, Op op) {
+  int cardinality = 0;
+  for (int i = 0; i < kBitmapWords; ++i) {
+    cardinality += __builtin_popcountll(op(a[i], b[i]));
+  }
+  if (cardinality > kMaxArraySize) {
+    BitmapContainer bitmap{std::vector<uint64_t>(kBitmapWords), cardinality};
+    for (int i = 0; i < kBitmapWords; ++i) {
+      bitmap.words[i] = op(a[i], b[i]);
+    }
+    return bitmap;
+  }
+  ArrayContainer array;
+  array.values.reserve(cardinality);
+  for (int i = 0; i < kBitmapWords; ++i) {
+    for (uint64_t word = op(a[i], b[i]); word != 0; word &= word - 1) {
+      array.values.push_back(i * 64 + __builtin_ctzll(word));
+    }
+  }
+  return array;
+}
+
+// Appends [first, last] to runs, merging it with the last run if they overlap
+// or are adjacent. Requires first >= runs.back().first.
+inline void AppendRun(int first, int last, std::vector<Run>& runs) {
+  if (!runs.empty() && first <= runs.back().last + 1) {
+    runs.back().last = std::max<int>(runs.back().last, last);
+  } else {
+    runs.push_back(Run{static_cast<uint16_t>(first),
+                       static_cast<uint16_t>(last)});
+  }
+}
+
+inline Container And(const Container& a, const Container& b) {
+  const auto* a_array = std::get_if<ArrayContainer>(&a);
+  const auto* b_array = std::get_if<ArrayContainer>(&b);
+  if (a_array != nullptr && b_array != nullptr) {
+    ArrayContainer result;
+    std::set_intersection(a_array->values.begin(), a_array->values.end(),
+                          b_array->values.begin(), b_array->values.end(),
+                          std::back_inserter(result.values));
+    return result;
+  } else if (a_array != nullptr || b_array != nullptr) {
+    const Container& other = a_array != nullptr ? b : a;
+    return FilterArray(a_array != nullptr ? *a_array : *b_array,
+                       [&other](uint16_t v) { return Contains(other, v); });
+  }
+  const auto* a_runs = std::get_if<RunContainer>(&a);
+  const auto* b_runs = std::get_if<RunContainer>(&b);
+  if (a_runs != nullptr && b_runs != nullptr) {
+    RunContainer result;
+    auto i = a_runs->runs.begin();
+    auto j = b_runs->runs.begin();
+    while (i != a_runs->runs.end() && j != b_runs->runs.end()) {
+      const int first = std::max(i->first, j->first);
+      const int last = std::min(i->last, j->last);
+      if (first <= last) {
+        AppendRun(first, last, result.runs);
+      }
+      if (i->last < j->last) {
+        ++i;
+      } else {
+        ++j;
+      }
+    }
+    if (result.runs.empty()) {
+      return ArrayContainer();
+    }
+    return result;
+  }
+  std::vector<uint64_t> a_scratch;
+  std::vector<uint64_t> b_scratch;
+  const uint64_t* a_words = WordsOf(a, a_scratch);
+  const uint64_t* b_words = WordsOf(b, b_scratch);
+  return CombineWords(a_words, b_words,
+                      [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+inline Container Or(const Container& a, const Container& b) {
+  const auto* a_array = std::get_if<ArrayContainer>(&a);
+  const auto* b_array = std::get_if<ArrayContainer>(&b);
+  if (a_array != nullptr && b_array != nullptr) {
+    std::vector<uint16_t> values;
+    values.reserve(a_array->values.size() + b_array->values.size());
+    std::set_union(a_array->values.begin(), a_array->values.end(),
+                   b_array->values.begin(), b_array->values.end(),
+                   std::back_inserter(values));
+    return FromValues(std::move(values));
+  }
+  const auto* a_runs = std::get_if<RunContainer>(&a);
+  const auto* b_runs = std::get_if<RunContainer>(&b);
+  if (a_runs != nullptr && b_runs != nullptr) {
+    RunContainer result;
+    auto i = a_runs->runs.begin();
+    auto j = b_runs->runs.begin();
+    while (i != a_runs->runs.end() || j != b_runs->runs.end()) {
+      const bool take_a = j == b_runs->runs.end() ||
+                          (i != a_runs->runs.end() && i->first < j->first);
+      const Run& run = take_a ? *i++ : *j++;
+      AppendRun(run.first, run.last, result.runs);
+    }
+    return result;
+  }
+  std::vector<uint64_t> scratch;
+  const uint64_t* a_words = WordsOf(a, scratch);
+  std::vector<uint64_t> words(a_words, a_words + kBitmapWords);
+  OrInto(b, words.data());
+  return FromWords(std::move(words));
+}
+
+inline Container AndNot(const Container& a, const Container& b) {
+  if (const auto* a_array = std::get_if<ArrayContainer>(&a)) {
+    return FilterArray(*a_array,
+                       [&b](uint16_t v) { return !Contains(b, v); });
+  }
+  std::vector<uint64_t> a_scratch;
+  std::vector<uint64_t> b_scratch;
+  const uint64_t* a_words = WordsOf(a, a_scratch);
+  const uint64_t* b_words = WordsOf(b, b_scratch);
+  return CombineWords(a_words, b_words,
+                      [](uint64_t x, uint64_t y) { return x & ~y; });
+}
+
+// Returns the runs of the values of c.
+inline RunContainer ToRuns(const Container& c) {
+  if (const auto* runs = std::get_if<RunContainer>(&c)) {
+    return *runs;
+  }
+  RunContainer result;
+  if (const auto* array = std::get_if<ArrayContainer>(&c)) {
+    for (uint16_t value : array->values) {
+      AppendRun(value, value, result.runs);
+    }
+    return result;
+  }
+  const auto& words = std::get<BitmapContainer>(c).words;
+  for (int i = 0; i < kBitmapWords; ++i) {
+    for (uint64_t word = words[i]; word != 0;) {
+      // Find the next run of ones in the word.
+      const int first = __builtin_ctzll(word);
+      const uint64_t ones = word | (word - 1);
+      const int last = ones == ~uint64_t{0} ? 63 : __builtin_ctzll(~ones) - 1;
+      AppendRun(i * 64 + first, i * 64 + last, result.runs);
+      word &= last == 63 ? 0 : ~uint64_t{0} << (last + 1);
+    }
+  }
+  return result;
+}
+
+inline std::size_t SizeInBytes(const Container& c) {
+  if (const auto* array = std::get_if<ArrayContainer>(&c)) {
+    return array->values.capacity() * sizeof(uint16_t);
+  } else if (const auto* bitmap = std::get_if<BitmapContainer>(&c)) {
+    return bitmap->words.capacity() * sizeof(uint64_t);
+  }
+  return std::get<RunContainer>(c).runs.capacity() * sizeof(Run);
+}
+
+}  // namespace roaring_bitmap_detail
+
+// Forward-decl.
+class RoaringBitmap;
+
+// Forward iterator over the values of a RoaringBitmap, in increasing order.
+class RoaringBitmapIterator
+    : public IteratorFacade<RoaringBitmapIterator, uint32_t,
+                            std::forward_iterator_tag> {
+ public:
+  RoaringBitmapIterator() = default;
+  // Points to the first value of the chunk-th container.
+  inline RoaringBitmapIterator(const RoaringBitmap* parent, std::size_t chunk);
+
+ private:
+  friend class IteratorFacadePrivateAccess<RoaringBitmapIterator>;
+
+  inline void LoadChunk(std::size_t chunk);
+
+  inline uint32_t Dereference() const;
+  inline void Increment();
+  bool IsEqual(const RoaringBitmapIterator& rhs) const {
+    return chunk_ == rhs.chunk_ && low_ == rhs.low_;
+  }
+
+  enum class Kind { kArray, kBitmap, kRun };
+
+  const RoaringBitmap* parent_ = nullptr;
+  std::size_t chunk_ = 0;
+  // The current container, cached to avoid visiting the variant for each
+  // value. Only the pointer matching kind_ is set.
+  Kind kind_ = Kind::kArray;
+  const uint16_t* values_ = nullptr;
+  const uint64_t* words_ = nullptr;
+  const roaring_bitmap_detail::Run* runs_ = nullptr;
+  // Number of values (array container) or runs (run container).
+  int size_ = 0;
+  // Index of the current value (array container), word (bitmap container) or
+  // run (run container).
+  int index_ = 0;
+  // The bits of the current word that have not been visited yet (bitmap
+  // container).
+  uint64_t word_ = 0;
+  // High 16 bits of the values of the container.
+  uint32_t high_ = 0;
+  // Low 16 bits of the current value.
+  int low_ = 0;
+};
+
+// A RoaringBitmap is a compressed set of uint32_t values, for sets that range
+// from very sparse to dense. The values are split in chunks of 2^16 values
+// sharing their high 16 bits, and the low 16 bits of the values of each
+// non-empty chunk are stored in the smallest of:
+//  - an array container: the sorted values, for at most 4096 values,
+//  - a bitmap container: 2^16 bits (8 KiB),
+//  - a run container: the sorted intervals of consecutive values (only after
+//    Optimize()).
+// Intersection, union and difference work chunk by chunk, with a specialized
+// algorithm for each pair of containers (e.g., merging two arrays, or a word
+// loop over two bitmaps).
+//
+// The bitmap is a forward range of its values, in increasing order, which can
+// be passed to FilterRange, TransformRange, ZipRange, etc.:
+//
+//   RoaringBitmap visible = ...;
+//   const RoaringBitmap active = visible & tracked;
+//   for (uint32_t id : FilterRange(active, is_large)) { ... }
+//
+// Caveats:
+//  - Adding values in increasing order is amortized O(1). Adding values in
+//    another order is O(4096) per value in the worst case (array insertion).
+//  - Adding a value to a run container converts it to an array or a bitmap
+//    container. Call Optimize() after building the bitmap.
+//  - Adding values invalidates all iterators.
+class RoaringBitmap {
+ public:
+  using value_type = uint32_t;
+  using iterator = RoaringBitmapIterator;
+  using const_iterator = RoaringBitmapIterator;
+
+  RoaringBitmap() = default;
+
+  // Constructs a bitmap from a range of values, in any order, with possible
+  // duplicates.
+  template <typename Range,
+            typename = decltype(std::begin(std::declval<const Range&>())),
+            typename = std::enable_if_t<!std::is_same_v<Range, RoaringBitmap>>>
+  explicit RoaringBitmap(const Range& values) {
+    for (const auto& value : values) {
+      Add(value);
+    }
+  }
+
+  RoaringBitmap(std::initializer_list<uint32_t> values) {
+    for (uint32_t value : values) {
+      Add(value);
+    }
+  }
+
+  // Returns the number of values.
+  std::size_t size() const {
+    std::size_t size = 0;
+    for (const auto& container : containers_) {
+      size += roaring_bitmap_detail::Cardinality(container);
+    }
+    return size;
+  }
+  bool empty() const { return containers_.empty(); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const {
+    return const_iterator(this, containers_.size());
+  }
+
+  // Returns the values as a forward range.
+  IteratorRange<const_iterator> SetBitIndices() const {
+    return IteratorRange<const_iterator>(begin(), end());
+  }
+
+  bool Contains(uint32_t value) const {
+    const auto it = std::lower_bound(keys_.begin(), keys_.end(), value >> 16);
+    return it != keys_.end() && *it == value >> 16 &&
+           roaring_bitmap_detail::Contains(containers_[it - keys_.begin()],
+                                           value & 0xffff);
+  }
+
+  void Add(uint32_t value) {
+    using roaring_bitmap_detail::ArrayContainer;
+    using roaring_bitmap_detail::BitmapContainer;
+    using roaring_bitmap_detail::RunContainer;
+    const uint16_t key = value >> 16;
+    const uint16_t low = value & 0xffff;
+    // Fast path for values in increasing order.
+    if (keys_.empty() || keys_.back() < key) {
+      keys_.push_back(key);
+      containers_.push_back(ArrayContainer{{low}});
+      return;
+    }
+    const std::size_t chunk =
+        std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin();
+    if (keys_[chunk] != key) {
+      keys_.insert(keys_.begin() + chunk, key);
+      containers_.insert(containers_.begin() + chunk, ArrayContainer{{low}});
+      return;
+    }
+    Container& container = containers_[chunk];
+    if (std::holds_alternative<RunContainer>(container)) {
+      if (roaring_bitmap_detail::Contains(container, low)) {
+        return;
+      }
+      std::vector<uint64_t> words(roaring_bitmap_detail::kBitmapWords, 0);
+      roaring_bitmap_detail::OrInto(container, words.data());
+      container = roaring_bitmap_detail::FromWords(std::move(words));
+    }
+    if (auto* array = std::get_if<ArrayContainer>(&container)) {
+      auto& values = array->values;
+      if (values.back() < low) {
+        values.push_back(low);
+      } else {
+        const auto it = std::lower_bound(values.begin(), values.end(), low);
+        if (*it == low) {
+          return;
+        }
+        values.insert(it, low);
+      }
+      if (values.size() > roaring_bitmap_detail::kMaxArraySize) {
+        container = roaring_bitmap_detail::FromValues(std::move(values));
+      }
+    } else {
+      auto& bitmap = std::get<BitmapContainer>(container);
+      uint64_t& word = bitmap.words[low / 64];
+      const uint64_t bit = uint64_t{1} << (low % 64);
+      bitmap.cardinality += (word & bit) == 0;
+      word |= bit;
+    }
+  }
+
+  // Converts each container to its smallest representation, using run
+  // containers for long runs of consecutive values.
+  void Optimize() {
+    namespace detail = roaring_bitmap_detail;
+    for (Container& container : containers_) {
+      detail::RunContainer runs = detail::ToRuns(container);
+      const std::size_t cardinality = detail::Cardinality(container);
+      const std::size_t run_bytes = runs.runs.size() * sizeof(detail::Run);
+      const std::size_t other_bytes =
+          cardinality <= detail::kMaxArraySize
+              ? cardinality * sizeof(uint16_t)
+              : detail::kBitmapWords * sizeof(uint64_t);
+      if (run_bytes < other_bytes) {
+        runs.runs.shrink_to_fit();
+        container = std::move(runs);
+      } else if (std::holds_alternative<detail::RunContainer>(container)) {
+        std::vector<uint64_t> words(detail::kBitmapWords, 0);
+        detail::OrInto(container, words.data());
+        container = detail::FromWords(std::move(words));
+      }
+    }
+  }
+
+  // Returns the memory used by the bitmap, in bytes.
+  std::size_t SizeInBytes() const {
+    std::size_t size = sizeof(*this) + keys_.capacity() * sizeof(uint16_t) +
+                       containers_.capacity() * sizeof(Container);
+    for (const auto& container : containers_) {
+      size += roaring_bitmap_detail::SizeInBytes(container);
+    }
+    return size;
+  }
+
+  friend RoaringBitmap operator&(const RoaringBitmap& a,
+                                 const RoaringBitmap& b) {
+    RoaringBitmap result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.keys_.size() && j < b.keys_.size()) {
+      if (a.keys_[i] < b.keys_[j]) {
+        ++i;
+      } else if (b.keys_[j] < a.keys_[i]) {
+        ++j;
+      } else {
+        result.Append(a.keys_[i], roaring_bitmap_detail::And(
+                                      a.containers_[i], b.containers_[j]));
+        ++i;
+        ++j;
+      }
+    }
+    return result;
+  }
+
+  friend RoaringBitmap operator|(const RoaringBitmap& a,
+                                 const RoaringBitmap& b) {
+    RoaringBitmap result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.keys_.size() || j < b.keys_.size()) {
+      if (j == b.keys_.size() ||
+          (i < a.keys_.size() && a.keys_[i] < b.keys_[j])) {
+        result.Append(a.keys_[i], a.containers_[i]);
+        ++i;
+      } else if (i == a.keys_.size() || b.keys_[j] < a.keys_[i]) {
+        result.Append(b.keys_[j], b.containers_[j]);
+        ++j;
+      } else {
+        result.Append(a.keys_[i], roaring_bitmap_detail::Or(
+                                      a.containers_[i], b.containers_[j]));
+        ++i;
+        ++j;
+      }
+    }
+    return result;
+  }
+
+  // Returns the values of a that are not in b.
+  friend RoaringBitmap AndNot(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap result;
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < a.keys_.size(); ++i) {
+      while (j < b.keys_.size() && b.keys_[j] < a.keys_[i]) {
+        ++j;
+      }
+      if (j < b.keys_.size() && b.keys_[j] == a.keys_[i]) {
+        result.Append(a.keys_[i], roaring_bitmap_detail::AndNot(
+                                      a.containers_[i], b.containers_[j]));
+      } else {
+        result.Append(a.keys_[i], a.containers_[i]);
+      }
+    }
+    return result;
+  }
+
+  friend bool operator==(const RoaringBitmap& a, const RoaringBitmap& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+  friend bool operator!=(const RoaringBitmap& a, const RoaringBitmap& b) {
+    return !(a == b);
+  }
+
+ private:
+  friend class RoaringBitmapIterator;
+  using Container = roaring_bitmap_detail::Container;
+
+  // Appends a container for a key larger than all keys, unless it is empty.
+  void Append(uint16_t key, Container container) {
+    if (roaring_bitmap_detail::Cardinality(container) > 0) {
+      keys_.push_back(key);
+      containers_.push_back(std::move(container));
+    }
+  }
+
+  // High 16 bits of the values of each container, in increasing order.
+  std::vector<uint16_t> keys_;
+  std::vector<Container> containers_;
+};
+
+RoaringBitmapIterator::RoaringBitmapIterator(const RoaringBitmap* parent,
+                                             std::size_t chunk)
+    : parent_(parent) {
+  LoadChunk(chunk);
+}
+
+void RoaringBitmapIterator::LoadChunk(std::size_t chunk) {
+  using roaring_bitmap_detail::ArrayContainer;
+  using roaring_bitmap_detail::BitmapContainer;
+  using roaring_bitmap_detail::Container;
+  using roaring_bitmap_detail::RunContainer;
+  chunk_ = chunk;
+  index_ = 0;
+  if (chunk_ == parent_->containers_.size()) {
+    low_ = 0;
+    return;
+  }
+  high_ = uint32_t{parent_->keys_[chunk_]} << 16;
+  const Container& container = parent_->containers_[chunk_];
+  if (const auto* array = std::get_if<ArrayContainer>(&container)) {
+    kind_ = Kind::kArray;
+    values_ = array->values.data();
+    size_ = array->values.size();
+    low_ = values_[0];
+  } else if (const auto* bitmap = std::get_if<BitmapContainer>(&container)) {
+    kind_ = Kind::kBitmap;
+    words_ = bitmap->words.data();
+    while (words_[index_] == 0) {
+      ++index_;
+    }
+    word_ = words_[index_];
+    low_ = index_ * 64 + __builtin_ctzll(word_);
+  } else {
+    const auto& runs = std::get<RunContainer>(container).runs;
+    kind_ = Kind::kRun;
+    runs_ = runs.data();
+    size_ = runs.size();
+    low_ = runs_[0].first;
+  }
+}
+
+uint32_t RoaringBitmapIterator::Dereference() const { return high_ | low_; }
+
+void RoaringBitmapIterator::Increment() {
+  switch (kind_) {
+    case Kind::kArray:
+      if (++index_ < size_) {
+        low_ = values_[index_];
+        return;
+      }
+      break;
+    case Kind::kBitmap:
+      word_ &= word_ - 1;
+      while (word_ == 0 && ++index_ < roaring_bitmap_detail::kBitmapWords) {
+        word_ = words_[index_];
+      }
+      if (word_ != 0) {
+        low_ = index_ * 64 + __builtin_ctzll(word_);
+        return;
+      }
+      break;
+    case Kind::kRun:
+      if (low_ < runs_[index_].last) {
+        ++low_;
+        return;
+      }
+      if (++index_ < size_) {
+        low_ = runs_[index_].first;
+        return;
+      }
+      break;
+  }
+  LoadChunk(chunk_ + 1);
+}
+
+}  // namespace genit
+
+#endif  // GENIT_ROARING_BITMAP_H_
@@ -0,0 +1,146 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares RoaringBitmap with a dense bitset (std::vector<uint64_t>) and a
+// sorted std::vector<uint32_t> for intersecting two sets and iterating over
+// the result, over a universe of 2^24 values. The argument is the density in
+// parts per 10000. The "bytes" counter is the memory used by one set.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/roaring_bitmap.h"
+
+namespace genit {
+namespace {
+
+constexpr uint32_t kUniverse = 1 << 24;
+
+std::vector<uint32_t> MakeValues(int density_per_10000, int seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint32_t> values;
+  for (uint32_t i = 0; i < kUniverse; ++i) {
+    if (static_cast<int>(rng() % 10000) < density_per_10000) {
+      values.push_back(i);
+    }
+  }
+  return values;
+}
+
+std::vector<uint64_t> MakeBitset(const std::vector<uint32_t>& values) {
+  std::vector<uint64_t> words(kUniverse / 64, 0);
+  for (uint32_t value : values) {
+    words[value / 64] |= uint64_t{1} << (value % 64);
+  }
+  return words;
+}
+
+void BM_AndIterateRoaring(benchmark::State& state) {
+  const RoaringBitmap a(MakeValues(state.range(0), 1));
+  const RoaringBitmap b(MakeValues(state.range(0), 2));
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (uint32_t value : a & b) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["bytes"] = a.SizeInBytes();
+}
+
+void BM_AndIterateDenseBitset(benchmark::State& state) {
+  const std::vector<uint64_t> a = MakeBitset(MakeValues(state.range(0), 1));
+  const std::vector<uint64_t> b = MakeBitset(MakeValues(state.range(0), 2));
+  std::vector<uint64_t> result(a.size());
+  for (auto _ : state) {
+    for (std::size_t w = 0; w < a.size(); ++w) {
+      result[w] = a[w] & b[w];
+    }
+    uint64_t sum = 0;
+    for (std::size_t w = 0; w < result.size(); ++w) {
+      for (uint64_t word = result[w]; word != 0; word &= word - 1) {
+        sum += w * 64 + __builtin_ctzll(word);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["bytes"] = a.size() * sizeof(uint64_t);
+}
+
+void BM_AndIterateSortedVector(benchmark::State& state) {
+  const std::vector<uint32_t> a = MakeValues(state.range(0), 1);
+  const std::vector<uint32_t> b = MakeValues(state.range(0), 2);
+  std::vector<uint32_t> result;
+  for (auto _ : state) {
+    result.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                          std::back_inserter(result));
+    uint64_t sum = 0;
+    for (uint32_t value : result) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["bytes"] = a.size() * sizeof(uint32_t);
+}
+
+// Long runs of consecutive values, where run containers are the smallest.
+void BM_OrRunsRoaring(benchmark::State& state) {
+  std::vector<uint32_t> values_a;
+  std::vector<uint32_t> values_b;
+  for (uint32_t i = 0; i < kUniverse; ++i) {
+    if (i % 100000 < 50000) {
+      values_a.push_back(i);
+    }
+    if ((i + 30000) % 100000 < 50000) {
+      values_b.push_back(i);
+    }
+  }
+  RoaringBitmap a(values_a);
+  RoaringBitmap b(values_b);
+  a.Optimize();
+  b.Optimize();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a | b);
+  }
+  state.counters["bytes"] = a.SizeInBytes();
+}
+
+BENCHMARK(BM_AndIterateRoaring)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000);
+BENCHMARK(BM_AndIterateDenseBitset)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000);
+BENCHMARK(BM_AndIterateSortedVector)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(5000);
+BENCHMARK(BM_OrRunsRoaring);
+
+}  // namespace
+}  // namespace genit
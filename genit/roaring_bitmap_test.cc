@@ -0,0 +1,202 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/roaring_bitmap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "genit/filter_iterator.h"
+#include "genit/transform_iterator.h"
+#include "genit/zip_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// Returns sorted values in [0, universe) with the given density, and a few
+// long runs of consecutive values.
+std::vector<uint32_t> RandomValues(uint32_t universe, double density,
+                                   int seed) {
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution bit(density);
+  std::vector<uint32_t> values;
+  for (uint32_t i = 0; i < universe; ++i) {
+    if (bit(rng)) {
+      values.push_back(i);
+    }
+  }
+  const uint32_t run_first = rng() % universe;
+  for (uint32_t i = run_first; i < std::min(universe, run_first + 20000);
+       ++i) {
+    values.push_back(i);
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+std::vector<uint32_t> ToVector(const RoaringBitmap& bitmap) {
+  return std::vector<uint32_t>(bitmap.begin(), bitmap.end());
+}
+
+TEST(RoaringBitmapTest, Empty) {
+  const RoaringBitmap bitmap;
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_EQ(bitmap.size(), 0);
+  EXPECT_EQ(bitmap.begin(), bitmap.end());
+  EXPECT_FALSE(bitmap.Contains(0));
+}
+
+TEST(RoaringBitmapTest, AddAndContains) {
+  RoaringBitmap bitmap = {70000, 3, 1, 3, 0xffffffff, 65536};
+  EXPECT_EQ(bitmap.size(), 5);
+  EXPECT_TRUE(bitmap.Contains(1));
+  EXPECT_TRUE(bitmap.Contains(65536));
+  EXPECT_TRUE(bitmap.Contains(0xffffffff));
+  EXPECT_FALSE(bitmap.Contains(2));
+  EXPECT_FALSE(bitmap.Contains(65537));
+  EXPECT_THAT(bitmap, ElementsAre(1, 3, 65536, 70000, 0xffffffff));
+  bitmap.Add(2);
+  EXPECT_THAT(bitmap.SetBitIndices(),
+              ElementsAre(1, 2, 3, 65536, 70000, 0xffffffff));
+}
+
+TEST(RoaringBitmapTest, ConvertsArrayToBitmapContainer) {
+  RoaringBitmap bitmap;
+  // Every other value of the first chunk, in decreasing order.
+  for (int i = 65534; i >= 0; i -= 2) {
+    bitmap.Add(i);
+  }
+  EXPECT_EQ(bitmap.size(), 32768);
+  EXPECT_TRUE(bitmap.Contains(65534));
+  EXPECT_FALSE(bitmap.Contains(65533));
+  const std::vector<uint32_t> values = ToVector(bitmap);
+  ASSERT_EQ(values.size(), 32768);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], 2 * i);
+  }
+  // Bitmap container: 8 KiB instead of 64 KiB for an array of 32768 values.
+  EXPECT_LT(bitmap.SizeInBytes(), 9000);
+}
+
+TEST(RoaringBitmapTest, OptimizeUsesRunContainers) {
+  std::vector<uint32_t> values;
+  for (uint32_t i = 100; i < 300000; ++i) {
+    values.push_back(i);
+  }
+  values.push_back(400000);
+  RoaringBitmap bitmap(values);
+  const std::size_t size_before = bitmap.SizeInBytes();
+  bitmap.Optimize();
+  EXPECT_LT(bitmap.SizeInBytes(), size_before / 100);
+  EXPECT_EQ(bitmap.size(), values.size());
+  EXPECT_TRUE(bitmap.Contains(100));
+  EXPECT_TRUE(bitmap.Contains(299999));
+  EXPECT_FALSE(bitmap.Contains(300000));
+  EXPECT_EQ(ToVector(bitmap), values);
+  // Adding to a run container converts it back.
+  bitmap.Add(350000);
+  bitmap.Add(65535 * 2 + 1);
+  values.insert(values.end() - 1, 350000);
+  EXPECT_EQ(ToVector(bitmap), values);
+}
+
+TEST(RoaringBitmapTest, SetOperationsMatchSortedVectors) {
+  const uint32_t kUniverse = 1 << 19;
+  for (const double density_a : {0.001, 0.05, 0.5}) {
+    for (const double density_b : {0.002, 0.3, 0.9}) {
+      for (const bool optimize : {false, true}) {
+        const auto values_a = RandomValues(kUniverse, density_a, 1);
+        const auto values_b = RandomValues(kUniverse, density_b, 2);
+        RoaringBitmap a(values_a);
+        RoaringBitmap b(values_b);
+        if (optimize) {
+          a.Optimize();
+          b.Optimize();
+        }
+        std::vector<uint32_t> expected;
+        std::set_intersection(values_a.begin(), values_a.end(),
+                              values_b.begin(), values_b.end(),
+                              std::back_inserter(expected));
+        EXPECT_EQ(ToVector(a & b), expected) << density_a << " " << density_b;
+        expected.clear();
+        std::set_union(values_a.begin(), values_a.end(), values_b.begin(),
+                       values_b.end(), std::back_inserter(expected));
+        EXPECT_EQ(ToVector(a | b), expected) << density_a << " " << density_b;
+        expected.clear();
+        std::set_difference(values_a.begin(), values_a.end(),
+                            values_b.begin(), values_b.end(),
+                            std::back_inserter(expected));
+        EXPECT_EQ(ToVector(AndNot(a, b)), expected)
+            << density_a << " " << density_b;
+      }
+    }
+  }
+}
+
+TEST(RoaringBitmapTest, OperationsOnRunContainers) {
+  RoaringBitmap a;
+  RoaringBitmap b;
+  for (uint32_t i = 10; i < 1000; ++i) {
+    a.Add(i);
+  }
+  for (uint32_t i = 500; i < 2000; ++i) {
+    b.Add(i);
+  }
+  a.Optimize();
+  b.Optimize();
+  EXPECT_EQ((a & b).size(), 500);
+  EXPECT_EQ((a | b).size(), 1990);
+  EXPECT_EQ(AndNot(a, b).size(), 490);
+  EXPECT_EQ(AndNot(b, a).size(), 1000);
+  EXPECT_EQ(a & b, RoaringBitmap(IndexRange(500, 1000)));
+}
+
+TEST(RoaringBitmapTest, Equality) {
+  RoaringBitmap a(IndexRange(0, 5000));
+  const RoaringBitmap b(IndexRange(0, 5000));
+  EXPECT_EQ(a, b);
+  a.Optimize();
+  EXPECT_EQ(a, b);
+  a.Add(5000);
+  EXPECT_NE(a, b);
+}
+
+TEST(RoaringBitmapTest, ComposesWithRangeAdapters) {
+  const RoaringBitmap bitmap = {1, 4, 9, 100000};
+  EXPECT_THAT(FilterRange(bitmap, [](uint32_t x) { return x % 2 == 0; }),
+              ElementsAre(4, 100000));
+  EXPECT_THAT(TransformRange(bitmap, [](uint32_t x) { return x + 1; }),
+              ElementsAre(2, 5, 10, 100001));
+  const std::vector<char> names = {'a', 'b', 'c', 'd'};
+  EXPECT_THAT(ZipRange(bitmap, names),
+              ElementsAre(std::make_tuple(1, 'a'), std::make_tuple(4, 'b'),
+                          std::make_tuple(9, 'c'),
+                          std::make_tuple(100000, 'd')));
+  const std::vector<uint32_t> values(bitmap.begin(), bitmap.end());
+  EXPECT_THAT(bitmap.SetBitIndices(), ElementsAreArray(values));
+}
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides SampleRange, which selects k elements of a range
+// uniformly at random (without replacement), e.g., to compute an approximate
+// statistic over a huge range without touching every element:
+//
+//   std::mt19937 rng(...);
+//   double sum = 0.0;
+//   for (double x : SampleRange(TransformRange(points, ComputeError), 100,
+//                               rng)) {
+//     sum += x;
+//   }
+//
+// The selected elements are visited in the order of the base range.
+//  - For random-access base ranges, k sorted random indices are generated in
+//    O(k log k), and only the selected elements are accessed.
+//  - For forward base ranges, a skip-based reservoir sampling (Algorithm L)
+//    is used, such that the random number generator is only called
+//    O(k (1 + log(n / k))) times. The base range is traversed (incremented,
+//    but not dereferenced) once to sample, and once more to iterate.
+//
+// For reproducible replays, SampleRange can also be given a seed, in which
+// case a std::mt19937_64 generator seeded with it is used.
+
+#ifndef GENIT_SAMPLE_RANGE_H_
+#define GENIT_SAMPLE_RANGE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+
+namespace sample_range_detail {
+
+template <typename BaseRange>
+using IterCategory = zip_iterator_detail::ReduceToStdIterCategory<
+    typename std::iterator_traits<
+        RangeIteratorType<BaseRange>>::iterator_category>;
+
+// Returns a uniformly distributed integer in [0, n).
+template <typename URBG>
+int UniformIndex(URBG& rng, int n) {
+  return std::uniform_int_distribution<int>(0, n - 1)(rng);
+}
+
+// Returns a uniformly distributed real number in (0, 1).
+template <typename URBG>
+double UniformOpenUnit(URBG& rng) {
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  double u = dist(rng);
+  while (u == 0.0) {
+    u = dist(rng);
+  }
+  return u;
+}
+
+// Selects k distinct indices out of [0, n) with Floyd's algorithm, and returns
+// them sorted.
+template <typename URBG>
+std::vector<int> SampleIndicesOfSize(int n, int k, URBG& rng) {
+  std::vector<int> indices;
+  if (k >= n) {
+    indices.resize(std::max(n, 0));
+    for (int i = 0; i < n; ++i) {
+      indices[i] = i;
+    }
+    return indices;
+  }
+  std::unordered_set<int> selected;
+  selected.reserve(k);
+  indices.reserve(k);
+  for (int j = n - k; j < n; ++j) {
+    const int t = UniformIndex(rng, j + 1);
+    const int index = selected.insert(t).second ? t : j;
+    if (index == j) {
+      selected.insert(j);
+    }
+    indices.push_back(index);
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+// Advances *it by up to 'skip' elements (without dereferencing them), stopping
+// at 'last'. Returns the number of elements skipped.
+template <typename Iter>
+int SkipAhead(Iter* it, const Iter& last, double skip) {
+  const int steps = skip < std::numeric_limits<int>::max()
+                        ? static_cast<int>(skip)
+                        : std::numeric_limits<int>::max();
+  int i = 0;
+  while (i < steps && *it != last) {
+    ++(*it);
+    ++i;
+  }
+  return i;
+}
+
+// Selects k distinct indices out of a forward range of unknown size with
+// reservoir sampling (Algorithm L, Li 1994), and returns them sorted.
+template <typename Range, typename URBG>
+std::vector<int> ReservoirSampleIndices(const Range& range, int k, URBG& rng) {
+  using std::begin;
+  using std::end;
+  std::vector<int> reservoir;
+  if (k <= 0) {
+    return reservoir;
+  }
+  auto it = begin(range);
+  const auto last = end(range);
+  int index = 0;
+  for (; index < k && it != last; ++index, ++it) {
+    reservoir.push_back(index);
+  }
+  // From here on, 'it' points at element 'index', the next candidate.
+  double w = std::exp(std::log(UniformOpenUnit(rng)) / k);
+  while (it != last) {
+    const double skip =
+        std::floor(std::log(UniformOpenUnit(rng)) / std::log1p(-w));
+    index += SkipAhead(&it, last, skip);
+    if (it == last) {
+      break;
+    }
+    reservoir[UniformIndex(rng, k)] = index;
+    w *= std::exp(std::log(UniformOpenUnit(rng)) / k);
+    ++it;
+    ++index;
+  }
+  std::sort(reservoir.begin(), reservoir.end());
+  return reservoir;
+}
+
+template <typename Range, typename URBG>
+std::vector<int> SampleIndices(const Range& range, int k, URBG& rng) {
+  using std::begin;
+  using std::end;
+  using Category = IterCategory<Range>;
+  static_assert(std::is_convertible_v<Category, std::forward_iterator_tag>,
+                "SampleRange requires a forward (multi-pass) range.");
+  if constexpr (std::is_convertible_v<Category,
+                                      std::random_access_iterator_tag>) {
+    return SampleIndicesOfSize(end(range) - begin(range), k, rng);
+  } else {
+    return ReservoirSampleIndices(range, k, rng);
+  }
+}
+
+}  // namespace sample_range_detail
+
+// Forward-decl.
+template <typename BaseRange>
+class SampledRange;
+
+// Iterator over the selected elements of a SampledRange.
+template <typename BaseRange>
+class SampleIterator
+    : public IteratorFacade<SampleIterator<BaseRange>,
+                            RangeReferenceType<BaseRange>,
+                            sample_range_detail::IterCategory<BaseRange>> {
+ public:
+  SampleIterator(RangeIteratorType<BaseRange> base_begin, int pos,
+                 const SampledRange<BaseRange>* parent)
+      : base_it_(std::move(base_begin)), parent_(parent) {
+    MoveTo(pos);
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<SampleIterator>;
+
+  const std::vector<int>& Indices() const { return parent_->indices_; }
+
+  // Moves to the pos-th selected element, advancing the base iterator only if
+  // the position refers to an element.
+  void MoveTo(int pos) {
+    pos_ = pos;
+    if (pos_ >= 0 && pos_ < static_cast<int>(Indices().size())) {
+      std::advance(base_it_, Indices()[pos_] - base_index_);
+      base_index_ = Indices()[pos_];
+    }
+  }
+
+  RangeReferenceType<BaseRange> Dereference() const { return *base_it_; }
+  void Increment() { MoveTo(pos_ + 1); }
+  void Decrement() { MoveTo(pos_ - 1); }
+  bool IsEqual(const SampleIterator& rhs) const { return pos_ == rhs.pos_; }
+  int DistanceTo(const SampleIterator& rhs) const { return rhs.pos_ - pos_; }
+  void Advance(int n) { MoveTo(pos_ + n); }
+
+  RangeIteratorType<BaseRange> base_it_;
+  // Index of the base element that base_it_ points to.
+  int base_index_ = 0;
+  // Position within the selected indices.
+  int pos_ = 0;
+  const SampledRange<BaseRange>* parent_ = nullptr;
+};
+
+// A range of k elements selected uniformly at random out of a base range, in
+// the order of the base range. See SampleRange.
+template <typename BaseRange>
+class SampledRange
+    : public AliasRangeFacade<SampledRange<BaseRange>, BaseRange,
+                              SampleIterator<BaseRange>> {
+ public:
+  using SampleIter = SampleIterator<BaseRange>;
+  using BaseFacade =
+      AliasRangeFacade<SampledRange<BaseRange>, BaseRange, SampleIter>;
+
+  template <typename OtherRange, typename URBG>
+  SampledRange(OtherRange&& r, int k, URBG& rng)
+      : BaseFacade(std::forward<OtherRange>(r)),
+        indices_(sample_range_detail::SampleIndices(this->base_range_, k,
+                                                    rng)) {}
+
+  // Returns the indices of the selected elements in the base range (sorted).
+  const std::vector<int>& indices() const { return indices_; }
+
+  // Returns the number of selected elements.
+  std::size_t size() const { return indices_.size(); }
+
+ private:
+  friend class AliasRangeFacadePrivateAccess<SampledRange<BaseRange>>;
+  friend class SampleIterator<BaseRange>;
+
+  auto Begin(const BaseRange& base_range) const {
+    using std::begin;
+    return SampleIter(begin(base_range), 0, this);
+  }
+  auto End(const BaseRange& base_range) const {
+    using std::begin;
+    return SampleIter(begin(base_range), static_cast<int>(indices_.size()),
+                      this);
+  }
+
+  std::vector<int> indices_;
+};
+
+// Creates a range of min(k, size) elements of a range, selected uniformly at
+// random without replacement using the given uniform random bit generator.
+// The elements are visited in the order of the base range. The resulting
+// range has the same iterator category as the base range.
+template <typename Range, typename URBG,
+          std::enable_if_t<!std::is_integral_v<std::decay_t<URBG>>, int> = 0>
+auto SampleRange(Range&& range, int k, URBG&& rng) {
+  return SampledRange<decltype(MoveOrAliasRange(std::forward<Range>(range)))>(
+      MoveOrAliasRange(std::forward<Range>(range)), k, rng);
+}
+
+// Same as above, but with a deterministic std::mt19937_64 generator created
+// from a seed, e.g., for reproducible replays. For a given seed, the selection
+// is the same for every call (with the same standard library).
+template <typename Range>
+auto SampleRange(Range&& range, int k, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  return SampleRange(std::forward<Range>(range), k, rng);
+}
+
+}  // namespace genit
+
+#endif  // GENIT_SAMPLE_RANGE_H_
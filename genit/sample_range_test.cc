@@ -0,0 +1,169 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/sample_range.h"
+
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+std::vector<int> Iota(int n) {
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i) {
+    v[i] = i;
+  }
+  return v;
+}
+
+TEST(SampleRangeTest, EmptyRange) {
+  std::vector<int> v;
+  std::mt19937 rng(1);
+  EXPECT_TRUE(SampleRange(v, 3, rng).empty());
+  std::forward_list<int> l;
+  EXPECT_TRUE(SampleRange(l, 3, rng).empty());
+}
+
+TEST(SampleRangeTest, ZeroSamples) {
+  std::mt19937 rng(1);
+  EXPECT_TRUE(SampleRange(Iota(10), 0, rng).empty());
+  std::list<int> l = {1, 2, 3};
+  EXPECT_TRUE(SampleRange(l, 0, rng).empty());
+}
+
+TEST(SampleRangeTest, MoreSamplesThanElementsSelectsEverything) {
+  std::mt19937 rng(1);
+  EXPECT_THAT(SampleRange(Iota(5), 10, rng), ElementsAre(0, 1, 2, 3, 4));
+  std::forward_list<int> l = {7, 8, 9};
+  EXPECT_THAT(SampleRange(l, 3, rng), ElementsAre(7, 8, 9));
+}
+
+TEST(SampleRangeTest, RandomAccessSelectsDistinctSortedElements) {
+  const std::vector<int> v = Iota(1000);
+  std::mt19937 rng(42);
+  const auto sample = SampleRange(v, 50, rng);
+  using It = decltype(sample.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  ASSERT_EQ(sample.size(), 50);
+  std::vector<int> values(sample.begin(), sample.end());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  EXPECT_EQ(std::adjacent_find(values.begin(), values.end()), values.end());
+  EXPECT_THAT(values, ElementsAreArray(sample.indices()));
+  EXPECT_EQ(sample.begin()[7], values[7]);
+  EXPECT_EQ(*(sample.end() - 1), values.back());
+}
+
+TEST(SampleRangeTest, ForwardSelectsDistinctSortedElements) {
+  const std::vector<int> v = Iota(1000);
+  const std::forward_list<int> l(v.begin(), v.end());
+  std::mt19937 rng(42);
+  const auto sample = SampleRange(l, 50, rng);
+  using It = decltype(sample.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::forward_iterator_tag>));
+  std::vector<int> values(sample.begin(), sample.end());
+  ASSERT_EQ(values.size(), 50);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  EXPECT_EQ(std::adjacent_find(values.begin(), values.end()), values.end());
+  EXPECT_THAT(values, ElementsAreArray(sample.indices()));
+}
+
+TEST(SampleRangeTest, BidirectionalIteration) {
+  std::list<int> l = {0, 10, 20, 30, 40, 50, 60};
+  const auto sample = SampleRange(l, 3, std::uint64_t{7});
+  std::vector<int> forward(sample.begin(), sample.end());
+  std::vector<int> backward(std::make_reverse_iterator(sample.end()),
+                            std::make_reverse_iterator(sample.begin()));
+  std::reverse(backward.begin(), backward.end());
+  EXPECT_EQ(forward, backward);
+}
+
+TEST(SampleRangeTest, OnlyDereferencesSelectedElements) {
+  int num_calls = 0;
+  const auto squares =
+      TransformRange(IndexRange(0, 100000), [&num_calls](int i) {
+        ++num_calls;
+        return i * i;
+      });
+  std::mt19937 rng(3);
+  const auto sample = SampleRange(squares, 10, rng);
+  int num_elements = 0;
+  for (int x : sample) {
+    EXPECT_EQ(x, sample.indices()[num_elements] *
+                     sample.indices()[num_elements]);
+    ++num_elements;
+  }
+  EXPECT_EQ(num_elements, 10);
+  EXPECT_EQ(num_calls, 10);
+}
+
+TEST(SampleRangeTest, SameSeedSameSample) {
+  const std::vector<int> v = Iota(500);
+  const std::list<int> l(v.begin(), v.end());
+  EXPECT_EQ(SampleRange(v, 20, std::uint64_t{123}).indices(),
+            SampleRange(v, 20, std::uint64_t{123}).indices());
+  EXPECT_EQ(SampleRange(l, 20, std::uint64_t{123}).indices(),
+            SampleRange(l, 20, std::uint64_t{123}).indices());
+  EXPECT_NE(SampleRange(v, 20, std::uint64_t{123}).indices(),
+            SampleRange(v, 20, std::uint64_t{124}).indices());
+}
+
+// Checks that every element is selected with probability k / n, for both
+// sampling algorithms.
+template <typename Container>
+void ExpectUniform() {
+  constexpr int kNumElements = 20;
+  constexpr int kNumSamples = 5;
+  constexpr int kNumTrials = 20000;
+  const std::vector<int> v = Iota(kNumElements);
+  const Container c(v.begin(), v.end());
+  std::mt19937 rng(99);
+  std::vector<int> counts(kNumElements, 0);
+  for (int trial = 0; trial < kNumTrials; ++trial) {
+    for (int x : SampleRange(c, kNumSamples, rng)) {
+      ++counts[x];
+    }
+  }
+  const double expected = double{kNumTrials} * kNumSamples / kNumElements;
+  for (int i = 0; i < kNumElements; ++i) {
+    // The standard deviation is about 61, so this is ~6 sigmas.
+    EXPECT_NEAR(counts[i], expected, 400) << "element " << i;
+  }
+}
+
+TEST(SampleRangeTest, RandomAccessIsUniform) {
+  ExpectUniform<std::vector<int>>();
+}
+
+TEST(SampleRangeTest, ForwardIsUniform) {
+  ExpectUniform<std::forward_list<int>>();
+}
+
+}  // namespace
+}  // namespace genit
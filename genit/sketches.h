@@ -0,0 +1,489 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides sketches: single-pass accumulators that summarize
+// a range of any size in bounded memory, and answer approximate queries:
+//  - KllSketch: quantiles (e.g., the median or p99 of latencies),
+//  - HyperLogLog: the number of distinct values,
+//  - CountMinSketch: the counts of values, and the most frequent ones.
+//
+// For example, instead of sorting a copy of the latencies:
+//
+//   KllSketch<double> latencies;
+//   latencies.AddRange(TransformRange(requests, &Request::latency_ms));
+//   const double p99 = latencies.Quantile(0.99);
+//
+// Sketches of the same type (and parameters) can be merged, such that each
+// thread can summarize a part of the data, and the results be combined, e.g.,
+// with Reduce (see algorithms.h) or a parallel reduction:
+//
+//   const KllSketch<double> all = Reduce(per_thread, KllSketch<double>(),
+//                                        MergeSketches());
+//
+// The sketches are not thread-safe: each thread must add to its own.
+
+#ifndef GENIT_SKETCHES_H_
+#define GENIT_SKETCHES_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace genit {
+
+namespace sketches_detail {
+
+// Finalizer of SplitMix64, which spreads the bits of std::hash values (the
+// identity for integers in common implementations) over the 64 bits.
+inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9u;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebu;
+  x ^= x >> 31;
+  return x;
+}
+
+template <typename T, typename Hash>
+uint64_t HashValue(const T& value, const Hash& hash) {
+  return Mix64(static_cast<uint64_t>(hash(value)));
+}
+
+}  // namespace sketches_detail
+
+// Merges two sketches of the same type, e.g., as the operation of a
+// reduction.
+struct MergeSketches {
+  template <typename Sketch>
+  Sketch operator()(Sketch lhs, const Sketch& rhs) const {
+    lhs.Merge(rhs);
+    return lhs;
+  }
+};
+
+// A KLL sketch (Karnin, Lang and Liberty, "Optimal Quantile Approximation in
+// Streams", 2016) of values of a totally ordered type T. It keeps
+// O(k + log(n)) values, in levels of compactors: the values of level h stand
+// for 2^h values each. When a level is full, it is sorted, and every other
+// value (starting at random at the first or second) moves to the next level.
+//
+// The rank error of Rank() and Quantile() is about 1.7 / k of n, with high
+// probability, e.g., the value returned for the median has a rank within
+// [0.49 n, 0.51 n] for the default k = 200. Sketches with fewer than about k
+// values are exact. Min and max values are tracked exactly.
+template <typename T, typename Compare = std::less<T>>
+class KllSketch {
+ public:
+  explicit KllSketch(int k = 200, uint64_t seed = 0x9e3779b97f4a7c15u)
+      : k_(k), rng_(seed | 1) {
+    assert(k >= 8);
+    AddLevel();
+  }
+
+  void Add(const T& value) {
+    if (count_ == 0 || less_(value, min_)) min_ = value;
+    if (count_ == 0 || less_(max_, value)) max_ = value;
+    ++count_;
+    levels_[0].push_back(value);
+    if (++size_ >= max_size_) {
+      Compress();
+    }
+  }
+  template <typename Range>
+  void AddRange(Range&& range) {
+    for (auto&& value : range) {
+      Add(value);
+    }
+  }
+
+  // Adds the values of another sketch, with the same k.
+  void Merge(const KllSketch& other) {
+    assert(k_ == other.k_);
+    if (other.count_ == 0) {
+      return;
+    }
+    if (count_ == 0 || less_(other.min_, min_)) min_ = other.min_;
+    if (count_ == 0 || less_(max_, other.max_)) max_ = other.max_;
+    count_ += other.count_;
+    while (levels_.size() < other.levels_.size()) {
+      AddLevel();
+    }
+    for (std::size_t h = 0; h < other.levels_.size(); ++h) {
+      levels_[h].insert(levels_[h].end(), other.levels_[h].begin(),
+                        other.levels_[h].end());
+      size_ += other.levels_[h].size();
+    }
+    while (size_ >= max_size_) {
+      Compress();
+    }
+  }
+
+  // The number of values added.
+  uint64_t count() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  // The number of values retained.
+  std::size_t num_retained() const { return size_; }
+
+  // Returns the approximate fraction of the values less than or equal to
+  // value.
+  double Rank(const T& value) const {
+    if (count_ == 0) {
+      return 0;
+    }
+    uint64_t weight = 0;
+    for (std::size_t h = 0; h < levels_.size(); ++h) {
+      for (const T& x : levels_[h]) {
+        if (!less_(value, x)) {
+          weight += uint64_t{1} << h;
+        }
+      }
+    }
+    return static_cast<double>(weight) / count_;
+  }
+
+  // Returns a value whose rank is approximately q, for q in [0, 1]: the
+  // minimum for 0, the median for 0.5 and the maximum for 1. The sketch must
+  // not be empty.
+  T Quantile(double q) const { return Quantiles({q})[0]; }
+
+  // Returns the values of the given ranks, sorting the retained values once.
+  std::vector<T> Quantiles(const std::vector<double>& qs) const {
+    assert(count_ > 0);
+    std::vector<std::pair<T, uint64_t>> weighted;
+    weighted.reserve(size_);
+    for (std::size_t h = 0; h < levels_.size(); ++h) {
+      for (const T& x : levels_[h]) {
+        weighted.emplace_back(x, uint64_t{1} << h);
+      }
+    }
+    std::sort(weighted.begin(), weighted.end(),
+              [this](const auto& a, const auto& b) {
+                return less_(a.first, b.first);
+              });
+    std::vector<T> quantiles;
+    quantiles.reserve(qs.size());
+    for (const double q : qs) {
+      if (q <= 0) {
+        quantiles.push_back(min_);
+        continue;
+      }
+      if (q >= 1) {
+        quantiles.push_back(max_);
+        continue;
+      }
+      // The first value whose cumulative weight reaches q * count.
+      const double target = q * count_;
+      uint64_t weight = 0;
+      auto it = weighted.begin();
+      for (; it + 1 != weighted.end(); ++it) {
+        weight += it->second;
+        if (weight >= target) {
+          break;
+        }
+      }
+      quantiles.push_back(it->first);
+    }
+    return quantiles;
+  }
+
+ private:
+  // The capacity of level h decreases geometrically (by 2/3) with its depth
+  // below the top level, down to 8.
+  void AddLevel() {
+    levels_.emplace_back();
+    capacities_.resize(levels_.size());
+    max_size_ = 0;
+    for (std::size_t h = 0; h < levels_.size(); ++h) {
+      const std::size_t depth = levels_.size() - h - 1;
+      const double capacity = std::ceil(k_ * std::pow(2.0 / 3, depth));
+      capacities_[h] = std::max<std::size_t>(8, capacity);
+      max_size_ += capacities_[h];
+    }
+  }
+
+  // Compacts the lowest full level into the next one.
+  void Compress() {
+    for (std::size_t h = 0; h < levels_.size(); ++h) {
+      if (levels_[h].size() >= capacities_[h]) {
+        if (h + 1 == levels_.size()) {
+          AddLevel();
+        }
+        Compact(h);
+        return;
+      }
+    }
+  }
+
+  void Compact(std::size_t h) {
+    std::vector<T>& level = levels_[h];
+    std::vector<T>& next = levels_[h + 1];
+    std::sort(level.begin(), level.end(), less_);
+    // Keep the smallest value of an odd number of values.
+    const std::size_t first = level.size() % 2;
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 7;
+    rng_ ^= rng_ << 17;
+    const std::size_t offset = rng_ >> 63;
+    for (std::size_t i = first + offset; i < level.size(); i += 2) {
+      next.push_back(std::move(level[i]));
+    }
+    size_ -= level.size() - first;
+    size_ += (level.size() - first) / 2;
+    level.resize(first);
+  }
+
+  int k_;
+  uint64_t rng_;
+  Compare less_;
+  std::vector<std::vector<T>> levels_;
+  std::vector<std::size_t> capacities_;
+  // The number of retained values, and the sum of the capacities.
+  std::size_t size_ = 0;
+  std::size_t max_size_ = 0;
+  uint64_t count_ = 0;
+  T min_{};
+  T max_{};
+};
+
+// A HyperLogLog sketch (Flajolet et al., 2007) of the number of distinct
+// values, with 2^kPrecision one-byte registers. Each value is hashed, the
+// first kPrecision bits select a register, which keeps the maximum number of
+// leading zeros of the other bits (plus one). The relative standard error of
+// Estimate() is 1.04 / sqrt(2^kPrecision), e.g., 1.6% for the default
+// kPrecision = 12 (4 KiB). Small counts use linear counting, and are about
+// exact.
+template <int kPrecision = 12>
+class HyperLogLog {
+  static_assert(kPrecision >= 4 && kPrecision <= 18,
+                "kPrecision must be in [4, 18]");
+
+ public:
+  static constexpr int kNumRegisters = 1 << kPrecision;
+
+  HyperLogLog() : registers_(kNumRegisters, 0) {}
+
+  template <typename T, typename Hash = std::hash<T>>
+  void Add(const T& value, const Hash& hash = Hash()) {
+    AddHash(sketches_detail::HashValue(value, hash));
+  }
+  template <typename Range>
+  void AddRange(Range&& range) {
+    for (auto&& value : range) {
+      Add(value);
+    }
+  }
+
+  // Adds a value by its (well-mixed) 64-bit hash.
+  void AddHash(uint64_t hash) {
+    const uint64_t index = hash >> (64 - kPrecision);
+    const uint64_t rest = hash << kPrecision;
+    const uint8_t rank = rest == 0 ? 64 - kPrecision + 1
+                                   : __builtin_clzll(rest) + 1;
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  void Merge(const HyperLogLog& other) {
+    for (int i = 0; i < kNumRegisters; ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  // Returns the approximate number of distinct values added.
+  double Estimate() const {
+    double sum = 0;
+    int num_zeros = 0;
+    for (const uint8_t rank : registers_) {
+      sum += std::ldexp(1.0, -rank);
+      num_zeros += rank == 0;
+    }
+    constexpr double m = kNumRegisters;
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    const double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && num_zeros != 0) {
+      return m * std::log(m / num_zeros);
+    }
+    return estimate;
+  }
+
+ private:
+  std::vector<uint8_t> registers_;
+};
+
+struct CountMinOptions {
+  // The number of counters per row, rounded up to a power of two. The counts
+  // are overestimated by at most e / width of the total count, with
+  // probability 1 - exp(-depth).
+  int width = 2048;
+  // The number of rows, i.e., of hash functions.
+  int depth = 4;
+  // The number of candidate heavy hitters tracked.
+  int num_heavy_hitters = 32;
+};
+
+// A Count-Min sketch (Cormode and Muthukrishnan, 2005) of the counts of
+// values of type T. Each value increments one counter per row, and its count
+// is estimated by the minimum of its counters, which is never less than the
+// true count. The sketch also tracks the values with the highest estimated
+// counts, which are the heavy hitters when the distribution is skewed.
+template <typename T, typename Hash = std::hash<T>>
+class CountMinSketch {
+ public:
+  explicit CountMinSketch(const CountMinOptions& options = {})
+      : options_(options),
+        log2_width_(CeilLog2(options.width)),
+        counters_(static_cast<std::size_t>(options.depth) << log2_width_, 0) {
+    assert(options.depth > 0 && options.num_heavy_hitters > 0);
+    for (int row = 0; row < options.depth; ++row) {
+      multipliers_.push_back(sketches_detail::Mix64(row + 1) | 1);
+    }
+  }
+
+  void Add(const T& value, uint64_t count = 1) {
+    total_ += count;
+    const uint64_t hash = sketches_detail::HashValue(value, hash_);
+    uint64_t estimate = ~uint64_t{0};
+    for (int row = 0; row < options_.depth; ++row) {
+      uint64_t& counter = counters_[Index(hash, row)];
+      counter += count;
+      estimate = std::min(estimate, counter);
+    }
+    UpdateCandidate(value, estimate);
+  }
+  template <typename Range>
+  void AddRange(Range&& range) {
+    for (auto&& value : range) {
+      Add(value);
+    }
+  }
+
+  // Adds the counts of another sketch, with the same options.
+  void Merge(const CountMinSketch& other) {
+    assert(counters_.size() == other.counters_.size());
+    for (std::size_t i = 0; i < counters_.size(); ++i) {
+      counters_[i] += other.counters_[i];
+    }
+    total_ += other.total_;
+    // Re-estimates the candidates of both sketches with the merged counters.
+    std::unordered_map<T, uint64_t, Hash> candidates;
+    candidates.swap(candidates_);
+    candidates.insert(other.candidates_.begin(), other.candidates_.end());
+    min_candidate_count_ = 0;
+    for (const auto& [value, count] : candidates) {
+      UpdateCandidate(value, Estimate(value));
+    }
+  }
+
+  // Returns an estimate of the count of value, which is not less than its
+  // true count.
+  uint64_t Estimate(const T& value) const {
+    const uint64_t hash = sketches_detail::HashValue(value, hash_);
+    uint64_t estimate = ~uint64_t{0};
+    for (int row = 0; row < options_.depth; ++row) {
+      estimate = std::min(estimate, counters_[Index(hash, row)]);
+    }
+    return estimate;
+  }
+
+  // The sum of the counts added.
+  uint64_t total() const { return total_; }
+
+  // Returns the tracked values whose estimated counts are at least
+  // min_fraction of the total, with their estimated counts, by decreasing
+  // count.
+  std::vector<std::pair<T, uint64_t>> HeavyHitters(
+      double min_fraction = 0) const {
+    std::vector<std::pair<T, uint64_t>> heavy_hitters;
+    for (const auto& [value, count] : candidates_) {
+      if (count >= min_fraction * total_) {
+        heavy_hitters.emplace_back(value, count);
+      }
+    }
+    std::sort(heavy_hitters.begin(), heavy_hitters.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+    return heavy_hitters;
+  }
+
+ private:
+  // At least 1, such that the shift of Index() is less than 64.
+  static int CeilLog2(int n) {
+    int log2 = 1;
+    while ((1 << log2) < n) {
+      ++log2;
+    }
+    return log2;
+  }
+
+  // Indexes each row with the top bits of the product of the hash and an odd
+  // multiplier of the row (multiply-shift hashing). Unlike deriving the rows
+  // from two hashes, which only yields width^2 distinct combinations of
+  // counters, the rows are independent.
+  std::size_t Index(uint64_t hash, int row) const {
+    return (static_cast<std::size_t>(row) << log2_width_) +
+           ((hash * multipliers_[row]) >> (64 - log2_width_));
+  }
+
+  void UpdateCandidate(const T& value, uint64_t estimate) {
+    const bool is_full = candidates_.size() >=
+                         static_cast<std::size_t>(options_.num_heavy_hitters);
+    // The estimates only increase, so min_candidate_count_ is a lower bound
+    // of the counts of the candidates, and the estimate of a candidate
+    // exceeds it: most values are neither looked up nor compared with all the
+    // candidates.
+    if (is_full && estimate <= min_candidate_count_) {
+      return;
+    }
+    const auto it = candidates_.find(value);
+    if (it != candidates_.end()) {
+      it->second = estimate;
+      return;
+    }
+    if (!is_full) {
+      candidates_.emplace(value, estimate);
+      return;
+    }
+    auto min_it = std::min_element(
+        candidates_.begin(), candidates_.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (estimate > min_it->second) {
+      candidates_.erase(min_it);
+      candidates_.emplace(value, estimate);
+      min_it = std::min_element(
+          candidates_.begin(), candidates_.end(),
+          [](const auto& a, const auto& b) { return a.second < b.second; });
+    }
+    min_candidate_count_ = min_it->second;
+  }
+
+  CountMinOptions options_;
+  Hash hash_;
+  int log2_width_;
+  std::vector<uint64_t> multipliers_;
+  // depth rows of width counters.
+  std::vector<uint64_t> counters_;
+  uint64_t total_ = 0;
+  std::unordered_map<T, uint64_t, Hash> candidates_;
+  uint64_t min_candidate_count_ = 0;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_SKETCHES_H_
@@ -0,0 +1,229 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the sketches with the exact computations over a copy of the values
+// (sorting, or counting in a hash map), over a TransformRange of generated
+// values. Each sketch benchmark reports its error as a counter:
+//  - quantiles of exponentially distributed latencies: the largest rank error
+//    of the p50, p90, p99 and p99.9,
+//  - distinct values: the relative error of the count,
+//  - heavy hitters of Zipf-like values, alone or mixed with as many unique
+//    values: the fraction of the top 10 values found, and the largest
+//    overestimate of their counts, relative to the total.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/iterator_range.h"
+#include "genit/sketches.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+namespace {
+
+constexpr int kNumValues = 1 << 20;
+const std::vector<double> kQuantiles = {0.5, 0.9, 0.99, 0.999};
+
+// A uniform value in (0, 1].
+double Uniform(int i) {
+  return (sketches_detail::Mix64(i) >> 11) * 0x1p-53 + 0x1p-53;
+}
+
+auto Latencies() {
+  return TransformRange(IndexRange(0, kNumValues),
+                        [](int i) { return -10 * std::log(Uniform(i)); });
+}
+
+// kNumValues / 4 distinct values.
+auto Keys() {
+  return TransformRange(IndexRange(0, kNumValues), [](int i) {
+    return static_cast<uint32_t>(sketches_detail::Mix64(i) % (kNumValues / 4));
+  });
+}
+
+// Value v >= 1 occurs with probability 1 / (v * (v + 1)), or, if the
+// argument is true, half the time, and the other values are unique.
+auto ZipfValues(bool with_unique_values) {
+  return TransformRange(
+      IndexRange(0, kNumValues), [with_unique_values](int i) {
+        if (with_unique_values && i % 2 == 1) {
+          return static_cast<uint32_t>(1 << 30 | i);
+        }
+        return static_cast<uint32_t>(std::min(1 / Uniform(i), 1e9));
+      });
+}
+
+template <typename Range>
+auto ToVector(const Range& range) {
+  return std::vector<std::decay_t<decltype(*range.begin())>>(range.begin(),
+                                                             range.end());
+}
+
+void BM_ExactQuantilesSort(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<double> values = ToVector(Latencies());
+    std::sort(values.begin(), values.end());
+    for (const double q : kQuantiles) {
+      benchmark::DoNotOptimize(values[q * (values.size() - 1)]);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_ExactQuantilesNthElement(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<double> values = ToVector(Latencies());
+    for (const double q : kQuantiles) {
+      const auto nth = values.begin() + q * (values.size() - 1);
+      std::nth_element(values.begin(), nth, values.end());
+      benchmark::DoNotOptimize(*nth);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_KllQuantiles(benchmark::State& state) {
+  std::vector<double> quantiles;
+  for (auto _ : state) {
+    KllSketch<double> sketch(state.range(0));
+    sketch.AddRange(Latencies());
+    quantiles = sketch.Quantiles(kQuantiles);
+    benchmark::DoNotOptimize(quantiles.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+
+  std::vector<double> sorted = ToVector(Latencies());
+  std::sort(sorted.begin(), sorted.end());
+  double max_rank_error = 0;
+  for (std::size_t i = 0; i < kQuantiles.size(); ++i) {
+    const double rank =
+        static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(),
+                                             quantiles[i]) -
+                            sorted.begin()) /
+        kNumValues;
+    max_rank_error = std::max(max_rank_error, std::abs(rank - kQuantiles[i]));
+  }
+  state.counters["rank_error"] = max_rank_error;
+}
+
+void BM_ExactDistinctSort(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<uint32_t> keys = ToVector(Keys());
+    std::sort(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(std::unique(keys.begin(), keys.end()) -
+                             keys.begin());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_ExactDistinctHashSet(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto keys = Keys();
+    std::unordered_set<uint32_t> distinct(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(distinct.size());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+template <int kPrecision>
+void BM_HyperLogLog(benchmark::State& state) {
+  double estimate = 0;
+  for (auto _ : state) {
+    HyperLogLog<kPrecision> sketch;
+    sketch.AddRange(Keys());
+    estimate = sketch.Estimate();
+    benchmark::DoNotOptimize(estimate);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+
+  const auto keys = Keys();
+  const double exact =
+      std::unordered_set<uint32_t>(keys.begin(), keys.end()).size();
+  state.counters["relative_error"] = std::abs(estimate - exact) / exact;
+}
+
+using Counts = std::vector<std::pair<uint32_t, uint64_t>>;
+
+Counts ExactTop10(bool with_unique_values) {
+  std::unordered_map<uint32_t, uint64_t> counts;
+  for (const uint32_t value : ZipfValues(with_unique_values)) {
+    ++counts[value];
+  }
+  Counts top(counts.begin(), counts.end());
+  std::partial_sort(
+      top.begin(), top.begin() + 10, top.end(),
+      [](const auto& a, const auto& b) { return a.second > b.second; });
+  top.resize(10);
+  return top;
+}
+
+void BM_ExactHeavyHittersHashMap(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ExactTop10(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+void BM_CountMinHeavyHitters(benchmark::State& state) {
+  CountMinOptions options;
+  options.width = state.range(1);
+  Counts heavy_hitters;
+  for (auto _ : state) {
+    CountMinSketch<uint32_t> sketch(options);
+    sketch.AddRange(ZipfValues(state.range(0)));
+    heavy_hitters = sketch.HeavyHitters();
+    benchmark::DoNotOptimize(heavy_hitters.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+
+  int num_found = 0;
+  uint64_t max_overcount = 0;
+  for (const auto& [value, count] : ExactTop10(state.range(0))) {
+    for (int i = 0; i < std::min<int>(10, heavy_hitters.size()); ++i) {
+      if (heavy_hitters[i].first == value) {
+        ++num_found;
+        max_overcount =
+            std::max(max_overcount, heavy_hitters[i].second - count);
+      }
+    }
+  }
+  state.counters["top10_recall"] = num_found / 10.0;
+  state.counters["overcount"] =
+      static_cast<double>(max_overcount) / kNumValues;
+}
+
+BENCHMARK(BM_ExactQuantilesSort);
+BENCHMARK(BM_ExactQuantilesNthElement);
+BENCHMARK(BM_KllQuantiles)->Arg(100)->Arg(200)->Arg(800);
+BENCHMARK(BM_ExactDistinctSort);
+BENCHMARK(BM_ExactDistinctHashSet);
+BENCHMARK_TEMPLATE(BM_HyperLogLog, 10);
+BENCHMARK_TEMPLATE(BM_HyperLogLog, 12);
+BENCHMARK_TEMPLATE(BM_HyperLogLog, 14);
+BENCHMARK(BM_ExactHeavyHittersHashMap)
+    ->Arg(0)
+    ->Arg(1)
+    ->ArgName("with_unique_values");
+BENCHMARK(BM_CountMinHeavyHitters)
+    ->ArgsProduct({{0, 1}, {256, 2048}})
+    ->ArgNames({"with_unique_values", "width"});
+
+}  // namespace
+}  // namespace genit
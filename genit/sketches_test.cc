@@ -0,0 +1,219 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/sketches.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "genit/algorithms.h"
+#include "genit/iterator_range.h"
+#include "genit/transform_iterator.h"
+
+namespace genit {
+namespace {
+
+using ::testing::DoubleNear;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+constexpr int kNumValues = 100000;
+
+std::vector<int> ShuffledValues() {
+  std::vector<int> values(kNumValues);
+  for (int i = 0; i < kNumValues; ++i) {
+    values[i] = i;
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937(42));
+  return values;
+}
+
+TEST(KllSketchTest, IsExactForFewValues) {
+  KllSketch<int> sketch;
+  EXPECT_TRUE(sketch.empty());
+  EXPECT_EQ(sketch.Rank(0), 0);
+  sketch.AddRange(std::vector<int>{5, 1, 4, 2, 3});
+  EXPECT_EQ(sketch.count(), 5);
+  EXPECT_EQ(sketch.Quantile(0), 1);
+  EXPECT_EQ(sketch.Quantile(0.5), 3);
+  EXPECT_EQ(sketch.Quantile(1), 5);
+  EXPECT_THAT(sketch.Quantiles({0.2, 0.4, 0.8}), ElementsAre(1, 2, 4));
+  EXPECT_EQ(sketch.Rank(0), 0);
+  EXPECT_EQ(sketch.Rank(2), 0.4);
+  EXPECT_EQ(sketch.Rank(9), 1);
+}
+
+TEST(KllSketchTest, ApproximatesQuantiles) {
+  const std::vector<int> values = ShuffledValues();
+  KllSketch<int> sketch;
+  sketch.AddRange(values);
+  EXPECT_EQ(sketch.count(), kNumValues);
+  EXPECT_LT(sketch.num_retained(), 1000);
+  EXPECT_EQ(sketch.Quantile(0), 0);
+  EXPECT_EQ(sketch.Quantile(1), kNumValues - 1);
+  for (const double q : {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99}) {
+    EXPECT_NEAR(sketch.Quantile(q), q * kNumValues, 0.015 * kNumValues) << q;
+    EXPECT_THAT(sketch.Rank(q * kNumValues), DoubleNear(q, 0.015)) << q;
+  }
+}
+
+TEST(KllSketchTest, MergesThreadSketches) {
+  const std::vector<int> values = ShuffledValues();
+  constexpr int kNumThreads = 4;
+  std::vector<KllSketch<int>> sketches;
+  for (int t = 0; t < kNumThreads; ++t) {
+    sketches.emplace_back(200, t + 1);
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&values, &sketches, t] {
+      const int size = kNumValues / kNumThreads;
+      sketches[t].AddRange(MakeIteratorRange(values.begin() + t * size,
+                                             values.begin() + (t + 1) * size));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const KllSketch<int> merged =
+      Reduce(sketches, KllSketch<int>(), MergeSketches());
+  EXPECT_EQ(merged.count(), kNumValues);
+  EXPECT_LT(merged.num_retained(), 1000);
+  EXPECT_EQ(merged.Quantile(0), 0);
+  EXPECT_EQ(merged.Quantile(1), kNumValues - 1);
+  for (const double q : {0.1, 0.5, 0.9, 0.99}) {
+    EXPECT_NEAR(merged.Quantile(q), q * kNumValues, 0.015 * kNumValues) << q;
+  }
+}
+
+TEST(KllSketchTest, CustomOrder) {
+  KllSketch<std::string, std::greater<>> sketch;
+  sketch.AddRange(std::vector<std::string>{"a", "c", "b"});
+  EXPECT_EQ(sketch.Quantile(0), "c");
+  EXPECT_EQ(sketch.Quantile(1), "a");
+}
+
+TEST(HyperLogLogTest, CountsFewValuesAboutExactly) {
+  HyperLogLog<> sketch;
+  EXPECT_EQ(sketch.Estimate(), 0);
+  for (int i = 0; i < 100; ++i) {
+    sketch.Add(i % 10);
+  }
+  EXPECT_NEAR(sketch.Estimate(), 10, 0.5);
+}
+
+TEST(HyperLogLogTest, EstimatesDistinctValues) {
+  // Each of the kNumValues values is added 3 times.
+  HyperLogLog<> sketch;
+  sketch.AddRange(TransformRange(IndexRange(0, 3 * kNumValues),
+                                 [](int i) { return i % kNumValues; }));
+  EXPECT_NEAR(sketch.Estimate(), kNumValues, 0.05 * kNumValues);
+
+  HyperLogLog<> strings;
+  for (int i = 0; i < 1000; ++i) {
+    strings.Add(std::to_string(i));
+  }
+  EXPECT_NEAR(strings.Estimate(), 1000, 50);
+}
+
+TEST(HyperLogLogTest, MergesOverlappingSketches) {
+  HyperLogLog<14> a, b;
+  a.AddRange(IndexRange(0, 60000));
+  b.AddRange(IndexRange(40000, 100000));
+  const HyperLogLog<14> merged = MergeSketches()(a, b);
+  EXPECT_NEAR(merged.Estimate(), 100000, 3000);
+  a.Merge(b);
+  EXPECT_EQ(a.Estimate(), merged.Estimate());
+}
+
+// Value i in [1, 100] occurs i * i times, others once.
+std::vector<int> SkewedValues() {
+  std::vector<int> values;
+  for (int i = 1; i <= 100; ++i) {
+    values.insert(values.end(), i * i, i);
+  }
+  for (int i = 0; i < kNumValues; ++i) {
+    values.push_back(1000 + i);
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937(42));
+  return values;
+}
+
+TEST(CountMinSketchTest, NeverUnderestimates) {
+  CountMinOptions options;
+  options.width = 16;
+  options.depth = 2;
+  options.num_heavy_hitters = 2;
+  CountMinSketch<std::string> sketch(options);
+  sketch.Add("a", 5);
+  sketch.Add("b");
+  sketch.Add("c", 3);
+  EXPECT_EQ(sketch.total(), 9);
+  EXPECT_GE(sketch.Estimate("a"), 5);
+  EXPECT_GE(sketch.Estimate("b"), 1);
+  EXPECT_GE(sketch.Estimate("c"), 3);
+  EXPECT_THAT(sketch.HeavyHitters(0.5), ElementsAre(Pair("a", 5)));
+  EXPECT_THAT(sketch.HeavyHitters(), ElementsAre(Pair("a", 5), Pair("c", 3)));
+}
+
+TEST(CountMinSketchTest, FindsHeavyHitters) {
+  const std::vector<int> values = SkewedValues();
+  CountMinSketch<int> sketch;
+  sketch.AddRange(values);
+  EXPECT_EQ(sketch.total(), values.size());
+  const auto heavy_hitters = sketch.HeavyHitters();
+  ASSERT_EQ(heavy_hitters.size(), 32);
+  // Overestimated by at most e / width * total < 600.
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(heavy_hitters[i].first, 100 - i);
+    EXPECT_GE(heavy_hitters[i].second, (100 - i) * (100 - i));
+    EXPECT_LT(heavy_hitters[i].second, (100 - i) * (100 - i) + 600);
+  }
+  // 94 * 94 > 0.02 * total > 93 * 93.
+  EXPECT_EQ(sketch.HeavyHitters(0.02).size(), 7);
+}
+
+TEST(CountMinSketchTest, MergesThreadSketches) {
+  const std::vector<int> values = SkewedValues();
+  CountMinSketch<int> all;
+  all.AddRange(values);
+  const std::size_t half = values.size() / 2;
+  CountMinSketch<int> a, b;
+  std::thread thread([&] {
+    a.AddRange(MakeIteratorRange(values.begin(), values.begin() + half));
+  });
+  b.AddRange(MakeIteratorRange(values.begin() + half, values.end()));
+  thread.join();
+  a.Merge(b);
+  EXPECT_EQ(a.total(), values.size());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(a.Estimate(i), all.Estimate(i)) << i;
+  }
+  const auto heavy_hitters = a.HeavyHitters();
+  ASSERT_EQ(heavy_hitters.size(), 32);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(heavy_hitters[i].first, 100 - i);
+    EXPECT_EQ(heavy_hitters[i].second, all.Estimate(100 - i));
+  }
+}
+
+}  // namespace
+}  // namespace genit
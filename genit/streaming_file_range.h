@@ -0,0 +1,369 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This header file provides StreamingFileRange, which reads a file in
+// fixed-size chunks with pread on a background thread, into a few rotating
+// buffers, such that the reads overlap with the processing of the previous
+// chunks. Unlike mmap, it works on any file system, and only needs
+// num_buffers * chunk_size bytes of memory, whatever the size of the file.
+//
+// The data can be accessed once, through one of three views:
+//
+//   StreamingFileRange file("/data/log.txt");
+//   // Bytes:
+//   for (char c : file) { ... }
+//   // Chunks (PtrRange<const char>), for bulk processing:
+//   for (const auto chunk : file.Chunks()) { Process(chunk.begin(), ...); }
+//   // Lines (std::string_view), or any delimited tokens:
+//   for (std::string_view line : file.Lines()) { ... }
+//   if (!file.ok()) { ... strerror(file.error()) ... }
+//
+// The views are input ranges (single-pass): an element stays valid until the
+// next increment, and the chunk it is in is recycled once the iteration
+// leaves it. They compose with adapters such as TransformRange and
+// FilterRange. Lines that straddle chunks are copied into a buffer of the
+// iterator, the others point into the chunk.
+//
+// With options.record_size set, the chunks hold a whole number of records
+// (until the end of the file), which can then be decoded with, e.g.,
+// PackedFieldRange.
+//
+// POSIX only.
+
+#ifndef GENIT_STREAMING_FILE_RANGE_H_
+#define GENIT_STREAMING_FILE_RANGE_H_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "genit/iterator_facade.h"
+#include "genit/iterator_range.h"
+#include "genit/pipeline.h"
+
+namespace genit {
+
+struct StreamingFileOptions {
+  // The number of bytes of each read.
+  std::size_t chunk_size = std::size_t{1} << 20;
+  // The number of buffers, i.e., at most num_buffers - 1 chunks are read
+  // ahead of the one being processed.
+  int num_buffers = 2;
+  // The chunk size is rounded down to a multiple of record_size.
+  std::size_t record_size = 1;
+};
+
+namespace streaming_file_range_detail {
+
+// A chunk read into buffers[buffer].
+struct FilledChunk {
+  int buffer = 0;
+  std::size_t size = 0;
+};
+
+// Owns the file, the buffers and the reader thread. The reader pops free
+// buffers, fills them, and pushes them to the consumer, which pushes them
+// back once it is done with them.
+class Reader {
+ public:
+  Reader(const std::string& path, const StreamingFileOptions& options)
+      : chunk_size_(options.chunk_size / options.record_size *
+                    options.record_size),
+        free_buffers_(options.num_buffers),
+        filled_chunks_(options.num_buffers) {
+    assert(options.num_buffers >= 2 && chunk_size_ > 0);
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+      error_ = errno;
+      filled_chunks_.Close();
+      return;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    buffers_.resize(options.num_buffers);
+    for (int i = 0; i < options.num_buffers; ++i) {
+      buffers_[i].reset(new char[chunk_size_]);
+      free_buffers_.Push(i);
+    }
+    thread_ = std::thread([this] { ReadChunks(); });
+  }
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  ~Reader() {
+    free_buffers_.Cancel();
+    filled_chunks_.Cancel();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  // Makes the next chunk current, and recycles the buffer of the previous
+  // one. The current chunk is empty at the end of the file.
+  void NextChunk() {
+    if (started_ && chunk_.size > 0) {
+      free_buffers_.Push(chunk_.buffer);
+    }
+    started_ = true;
+    if (!filled_chunks_.Pop(chunk_)) {
+      chunk_ = FilledChunk();
+    }
+  }
+
+  // Reads the first chunk, on the first call.
+  void Start() {
+    if (!started_) {
+      NextChunk();
+    }
+  }
+
+  bool AtEnd() const { return started_ && chunk_.size == 0; }
+
+  PtrRange<const char> chunk() const {
+    const char* data =
+        chunk_.size == 0 ? nullptr : buffers_[chunk_.buffer].get();
+    return PtrRange<const char>(data, data + chunk_.size);
+  }
+
+  int error() const { return error_.load(); }
+
+ private:
+  void ReadChunks() {
+    off_t offset = 0;
+    int buffer;
+    while (free_buffers_.Pop(buffer)) {
+      char* data = buffers_[buffer].get();
+      std::size_t size = 0;
+      while (size < chunk_size_) {
+        const ssize_t n =
+            ::pread(fd_, data + size, chunk_size_ - size, offset + size);
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n < 0) {
+          error_.store(errno);
+          break;
+        }
+        if (n == 0) {
+          break;
+        }
+        size += n;
+      }
+      offset += size;
+      if (size > 0 && !filled_chunks_.Push(FilledChunk{buffer, size})) {
+        return;
+      }
+      if (size < chunk_size_) {
+        break;
+      }
+    }
+    filled_chunks_.Close();
+  }
+
+  const std::size_t chunk_size_;
+  int fd_ = -1;
+  std::vector<std::unique_ptr<char[]>> buffers_;
+  BoundedSpscQueue<int> free_buffers_;
+  BoundedSpscQueue<FilledChunk> filled_chunks_;
+  std::atomic<int> error_{0};
+  std::thread thread_;
+
+  // Consumer state.
+  bool started_ = false;
+  FilledChunk chunk_;
+};
+
+}  // namespace streaming_file_range_detail
+
+// Iterates over the chunks of a StreamingFileRange.
+class StreamingChunkIterator
+    : public IteratorFacade<StreamingChunkIterator, PtrRange<const char>,
+                            std::input_iterator_tag> {
+ public:
+  StreamingChunkIterator() = default;
+  explicit StreamingChunkIterator(streaming_file_range_detail::Reader* reader)
+      : reader_(reader) {
+    reader_->Start();
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<StreamingChunkIterator>;
+
+  PtrRange<const char> Dereference() const { return reader_->chunk(); }
+  void Increment() { reader_->NextChunk(); }
+  bool IsEqual(const StreamingChunkIterator& rhs) const {
+    return AtEnd() == rhs.AtEnd();
+  }
+  bool AtEnd() const { return reader_ == nullptr || reader_->AtEnd(); }
+
+  streaming_file_range_detail::Reader* reader_ = nullptr;
+};
+
+// Iterates over the bytes of a StreamingFileRange.
+class StreamingByteIterator
+    : public IteratorFacade<StreamingByteIterator, const char&,
+                            std::input_iterator_tag> {
+ public:
+  StreamingByteIterator() = default;
+  explicit StreamingByteIterator(streaming_file_range_detail::Reader* reader)
+      : reader_(reader) {
+    reader_->Start();
+    chunk_ = reader_->chunk();
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<StreamingByteIterator>;
+
+  const char& Dereference() const { return chunk_.begin()[index_]; }
+  void Increment() {
+    if (++index_ == static_cast<std::size_t>(chunk_.size())) {
+      reader_->NextChunk();
+      chunk_ = reader_->chunk();
+      index_ = 0;
+    }
+  }
+  bool IsEqual(const StreamingByteIterator& rhs) const {
+    return AtEnd() == rhs.AtEnd();
+  }
+  bool AtEnd() const { return reader_ == nullptr || reader_->AtEnd(); }
+
+  streaming_file_range_detail::Reader* reader_ = nullptr;
+  PtrRange<const char> chunk_;
+  std::size_t index_ = 0;
+};
+
+// Iterates over the tokens of a StreamingFileRange separated by a delimiter
+// (e.g., lines). A final delimiter does not start an empty token.
+class StreamingTokenIterator
+    : public IteratorFacade<StreamingTokenIterator, std::string_view,
+                            std::input_iterator_tag> {
+ public:
+  StreamingTokenIterator() = default;
+  StreamingTokenIterator(streaming_file_range_detail::Reader* reader,
+                         char delimiter)
+      : reader_(reader), delimiter_(delimiter) {
+    reader_->Start();
+    ReadToken();
+  }
+
+ private:
+  friend class IteratorFacadePrivateAccess<StreamingTokenIterator>;
+
+  std::string_view Dereference() const {
+    return token_in_carry_ ? std::string_view(carry_) : token_;
+  }
+  void Increment() { ReadToken(); }
+  bool IsEqual(const StreamingTokenIterator& rhs) const {
+    return at_end_ == rhs.at_end_;
+  }
+
+  void ReadToken() {
+    // Whether the token straddles chunks, and is assembled in carry_.
+    token_in_carry_ = false;
+    at_end_ = false;
+    while (!reader_->AtEnd()) {
+      const PtrRange<const char> chunk = reader_->chunk();
+      const char* first = chunk.begin() + index_;
+      const char* found = static_cast<const char*>(
+          std::memchr(first, delimiter_, chunk.end() - first));
+      if (found != nullptr) {
+        index_ = found + 1 - chunk.begin();
+        if (token_in_carry_) {
+          carry_.append(first, found);
+        } else {
+          token_ = std::string_view(first, found - first);
+        }
+        return;
+      }
+      if (!token_in_carry_) {
+        token_in_carry_ = true;
+        carry_.clear();
+      }
+      carry_.append(first, chunk.end());
+      reader_->NextChunk();
+      index_ = 0;
+    }
+    at_end_ = !token_in_carry_ || carry_.empty();
+  }
+
+  streaming_file_range_detail::Reader* reader_ = nullptr;
+  char delimiter_ = '\n';
+  std::size_t index_ = 0;
+  std::string_view token_;
+  std::string carry_;
+  bool token_in_carry_ = false;
+  bool at_end_ = true;
+};
+
+// A file read on a background thread. See the top of the file.
+class StreamingFileRange {
+ public:
+  using iterator = StreamingByteIterator;
+  using value_type = char;
+
+  explicit StreamingFileRange(const std::string& path,
+                              StreamingFileOptions options = {})
+      : reader_(std::make_unique<streaming_file_range_detail::Reader>(
+            path, options)) {}
+
+  // Returns false if the file could not be opened or read, see error().
+  bool ok() const { return error() == 0; }
+  // Returns the errno of the failed open or read, or 0.
+  int error() const { return reader_->error(); }
+
+  // The bytes of the file.
+  StreamingByteIterator begin() const {
+    return StreamingByteIterator(reader_.get());
+  }
+  StreamingByteIterator end() const { return StreamingByteIterator(); }
+
+  // Returns the chunks of the file, as they are read.
+  IteratorRange<StreamingChunkIterator> Chunks() const {
+    return IteratorRange<StreamingChunkIterator>(
+        StreamingChunkIterator(reader_.get()), StreamingChunkIterator());
+  }
+
+  // Returns the tokens of the file separated by delimiter, without the
+  // delimiters.
+  IteratorRange<StreamingTokenIterator> Lines(char delimiter = '\n') const {
+    return IteratorRange<StreamingTokenIterator>(
+        StreamingTokenIterator(reader_.get(), delimiter),
+        StreamingTokenIterator());
+  }
+
+ private:
+  std::unique_ptr<streaming_file_range_detail::Reader> reader_;
+};
+
+}  // namespace genit
+
+#endif  // GENIT_STREAMING_FILE_RANGE_H_
@@ -0,0 +1,147 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares counting the lines of a 64 MiB text file generated in $TMPDIR
+// (or /tmp), and summing its bytes, with std::ifstream (getline, and read into
+// a buffer), mmap, and StreamingFileRange (lines, and chunks). The file is in
+// the page cache after the first run, so this measures the CPU cost of each
+// method rather than the device.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/streaming_file_range.h"
+
+namespace genit {
+namespace {
+
+constexpr std::size_t kFileSize = std::size_t{64} << 20;
+
+// Returns the path of the generated file, created on the first call.
+const std::string& FilePath() {
+  static const std::string* path = [] {
+    const char* dir = std::getenv("TMPDIR");
+    auto* path = new std::string(std::string(dir == nullptr ? "/tmp" : dir) +
+                                 "/streaming_file_range_benchmark.txt");
+    std::ofstream out(*path, std::ios::binary);
+    std::string line;
+    std::size_t size = 0;
+    for (uint32_t i = 0; size < kFileSize; ++i) {
+      line.assign(20 + i * 2654435761u % 80, static_cast<char>('a' + i % 26));
+      line += '\n';
+      out << line;
+      size += line.size();
+    }
+    return path;
+  }();
+  return *path;
+}
+
+uint64_t SumBytes(const char* data, std::size_t size) {
+  uint64_t sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    sum += static_cast<unsigned char>(data[i]);
+  }
+  return sum;
+}
+
+void BM_IfstreamGetline(benchmark::State& state) {
+  for (auto _ : state) {
+    std::ifstream in(FilePath(), std::ios::binary);
+    std::string line;
+    int64_t num_lines = 0;
+    while (std::getline(in, line)) {
+      ++num_lines;
+    }
+    benchmark::DoNotOptimize(num_lines);
+  }
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+void BM_StreamingLines(benchmark::State& state) {
+  for (auto _ : state) {
+    StreamingFileRange file(FilePath());
+    int64_t num_lines = 0;
+    for (std::string_view line : file.Lines()) {
+      benchmark::DoNotOptimize(line.data());
+      ++num_lines;
+    }
+    benchmark::DoNotOptimize(num_lines);
+  }
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+void BM_IfstreamRead(benchmark::State& state) {
+  std::vector<char> buffer(std::size_t{1} << 20);
+  for (auto _ : state) {
+    std::ifstream in(FilePath(), std::ios::binary);
+    uint64_t sum = 0;
+    while (in) {
+      in.read(buffer.data(), buffer.size());
+      sum += SumBytes(buffer.data(), in.gcount());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+void BM_Mmap(benchmark::State& state) {
+  for (auto _ : state) {
+    const int fd = ::open(FilePath().c_str(), O_RDONLY);
+    struct stat st;
+    ::fstat(fd, &st);
+    void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+    const uint64_t sum = SumBytes(static_cast<const char*>(data), st.st_size);
+    ::munmap(data, st.st_size);
+    ::close(fd);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+// The argument is the chunk size in KiB.
+void BM_StreamingChunks(benchmark::State& state) {
+  StreamingFileOptions options;
+  options.chunk_size = state.range(0) << 10;
+  for (auto _ : state) {
+    StreamingFileRange file(FilePath(), options);
+    uint64_t sum = 0;
+    for (const auto chunk : file.Chunks()) {
+      sum += SumBytes(chunk.begin(), chunk.size());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * kFileSize);
+}
+
+BENCHMARK(BM_IfstreamGetline)->UseRealTime();
+BENCHMARK(BM_StreamingLines)->UseRealTime();
+BENCHMARK(BM_IfstreamRead)->UseRealTime();
+BENCHMARK(BM_Mmap)->UseRealTime();
+BENCHMARK(BM_StreamingChunks)->Arg(64)->Arg(1024)->Arg(8192)->UseRealTime();
+
+}  // namespace
+}  // namespace genit
@@ -0,0 +1,175 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "genit/streaming_file_range.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "genit/filter_iterator.h"
+#include "genit/packed_field_range.h"
+#include "genit/transform_iterator.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace genit {
+namespace {
+
+using ::testing::ElementsAre;
+
+// A file with the given contents, deleted at the end of the test.
+class TempFile {
+ public:
+  explicit TempFile(const std::string& contents) {
+    const char* dir = std::getenv("TEST_TMPDIR");
+    path_ = std::string(dir == nullptr ? "/tmp" : dir) +
+            "/streaming_file_range_test_XXXXXX";
+    const int fd = ::mkstemp(path_.data());
+    ::close(fd);
+    std::ofstream(path_, std::ios::binary) << contents;
+  }
+  ~TempFile() { ::unlink(path_.c_str()); }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+StreamingFileOptions SmallChunks(std::size_t chunk_size, int num_buffers) {
+  StreamingFileOptions options;
+  options.chunk_size = chunk_size;
+  options.num_buffers = num_buffers;
+  return options;
+}
+
+std::string MakeContents(int size) {
+  std::string contents(size, ' ');
+  for (int i = 0; i < size; ++i) {
+    contents[i] = static_cast<char>('a' + i * 7 % 26);
+  }
+  return contents;
+}
+
+TEST(StreamingFileRangeTest, ReadsBytes) {
+  for (int size : {0, 1, 7, 8, 9, 100, 1000}) {
+    const std::string contents = MakeContents(size);
+    const TempFile file(contents);
+    for (int num_buffers : {2, 3}) {
+      StreamingFileRange range(file.path(), SmallChunks(8, num_buffers));
+      const std::string read(range.begin(), range.end());
+      EXPECT_EQ(read, contents) << size << " " << num_buffers;
+      EXPECT_TRUE(range.ok());
+    }
+  }
+}
+
+TEST(StreamingFileRangeTest, ReadsChunks) {
+  const std::string contents = MakeContents(20);
+  const TempFile file(contents);
+  StreamingFileRange range(file.path(), SmallChunks(8, 2));
+  std::vector<std::string> chunks;
+  for (const auto chunk : range.Chunks()) {
+    chunks.emplace_back(chunk.begin(), chunk.end());
+  }
+  EXPECT_THAT(chunks, ElementsAre(contents.substr(0, 8),
+                                  contents.substr(8, 8),
+                                  contents.substr(16)));
+}
+
+TEST(StreamingFileRangeTest, ChunksHoldWholeRecords) {
+  std::string contents;
+  for (uint32_t i = 0; i < 10; ++i) {
+    char record[6] = {0, 0, 0, 0, 'x', 'y'};
+    StoreUnaligned<uint32_t, ByteOrder::kBigEndian>(record, i);
+    contents.append(record, sizeof(record));
+  }
+  const TempFile file(contents);
+  StreamingFileOptions options = SmallChunks(16, 2);
+  options.record_size = 6;
+  StreamingFileRange range(file.path(), options);
+  std::vector<uint32_t> ids;
+  for (const auto chunk : range.Chunks()) {
+    EXPECT_EQ(chunk.size() % 6, 0);
+    for (uint32_t id : PackedFieldRange<uint32_t, ByteOrder::kBigEndian>(
+             chunk.begin(), chunk.size() / 6, 6)) {
+      ids.push_back(id);
+    }
+  }
+  EXPECT_THAT(ids, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(StreamingFileRangeTest, SplitsLinesAcrossChunks) {
+  const std::string contents =
+      "first line\n\nshort\na line longer than two chunks\nlast";
+  const TempFile file(contents);
+  for (std::size_t chunk_size : {1, 4, 8, 1024}) {
+    StreamingFileRange range(file.path(), SmallChunks(chunk_size, 2));
+    std::vector<std::string> lines;
+    for (std::string_view line : range.Lines()) {
+      lines.emplace_back(line);
+    }
+    EXPECT_THAT(lines, ElementsAre("first line", "", "short",
+                                   "a line longer than two chunks", "last"))
+        << chunk_size;
+  }
+}
+
+TEST(StreamingFileRangeTest, FinalDelimiterDoesNotStartToken) {
+  const TempFile file("a,b,");
+  StreamingFileRange range(file.path(), SmallChunks(2, 2));
+  std::vector<std::string> tokens;
+  for (std::string_view token : range.Lines(',')) {
+    tokens.emplace_back(token);
+  }
+  EXPECT_THAT(tokens, ElementsAre("a", "b"));
+}
+
+TEST(StreamingFileRangeTest, ComposesWithAdapters) {
+  const TempFile file("3\n14\n15\n92\n6\n");
+  StreamingFileRange range(file.path(), SmallChunks(4, 2));
+  const auto values = TransformRange(
+      range.Lines(), [](std::string_view line) { return std::stoi(
+                                                     std::string(line)); });
+  std::vector<int> odd;
+  for (int value : FilterRange(values, [](int x) { return x % 2 == 1; })) {
+    odd.push_back(value);
+  }
+  EXPECT_THAT(odd, ElementsAre(3, 15));
+}
+
+TEST(StreamingFileRangeTest, StopsEarly) {
+  const TempFile file(MakeContents(10000));
+  StreamingFileRange range(file.path(), SmallChunks(16, 2));
+  // Only reads the first chunk, and the destructor stops the reader.
+  EXPECT_EQ(*range.begin(), 'a');
+}
+
+TEST(StreamingFileRangeTest, ReportsOpenErrors) {
+  StreamingFileRange range("/nonexistent/streaming_file_range_test");
+  EXPECT_FALSE(range.ok());
+  EXPECT_EQ(range.error(), ENOENT);
+  EXPECT_TRUE(range.begin() == range.end());
+  EXPECT_TRUE(range.Lines().empty());
+}
+
+}  // namespace
+}  // namespace genit
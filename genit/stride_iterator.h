@@ -42,6 +42,9 @@ namespace genit {
 // Caveats:
 //  - Comparing two StrideIterator that have different strides or come from
 //    different containers has undefined behavior. No diagnostics.
+//  - The elements are accessed through a ValueType*, so they must be aligned
+//    for ValueType. Use PackedFieldRange (packed_field_range.h) for the fields
+//    of packed records.
 template <typename ValueType>
 class StrideIterator
     : public IteratorFacade<StrideIterator<ValueType>, ValueType&,
@@ -96,6 +96,7 @@ class TransformedRange
   using TransIter = TransformIterator<RangeIteratorType<BaseRange>, UnaryFunc>;
   using BaseFacade = AliasRangeFacade<TransformedRange<BaseRange, UnaryFunc>,
                                       BaseRange, TransIter>;
+  static constexpr std::size_t kExtent = kStaticExtent<BaseRange>;
 
   // Constructor from a Range
   template <typename OtherRange, typename OtherFunc>
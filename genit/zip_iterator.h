@@ -17,6 +17,7 @@
 #ifndef GENIT_ZIP_ITERATOR_H_
 #define GENIT_ZIP_ITERATOR_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <limits>
@@ -206,6 +207,12 @@ class ZippedRange
   using ZipIter = ZipIterator<RangeIteratorType<Ranges>...>;
   using BaseFacade =
       AliasRangeFacade<ZippedRange<Ranges...>, BaseRange, ZipIter>;
+  // Iterations stop at the end of the shortest range, so the extent is only
+  // known if the extents of all ranges are.
+  static constexpr std::size_t kExtent =
+      ((kStaticExtent<Ranges> != kDynamicExtent) && ...)
+          ? std::min({kStaticExtent<Ranges>...})
+          : kDynamicExtent;
 
   template <typename... OtherRanges>
   explicit ZippedRange(OtherRanges&&... ranges)
@@ -245,17 +252,117 @@ auto ZipRange(Ranges&&... ranges) {
       ranges)))...>(MoveOrAliasRange(std::forward<Ranges>(ranges))...);
 }
 
+namespace zip_iterator_detail {
+
+// Enumerating iterators are random access if the base iterator is, and at most
+// forward otherwise, because the counter of an end iterator is only known in
+// constant time for random-access ranges.
+template <typename BaseIter>
+using EnumerateIterCategory = std::conditional_t<
+    std::is_same_v<ComputeIterCategory<BaseIter>,
+                   std::random_access_iterator_tag>,
+    std::random_access_iterator_tag,
+    LeastPermissive<ComputeIterCategory<BaseIter>, std::forward_iterator_tag>>;
+
+}  // namespace zip_iterator_detail
+
+// An EnumerateIterator pairs each element of a base iterator with its index,
+// represented as a std::size_t counter. Only the base iterators are compared,
+// so an EnumerateIterator is as cheap to compare as the base iterator.
+//
+// See EnumerateRange for a convenient way to create an enumerated range.
+template <typename BaseIter>
+class EnumerateIterator
+    : public IteratorFacade<
+          EnumerateIterator<BaseIter>,
+          std::pair<std::size_t, decltype(*std::declval<BaseIter>())>,
+          zip_iterator_detail::EnumerateIterCategory<BaseIter>> {
+ public:
+  EnumerateIterator() : it_(), index_(0) {}
+  EnumerateIterator(BaseIter it, std::size_t index)
+      : it_(std::move(it)), index_(index) {}
+
+  // Returns the underlying iterator.
+  const BaseIter& base() const { return it_; }
+  // Returns the index of the current element.
+  std::size_t index() const { return index_; }
+
+ private:
+  friend class IteratorFacadePrivateAccess<EnumerateIterator>;
+
+  using OutputRefType =
+      std::pair<std::size_t, decltype(*std::declval<BaseIter>())>;
+
+  // Implementation of the IteratorFacade requirements:
+  OutputRefType Dereference() const { return OutputRefType(index_, *it_); }
+  void Increment() {
+    ++it_;
+    ++index_;
+  }
+  void Decrement() {
+    --it_;
+    --index_;
+  }
+  bool IsEqual(const EnumerateIterator& rhs) const { return it_ == rhs.it_; }
+  int DistanceTo(const EnumerateIterator& rhs) const { return rhs.it_ - it_; }
+  void Advance(int n) {
+    it_ += n;
+    index_ += n;
+  }
+
+  BaseIter it_;
+  std::size_t index_;
+};
+
+// An EnumeratedRange is a range that pairs each element of an underlying range
+// with its index. See EnumerateRange.
+template <typename BaseRange>
+class EnumeratedRange
+    : public AliasRangeFacade<EnumeratedRange<BaseRange>, BaseRange,
+                              EnumerateIterator<RangeIteratorType<BaseRange>>> {
+ public:
+  using EnumerateIter = EnumerateIterator<RangeIteratorType<BaseRange>>;
+  using BaseFacade =
+      AliasRangeFacade<EnumeratedRange<BaseRange>, BaseRange, EnumerateIter>;
+
+  template <typename OtherRange>
+  explicit EnumeratedRange(OtherRange&& r)
+      : BaseFacade(std::forward<OtherRange>(r)) {}
+
+ private:
+  friend class AliasRangeFacadePrivateAccess<EnumeratedRange<BaseRange>>;
+
+  auto Begin(const BaseRange& base_range) const {
+    using std::begin;
+    return EnumerateIter(begin(base_range), 0);
+  }
+  auto End(const BaseRange& base_range) const {
+    using std::begin;
+    using std::end;
+    if constexpr (std::is_same_v<typename std::iterator_traits<
+                                     EnumerateIter>::iterator_category,
+                                 std::random_access_iterator_tag>) {
+      const auto last = end(base_range);
+      return EnumerateIter(last, last - begin(base_range));
+    } else {
+      // The counter of the end iterator is never observed.
+      return EnumerateIter(end(base_range), 0);
+    }
+  }
+};
+
 // Factory function that conveniently creates an enumerated iterator range
-// where each element of the range is paired with its integer index / counter
-// represented as an `int` (size of range should be less than max of int).
+// where each element of the range is paired with its index / counter,
+// represented as a `std::size_t`. The elements are std::pair<std::size_t, Ref>
+// where Ref is the reference type of the range.
 // For example, when enumerate a vector v:
 //   auto enumerated_range = EnumerateRange(v);
 // or:
 //   for (auto [i, x] : EnumerateRange(v)) { .. }
 template <typename Range>
 auto EnumerateRange(Range&& range) {
-  return ZipRange(IndexRange(0, std::numeric_limits<int>::max()),
-                  std::forward<Range>(range));
+  return EnumeratedRange<decltype(MoveOrAliasRange(std::forward<Range>(
+      range)))>(MoveOrAliasRange(std::forward<Range>(range)));
 }
 
 }  // namespace genit
@@ -0,0 +1,116 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares EnumerateRange against zipping an IndexRange with the range (the
+// previous implementation of EnumerateRange) and against a hand-written
+// index loop.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "genit/iterator_range.h"
+#include "genit/zip_iterator.h"
+
+namespace genit {
+namespace {
+
+template <typename Range>
+auto ZipEnumerateRange(Range&& range) {
+  return ZipRange(IndexRange(0, std::numeric_limits<int>::max()),
+                  std::forward<Range>(range));
+}
+
+std::vector<int64_t> MakeValues(int n) {
+  std::vector<int64_t> values(n);
+  for (int i = 0; i < n; ++i) {
+    values[i] = (i * 7) % 13;
+  }
+  return values;
+}
+
+void BM_IndexLoop(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      sum += i * values[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void BM_EnumerateRange(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto [i, x] : EnumerateRange(values)) {
+      sum += i * x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void BM_ZipEnumerateRange(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto [i, x] : ZipEnumerateRange(values)) {
+      sum += i * x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void BM_EnumerateRangeList(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const std::list<int64_t> list(values.begin(), values.end());
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto [i, x] : EnumerateRange(list)) {
+      sum += i * x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void BM_ZipEnumerateRangeList(benchmark::State& state) {
+  const auto values = MakeValues(state.range(0));
+  const std::list<int64_t> list(values.begin(), values.end());
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto [i, x] : ZipEnumerateRange(list)) {
+      sum += i * x;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(BM_IndexLoop)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_EnumerateRange)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_ZipEnumerateRange)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_EnumerateRangeList)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_ZipEnumerateRangeList)->Range(1 << 6, 1 << 16);
+
+}  // namespace
+}  // namespace genit
@@ -14,17 +14,23 @@
 
 #include "genit/zip_iterator.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <list>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 namespace genit {
 namespace {
 
+using ::testing::ElementsAre;
+
 TEST(ZipIterator, SquareValuesIterator) {
   std::vector<int> v = {0, 1, 2, 3, 4};
   std::vector<int> v_sqr = {0, 1, 4, 9, 16};
@@ -114,8 +120,8 @@ TEST(ZipIterator, EnumerateRange) {
   const uint64_t values[] = {1, 2, 3, 4, 5};
   int count = 0;
   for (auto t : EnumerateRange(values)) {
-    EXPECT_TRUE(
-        (std::is_same_v<decltype(t), std::tuple<int, const uint64_t&>>));
+    EXPECT_TRUE((std::is_same_v<decltype(t),
+                                std::pair<std::size_t, const uint64_t&>>));
     auto [i, j] = t;
     EXPECT_EQ(i, count);
     EXPECT_EQ(i + 1, j);
@@ -125,5 +131,53 @@ TEST(ZipIterator, EnumerateRange) {
   EXPECT_EQ(count, sizeof(values) / sizeof(uint64_t));
 }
 
+TEST(ZipIterator, EnumerateRangeRandomAccess) {
+  std::vector<int> values = {10, 20, 30, 40};
+  const auto range = EnumerateRange(values);
+  using It = decltype(range.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::random_access_iterator_tag>));
+  EXPECT_EQ(range.size(), 4);
+  EXPECT_EQ(range.begin()[2].first, 2);
+  EXPECT_EQ(range.begin()[2].second, 30);
+  auto last = range.end();
+  --last;
+  EXPECT_EQ((*last).first, 3);
+  EXPECT_EQ((range.end() - 2).index(), 2);
+  std::vector<std::size_t> indices;
+  for (auto it = range.end(); it != range.begin();) {
+    --it;
+    indices.push_back(it.index());
+  }
+  EXPECT_THAT(indices, ElementsAre(3, 2, 1, 0));
+
+  for (auto [i, x] : range) {
+    x += i;
+  }
+  EXPECT_THAT(values, ElementsAre(10, 21, 32, 43));
+}
+
+TEST(ZipIterator, EnumerateRangeForward) {
+  std::list<int> values = {5, 6, 7};
+  const auto range = EnumerateRange(values);
+  using It = decltype(range.begin());
+  EXPECT_TRUE((std::is_same_v<std::iterator_traits<It>::iterator_category,
+                              std::forward_iterator_tag>));
+  std::vector<std::pair<std::size_t, int>> pairs(range.begin(), range.end());
+  EXPECT_THAT(pairs, ElementsAre(std::pair<std::size_t, int>(0, 5),
+                                 std::pair<std::size_t, int>(1, 6),
+                                 std::pair<std::size_t, int>(2, 7)));
+}
+
+TEST(ZipIterator, EnumerateRangeRvalue) {
+  std::size_t expected = 0;
+  for (auto [i, x] : EnumerateRange(std::vector<int>{3, 4, 5})) {
+    EXPECT_EQ(i, expected);
+    EXPECT_EQ(x, 3 + expected);
+    ++expected;
+  }
+  EXPECT_EQ(expected, 3);
+}
+
 }  // namespace
 }  // namespace genit